@@ -0,0 +1,138 @@
+/*
+bench_aad.cpp
+Copyright © 2025 Yvan Richard
+
+Full risk of a book of 10k European options (sensitivity of the book
+value to S, K, r, b, sigma and T of every position, i.e. 60k numbers):
+    - AAD: one recording + one backward sweep (AdjointPortfolioPricer),
+      with and without per-position checkpointing
+    - bump-and-reprice: central differences on every input of every
+      position (NumericalEngineGreeks::derivative() on BSEngine)
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one position. The AAD
+benchmark fails if its gradient is off the bumped one.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/AdjointPortfolioPricer.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/NumericalEngineGreeks.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_positions = 10000;
+constexpr double h = 1e-5;
+
+// Book: strikes 60..140, expiries 0.1..2, vols 0.1..0.5, calls and puts
+struct Book
+{
+    std::vector<yo::OptionParams> params;
+    std::vector<double> quantities;
+};
+
+Book book()
+{
+    Book b{ std::vector<yo::OptionParams>(n_positions), std::vector<double>(n_positions) };
+    for (std::size_t i = 0; i < n_positions; ++i)
+    {
+        yo::OptionParams& p = b.params[i];
+        p.asset_price = 100.0;
+        p.strike_price = 60.0 + 80.0 * ((i * 37) % 1000) / 1000.0;
+        p.exercise_time = 0.1 + 1.9 * ((i * 11) % 100) / 100.0;
+        p.volatility = 0.1 + 0.4 * ((i * 7) % 50) / 50.0;
+        p.r = 0.03;
+        p.cost_of_carry = 0.01;
+        p.option_type = (i % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+        b.quantities[i] = 1.0 + (i % 5);
+    }
+    return b;
+}
+
+// bump_and_reprice(): central differences on every input of every position
+void bump_and_reprice(const ye::NumericalEngineGreeks& num_greeks, const Book& b,
+                      std::vector<ye::PositionGradient>& out)
+{
+    for (std::size_t i = 0; i < n_positions; ++i)
+    {
+        const yo::OptionParams& p = b.params[i];
+        const double q = b.quantities[i];
+        ye::PositionGradient& g = out[i];
+        g.dS = q * num_greeks.delta(p);
+        g.dK = q * num_greeks.derivative(p, &yo::OptionParams::strike_price);
+        g.dr = q * num_greeks.derivative(p, &yo::OptionParams::r);
+        g.db = q * num_greeks.derivative(p, &yo::OptionParams::cost_of_carry);
+        g.dsigma = q * num_greeks.derivative(p, &yo::OptionParams::volatility);
+        g.dT = q * num_greeks.derivative(p, &yo::OptionParams::exercise_time);
+    }
+}
+
+// --- AAD ---
+BENCHMARK_CASE(aad_risk_checkpointed)
+{
+    const Book b = book();
+    ye::AdjointPortfolioPricer aad{true};
+    ye::AdjointRisk risk;
+    state.run(n_positions, [&]{ risk = aad.risk(b.params, b.quantities); });
+
+    ye::BSEngine bs_engine;
+    ye::NumericalEngineGreeks num_greeks{bs_engine, h};
+    std::vector<ye::PositionGradient> bumped(n_positions);
+    bump_and_reprice(num_greeks, b, bumped);
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < n_positions; ++i)
+    {
+        const ye::PositionGradient& x = risk.positions[i];
+        const ye::PositionGradient& y = bumped[i];
+        max_diff = std::max({ max_diff, std::abs(x.dS - y.dS), std::abs(x.dK - y.dK),
+                              std::abs(x.dr - y.dr), std::abs(x.db - y.db),
+                              std::abs(x.dsigma - y.dsigma), std::abs(x.dT - y.dT) });
+    }
+    if (max_diff > 1e-5) throw std::runtime_error("AAD gradient differs from bump-and-reprice.");
+}
+
+BENCHMARK_CASE(aad_risk_single_sweep)
+{
+    const Book b = book();
+    ye::AdjointPortfolioPricer aad{false};
+    state.run(n_positions, [&]{ yb::do_not_optimize(aad.risk(b.params, b.quantities)); });
+}
+
+// --- Bump-and-Reprice ---
+BENCHMARK_CASE(aad_bump_and_reprice)
+{
+    const Book b = book();
+    ye::BSEngine bs_engine;
+    ye::NumericalEngineGreeks num_greeks{bs_engine, h};
+    std::vector<ye::PositionGradient> bumped(n_positions);
+    state.run(n_positions, [&]{ bump_and_reprice(num_greeks, b, bumped); });
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_aad.cpp -o bench_aad
@@ -0,0 +1,127 @@
+/*
+bench_chain.cpp
+Copyright © 2025 Yvan Richard
+
+Pricing of a realistic option chain: 20 maturities x 200 strikes
+(calls and puts, vol smile), i.e. 4000 options sharing (S, r, b):
+    - BSEngine batch (every option independent)
+    - ChainPricer batch (grouped by S, T, r, b, per-maturity work once)
+    - ChainPricer::price_chain() on the columns of each maturity
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one option. The ChainPricer
+benchmarks fail if their prices are off BSEngine's.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/ChainPricer.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_maturities = 20;
+constexpr std::size_t n_strikes = 200;
+
+// chain(): maturities 1m..20m, strikes 50%..150% of spot, quadratic smile
+std::vector<yo::OptionParams> chain()
+{
+    std::vector<yo::OptionParams> out;
+    for (std::size_t m = 0; m < n_maturities; ++m)
+    {
+        for (std::size_t k = 0; k < n_strikes; ++k)
+        {
+            yo::OptionParams p{};
+            p.asset_price = 100.0;
+            p.r = 0.03;
+            p.cost_of_carry = 0.01;
+            p.exercise_time = (m + 1) / 12.0;
+            p.strike_price = 50.0 + 0.5 * k;
+            double moneyness = std::log(p.strike_price / p.asset_price);
+            p.volatility = 0.2 + 0.4 * moneyness * moneyness;
+            p.option_type = (k % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+            out.push_back(p);
+        }
+    }
+    return out;
+}
+
+// check_against_bs(): throws if the prices are off BSEngine's
+void check_against_bs(const std::vector<yo::OptionParams>& options, const std::vector<double>& prices)
+{
+    ye::BSEngine bs_engine;
+    const std::vector<double> expected = bs_engine.price(options);
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < options.size(); ++i) max_diff = std::max(max_diff, std::abs(prices[i] - expected[i]));
+    if (max_diff > 1e-10) throw std::runtime_error("ChainPricer differs from BSEngine.");
+}
+
+// --- Batches ---
+BENCHMARK_CASE(chain_BSEngine_price_span)
+{
+    ye::BSEngine bs_engine;
+    const auto options = chain();
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ bs_engine.price(options, out); });
+}
+
+BENCHMARK_CASE(chain_ChainPricer_price_span)
+{
+    ye::ChainPricer chain_pricer;
+    const auto options = chain();
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ chain_pricer.price(options, out); });
+    check_against_bs(options, out);
+}
+
+// --- Columns ---
+BENCHMARK_CASE(chain_ChainPricer_price_chain)
+{
+    const auto options = chain();
+    std::vector<double> strikes(n_strikes), vols(n_strikes), out(options.size());
+    std::vector<yo::OptionType> types(n_strikes);
+    for (std::size_t k = 0; k < n_strikes; ++k)
+    {
+        strikes[k] = options[k].strike_price;
+        vols[k] = options[k].volatility;
+        types[k] = options[k].option_type;
+    }
+    state.run(options.size(), [&]{
+        for (std::size_t m = 0; m < n_maturities; ++m)
+        {
+            ye::ChainPricer::price_chain(options[m * n_strikes], strikes, vols, types,
+                                         std::span<double>(out).subspan(m * n_strikes, n_strikes));
+        }
+    });
+    check_against_bs(options, out);
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_chain.cpp -o bench_chain
+// (add -ffast-math to let the strike loops call the vector math library)
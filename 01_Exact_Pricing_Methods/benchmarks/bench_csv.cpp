@@ -0,0 +1,116 @@
+/*
+bench_csv.cpp
+Copyright © 2025 Yvan Richard
+
+Export of a 501 x 501 price surface (251k rows, ~6 MB of CSV):
+    - per-cell std::ofstream << with std::fixed << std::setprecision(4)
+      (the writer of 03_Visualization before util::write_surface_csv)
+    - util::write_surface_csv, 1 thread (to_chars into a 1 MiB buffer)
+    - util::write_surface_csv, all hardware threads (chunks of rows)
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one row of CSV written.
+*/
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/util/param_grid.hpp"
+#include "../include/util/parallel.hpp"
+#include "../include/util/surface_io.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace yu = yvan::util;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr const char* path = "bench_surface.csv";
+
+// Surface: the (S, T) grid and its prices
+struct Surface
+{
+    yu::Grid2D<yo::OptionParams> grid;
+    yu::Grid2D<double> prices;
+};
+
+Surface surface()
+{
+    yo::OptionParams base{};
+    Surface s;
+    s.grid = yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 50.0, 150.0, 0.2,
+        &yo::OptionParams::exercise_time, 0.1, 1.1, 0.002);
+    ye::BSEngine bs_engine;
+    s.prices = bs_engine.price(s.grid);
+    return s;
+}
+
+const yu::SurfaceCsv format{ "asset_price", "exercise_time", "price", 4 };
+
+// --- Writers ---
+BENCHMARK_CASE(csv_ofstream_per_cell)
+{
+    const Surface s = surface();
+    state.run(s.grid.data.size(), [&]{
+        std::ofstream file(path);
+        file << "asset_price,exercise_time,price\n";
+        for (std::size_t i = 0; i < s.grid.nrows; ++i)
+        {
+            for (std::size_t j = 0; j < s.grid.ncols; ++j)
+            {
+                file << std::fixed << std::setprecision(4)
+                     << s.grid(i, j).asset_price << ","
+                     << s.grid(i, j).exercise_time << ","
+                     << s.prices(i, j) << "\n";
+            }
+        }
+    });
+    std::filesystem::remove(path);
+}
+
+BENCHMARK_CASE(csv_write_surface_csv_1_thread)
+{
+    const Surface s = surface();
+    state.run(s.grid.data.size(), [&]{
+        yu::write_surface_csv(path, s.grid, &yo::OptionParams::asset_price, &yo::OptionParams::exercise_time,
+                              s.prices, format, 1);
+    });
+    std::filesystem::remove(path);
+}
+
+BENCHMARK_CASE(csv_write_surface_csv_all_threads)
+{
+    const Surface s = surface();
+    const std::size_t n_threads = yu::default_thread_count();
+    state.run(s.grid.data.size(), [&]{
+        yu::write_surface_csv(path, s.grid, &yo::OptionParams::asset_price, &yo::OptionParams::exercise_time,
+                              s.prices, format, n_threads);
+    });
+    std::filesystem::remove(path);
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_csv.cpp -o bench_csv
@@ -0,0 +1,135 @@
+/*
+bench_curves.cpp
+Copyright © 2025 Yvan Richard
+
+Pricing of an option chain (20 maturities x 500 strikes, grouped by
+maturity) with term-structure rates and dividends:
+    - BSEngine on flat r / b params (the zero rates of each maturity),
+      which recomputes exp(-rT) and exp((b-r)T) for every option
+    - the same formula with the erfc N of CurveBSEngine (still two exps
+      per option), to separate the gain of the CDF from the one of the
+      maturity factors
+    - CurveBSEngine reading the precomputed maturity factors of its
+      discount and dividend curves
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one option. The CurveBSEngine
+benchmark fails if its prices are off BSEngine's on the flat params.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/CurveBSEngine.hpp"
+#include "../include/util/curve.hpp"
+#include "../include/util/distributions.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yu = yvan::util;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+std::vector<double> maturities()
+{
+    std::vector<double> out;
+    for (int m = 1; m <= 20; ++m) out.push_back(0.125 * m);
+    return out;
+}
+
+ye::CurveBSEngine curve_engine()
+{
+    yu::DiscountCurve rates = yu::DiscountCurve::from_zero_rates({0.25, 0.5, 1.0, 2.0, 5.0}, {0.030, 0.032, 0.035, 0.038, 0.040});
+    yu::DiscountCurve dividends = yu::DiscountCurve::from_zero_rates({1.0, 5.0}, {0.015, 0.02});
+    return ye::CurveBSEngine{rates, dividends, maturities()};
+}
+
+// chain(): grouped by maturity; the flat params carry the zero rates of their maturity
+std::vector<yo::OptionParams> chain(const ye::CurveBSEngine& engine)
+{
+    std::vector<yo::OptionParams> out;
+    for (double T : maturities())
+    {
+        for (int k = 0; k < 500; ++k)
+        {
+            yo::OptionParams p{};
+            p.asset_price = 100.0;
+            p.strike_price = 50.0 + 0.2 * k;
+            p.volatility = 0.25;
+            p.exercise_time = T;
+            p.option_type = (k % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+            out.push_back(engine.flat_params(p));
+        }
+    }
+    return out;
+}
+
+// flat_price_erfc(): the BSEngine formula with the erfc N of CurveBSEngine (two exps
+// per option), to tell the gain of the maturity factors from the gain of the CDF
+double flat_price_erfc(const yo::OptionParams& p)
+{
+    const double sign = static_cast<int>(p.option_type);
+    const double vol_sqrt_t = p.volatility * std::sqrt(p.exercise_time);
+    const double d1 = (std::log(p.asset_price / p.strike_price)
+                       + p.exercise_time * (p.cost_of_carry + p.volatility * p.volatility / 2.0)) / vol_sqrt_t;
+    const double d2 = d1 - vol_sqrt_t;
+    return sign * (p.asset_price * std::exp((p.cost_of_carry - p.r) * p.exercise_time) * yu::N<double>(sign * d1)
+                   - p.strike_price * std::exp(-p.r * p.exercise_time) * yu::N<double>(sign * d2));
+}
+
+// --- Flat Rates ---
+BENCHMARK_CASE(curves_BSEngine_flat_price_span)
+{
+    ye::BSEngine bs_engine;
+    const auto options = chain(curve_engine());
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ bs_engine.price(options, out); });
+}
+
+BENCHMARK_CASE(curves_flat_kernel_erfc)
+{
+    const auto options = chain(curve_engine());
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ for (std::size_t i = 0; i < options.size(); ++i) out[i] = flat_price_erfc(options[i]); });
+}
+
+// --- Curves ---
+BENCHMARK_CASE(curves_CurveBSEngine_price_span)
+{
+    const ye::CurveBSEngine engine = curve_engine();
+    const auto options = chain(engine);
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ engine.price(options, out); });
+
+    ye::BSEngine bs_engine;
+    const std::vector<double> expected = bs_engine.price(options);
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < options.size(); ++i) max_diff = std::max(max_diff, std::abs(out[i] - expected[i]));
+    if (max_diff > 1e-10) throw std::runtime_error("CurveBSEngine differs from BSEngine on the flat params.");
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_curves.cpp -o bench_curves
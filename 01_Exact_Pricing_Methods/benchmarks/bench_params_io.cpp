@@ -0,0 +1,148 @@
+/*
+bench_params_io.cpp
+Copyright © 2025 Yvan Richard
+
+Loading a book of 200k positions (~8.5 MB of CSV) into OptionParams:
+    - std::getline + std::stod per field, rows checked by constructing a
+      EuropeanOption (Option::validate_params throws on a bad row)
+    - util::load_params_csv, 1 thread (mapped file, std::from_chars)
+    - util::load_params_csv, all hardware threads (chunks cut on line ends)
+    - util::load_params_binary (columns of the mapped file, no parsing)
+One row in 1000 is invalid. Run by the benchmark framework
+(tests/support/benchmark_framework.hpp, same options as bench_suite);
+one op is one row of the file. A benchmark fails if it does not load
+every valid row.
+*/
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/options/EuropeanOption.hpp"
+#include "../include/util/parallel.hpp"
+#include "../include/util/params_io.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace yu = yvan::util;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_rows = 200000;
+constexpr std::size_t n_valid = n_rows - n_rows / 1000;
+constexpr const char* csv_path = "bench_book.csv";
+constexpr const char* bin_path = "bench_book.bin";
+
+// write_books(): the CSV book and its binary copy
+void write_books()
+{
+    {
+        std::ofstream out(csv_path);
+        out << "id,option_type,asset_price,strike_price,r,cost_of_carry,volatility,exercise_time,quantity\n";
+        for (std::size_t i = 0; i < n_rows; ++i)
+        {
+            out << "T" << i << ',' << (i % 2 ? "put" : "call") << ',' << 50.0 + (i % 1000) * 0.1 << ','
+                << 60 + i % 80 << ",0.05,0.03," << (i % 1000 == 999 ? -0.2 : 0.1 + (i % 50) * 0.01) << ','
+                << 0.05 + (i % 40) * 0.05 << ',' << static_cast<int>(i % 21) - 10 << '\n';
+        }
+    }
+    const yu::ParamsLoad book = yu::load_params_csv(csv_path, {}, yu::default_thread_count());
+    yu::write_params_binary(bin_path, book.params, book.quantities);
+}
+
+// check_loaded(): throws unless every valid row was loaded
+void check_loaded(std::size_t loaded)
+{
+    if (loaded != n_valid) throw std::runtime_error("Wrong number of rows loaded: " + std::to_string(loaded) + ".");
+}
+
+// --- CSV ---
+BENCHMARK_CASE(params_io_getline_stod_validate)
+{
+    std::size_t loaded = 0;
+    state.run(n_rows, [&]{
+        std::ifstream in(csv_path);
+        std::string line, cell;
+        std::getline(in, line); // header
+        std::vector<yo::OptionParams> params;
+        std::vector<double> quantities;
+        while (std::getline(in, line))
+        {
+            std::istringstream row(line);
+            yo::OptionParams p{};
+            std::getline(row, cell, ',');
+            std::getline(row, cell, ','); p.option_type = cell == "put" ? yo::OptionType::Put : yo::OptionType::Call;
+            std::getline(row, cell, ','); p.asset_price = std::stod(cell);
+            std::getline(row, cell, ','); p.strike_price = std::stod(cell);
+            std::getline(row, cell, ','); p.r = std::stod(cell);
+            std::getline(row, cell, ','); p.cost_of_carry = std::stod(cell);
+            std::getline(row, cell, ','); p.volatility = std::stod(cell);
+            std::getline(row, cell, ','); p.exercise_time = std::stod(cell);
+            std::getline(row, cell, ',');
+            try
+            {
+                yo::EuropeanOption check(p);
+                params.push_back(p);
+                quantities.push_back(std::stod(cell));
+            }
+            catch (const std::invalid_argument&) {}
+        }
+        loaded = params.size();
+    });
+    check_loaded(loaded);
+}
+
+BENCHMARK_CASE(params_io_load_params_csv_1_thread)
+{
+    std::size_t loaded = 0;
+    state.run(n_rows, [&]{ loaded = yu::load_params_csv(csv_path, {}, 1).params.size(); });
+    check_loaded(loaded);
+}
+
+BENCHMARK_CASE(params_io_load_params_csv_all_threads)
+{
+    const std::size_t n_threads = yu::default_thread_count();
+    std::size_t loaded = 0;
+    state.run(n_rows, [&]{ loaded = yu::load_params_csv(csv_path, {}, n_threads).params.size(); });
+    check_loaded(loaded);
+}
+
+// --- Binary ---
+BENCHMARK_CASE(params_io_load_params_binary)
+{
+    const std::size_t n_threads = yu::default_thread_count();
+    std::size_t loaded = 0;
+    state.run(n_rows, [&]{ loaded = yu::load_params_binary(bin_path, n_threads).params.size(); });
+    check_loaded(loaded);
+}
+
+int main(int argc, char* argv[])
+{
+    int status = 0;
+    try
+    {
+        const yb::Options options = yb::parse_options(argc, argv);
+        write_books();
+        if (yb::failures(yb::run_all_benchmarks(options)) > 0) status = 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        status = 1;
+    }
+    std::error_code ignored;
+    std::filesystem::remove(csv_path, ignored);
+    std::filesystem::remove(bin_path, ignored);
+    return status;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_params_io.cpp -o bench_params_io
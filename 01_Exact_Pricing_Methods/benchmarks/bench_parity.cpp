@@ -0,0 +1,98 @@
+/*
+bench_parity.cpp
+Copyright © 2025 Yvan Richard
+
+Batch put-call parity scan of one million quotes (500k calls and 500k
+puts over 50 maturities x 10k strikes, shuffled, with a dividend
+yield), 0.1% of the pairs being mispriced. Run by the benchmark
+framework (tests/support/benchmark_framework.hpp, same options as
+bench_suite); one op is one quote. The benchmark fails if it does not
+find every mispriced pair.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/ChainPricer.hpp"
+#include "../include/util/parity.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yu = yvan::util;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_maturities = 50;
+constexpr std::size_t n_strikes = 10000;
+constexpr std::size_t mispricing_step = 2000; // one quote in 2000 is mispriced
+
+// quotes(): the calls and puts, shuffled (deterministic LCG) so that the pairs are not adjacent
+std::vector<yo::OptionParams> quotes()
+{
+    std::vector<yo::OptionParams> out;
+    out.reserve(2 * n_maturities * n_strikes);
+    for (std::size_t m = 0; m < n_maturities; ++m)
+    {
+        for (std::size_t k = 0; k < n_strikes; ++k)
+        {
+            yo::OptionParams p{};
+            p.asset_price = 100.0;
+            p.r = 0.04;
+            p.cost_of_carry = 0.01;
+            p.volatility = 0.25;
+            p.exercise_time = 0.05 * (m + 1);
+            p.strike_price = 50.0 + 0.01 * k;
+            out.push_back(p);
+            p.option_type = yo::OptionType::Put;
+            out.push_back(p);
+        }
+    }
+    std::uint64_t state = 42;
+    for (std::size_t i = out.size() - 1; i > 0; --i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        std::swap(out[i], out[(state >> 33) % (i + 1)]);
+    }
+    return out;
+}
+
+// --- Scan ---
+BENCHMARK_CASE(parity_scan_parity)
+{
+    const auto options = quotes();
+    ye::ChainPricer pricer;
+    std::vector<double> prices = pricer.price(options);
+    for (std::size_t i = 0; i < prices.size(); i += mispricing_step) prices[i] += 0.05; // mispriced quotes
+
+    std::vector<yu::ParityViolation> violations;
+    state.run(options.size(), [&]{ violations = yu::scan_parity(options, prices, 1e-6).violations; });
+    if (violations.size() != options.size() / mispricing_step)
+    {
+        throw std::runtime_error("Wrong number of violations: " + std::to_string(violations.size()) + ".");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_parity.cpp -o bench_parity
@@ -0,0 +1,126 @@
+/*
+bench_parity_pricer.cpp
+Copyright © 2025 Yvan Richard
+
+Pricing of a mixed book of 200k call/put pairs (400k options), with the
+legs of each pair next to each other (chain order) and shuffled:
+    - BSEngine on every option
+    - ParityPricer over BSEngine (one leg per pair, the other by parity)
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one option. The ParityPricer
+benchmarks fail if their prices are off BSEngine's.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/ParityPricer.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_pairs = 200000;
+
+// book(): the pairs in chain order, or shuffled (deterministic LCG)
+std::vector<yo::OptionParams> book(bool shuffled)
+{
+    std::vector<yo::OptionParams> out;
+    out.reserve(2 * n_pairs);
+    for (std::size_t k = 0; k < n_pairs; ++k)
+    {
+        yo::OptionParams p{};
+        p.asset_price = 100.0;
+        p.strike_price = 50.0 + 100.0 * ((k * 37) % 1000) / 1000.0;
+        p.r = 0.04;
+        p.cost_of_carry = 0.01;
+        p.volatility = 0.1 + 0.4 * ((k * 7) % 500) / 500.0;
+        p.exercise_time = 0.05 + 2.0 * (k % 97) / 97.0;
+        out.push_back(p);
+        p.option_type = yo::OptionType::Put;
+        out.push_back(p);
+    }
+    if (shuffled)
+    {
+        std::uint64_t state = 7;
+        for (std::size_t i = out.size() - 1; i > 0; --i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::swap(out[i], out[(state >> 33) % (i + 1)]);
+        }
+    }
+    return out;
+}
+
+// bench_parity_pricer(): times ParityPricer over BSEngine, then checks it against BSEngine
+void bench_parity_pricer(yb::State& state, bool shuffled)
+{
+    ye::BSEngine bs_engine;
+    ye::ParityPricer parity_pricer{bs_engine};
+    const auto options = book(shuffled);
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ parity_pricer.price(options, out); });
+
+    const std::vector<double> expected = bs_engine.price(options);
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < options.size(); ++i) max_diff = std::max(max_diff, std::abs(out[i] - expected[i]));
+    if (max_diff > 1e-10) throw std::runtime_error("ParityPricer differs from BSEngine.");
+}
+
+// --- Chain Order ---
+BENCHMARK_CASE(parity_pricer_BSEngine_chain_order)
+{
+    ye::BSEngine bs_engine;
+    const auto options = book(false);
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ bs_engine.price(options, out); });
+}
+
+BENCHMARK_CASE(parity_pricer_ParityPricer_chain_order)
+{
+    bench_parity_pricer(state, false);
+}
+
+// --- Shuffled ---
+BENCHMARK_CASE(parity_pricer_BSEngine_shuffled)
+{
+    ye::BSEngine bs_engine;
+    const auto options = book(true);
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ bs_engine.price(options, out); });
+}
+
+BENCHMARK_CASE(parity_pricer_ParityPricer_shuffled)
+{
+    bench_parity_pricer(state, true);
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_parity_pricer.cpp -o bench_parity_pricer
@@ -0,0 +1,144 @@
+/*
+bench_precision.cpp
+Copyright © 2025 Yvan Richard
+
+Throughput of the Black-Scholes kernels in single vs double precision
+(and in mixed precision: double in/out, float arithmetic), on the two
+batch paths of the project, over a 501 x 501 (S, sigma) sweep:
+    - vector path (sweep_1d like batch of OptionParams)
+    - Grid2D path (sweep_2d surface)
+BSEngine's double kernel goes through the Boost CDF while the float
+kernel uses the erfc form, so the vector path also runs the double
+kernel with the erfc N (ErfcKernel below): that pair measures the cost
+of the precision alone.
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one option. The erfc benchmark
+fails if its prices are off BSEngine's.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/EngineConcepts.hpp"
+#include "../include/engines/Kernels.hpp"
+#include "../include/util/grid2d.hpp"
+#include "../include/util/param_grid.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yu = yvan::util;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+// grid_d(): the S x sigma sweep
+yu::Grid2D<yo::OptionParams> grid_d()
+{
+    yo::OptionParams base{};
+    return yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 30.0, 130.0, 0.2,
+        &yo::OptionParams::volatility, 0.05, 0.55, 0.001);
+}
+
+// grid_f(): the same sweep in single precision
+yu::Grid2D<yo::OptionParamsF> grid_f()
+{
+    const yu::Grid2D<yo::OptionParams> grid = grid_d();
+    yu::Grid2D<yo::OptionParamsF> out(grid.nrows, grid.ncols);
+    for (std::size_t i = 0; i < grid.data.size(); ++i) out.data[i] = yo::params_cast<float>(grid.data[i]);
+    return out;
+}
+
+// ErfcKernel: the Black-Scholes kernel with the erfc N for every Real
+// (kernels::bs_price_factors, with the maturity factors computed per option)
+struct ErfcKernel
+{
+    template<typename Real>
+    Real price_kernel(const yo::BasicOptionParams<Real>& p) const
+    {
+        using std::exp; using std::sqrt;
+        const ye::kernels::MaturityFactors<Real> f{ p.exercise_time, sqrt(p.exercise_time),
+            exp(-p.r * p.exercise_time), exp((p.cost_of_carry - p.r) * p.exercise_time),
+            p.cost_of_carry * p.exercise_time };
+        return ye::kernels::bs_price_factors(p.asset_price, p.strike_price, p.volatility, p.option_type, f);
+    }
+};
+
+// --- Vector Path ---
+BENCHMARK_CASE(precision_vector_double)
+{
+    ye::BSEngine bs_engine;
+    const std::vector<yo::OptionParams> batch = grid_d().data;
+    std::vector<double> out(batch.size());
+    state.run(batch.size(), [&]{ ye::price_batch(bs_engine, std::span<const yo::OptionParams>(batch), std::span<double>(out)); });
+}
+
+BENCHMARK_CASE(precision_vector_double_erfc)
+{
+    ErfcKernel kernel;
+    const std::vector<yo::OptionParams> batch = grid_d().data;
+    std::vector<double> out(batch.size());
+    state.run(batch.size(), [&]{ ye::price_batch(kernel, std::span<const yo::OptionParams>(batch), std::span<double>(out)); });
+
+    const std::vector<double> expected = ye::price_batch(ye::BSEngine{}, batch);
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < batch.size(); ++i) max_diff = std::max(max_diff, std::abs(out[i] - expected[i]));
+    if (max_diff > 1e-10) throw std::runtime_error("The erfc kernel differs from BSEngine.");
+}
+
+BENCHMARK_CASE(precision_vector_float)
+{
+    ye::BSEngine bs_engine;
+    const std::vector<yo::OptionParamsF> batch = grid_f().data;
+    std::vector<float> out(batch.size());
+    state.run(batch.size(), [&]{ ye::price_batch(bs_engine, std::span<const yo::OptionParamsF>(batch), std::span<float>(out)); });
+}
+
+BENCHMARK_CASE(precision_vector_mixed)
+{
+    ye::BSEngine bs_engine;
+    const std::vector<yo::OptionParams> batch = grid_d().data;
+    std::vector<double> out(batch.size());
+    state.run(batch.size(), [&]{ ye::price_batch_mixed(bs_engine, std::span<const yo::OptionParams>(batch), std::span<double>(out)); });
+}
+
+// --- Grid2D Path ---
+BENCHMARK_CASE(precision_grid_double)
+{
+    ye::BSEngine bs_engine;
+    const yu::Grid2D<yo::OptionParams> grid = grid_d();
+    state.run(grid.data.size(), [&]{ yb::do_not_optimize(ye::price_batch(bs_engine, grid)); });
+}
+
+BENCHMARK_CASE(precision_grid_float)
+{
+    ye::BSEngine bs_engine;
+    const yu::Grid2D<yo::OptionParamsF> grid = grid_f();
+    state.run(grid.data.size(), [&]{ yb::do_not_optimize(ye::price_batch(bs_engine, grid)); });
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_precision.cpp -o bench_precision
@@ -0,0 +1,105 @@
+/*
+bench_scenarios.cpp
+Copyright © 2025 Yvan Richard
+
+Throughput of the scenario engine: a book of 1000 European options
+repriced under 1000 spot / vol / rate scenarios (1M pricings), on one
+thread and on every hardware thread, with the VaR-style quantiles of
+the P&L. Run by the benchmark framework
+(tests/support/benchmark_framework.hpp, same options as bench_suite);
+one op is one pricing. The multi-threaded benchmark fails if its
+quantiles are not those of the single-threaded run.
+*/
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/ScenarioEngine.hpp"
+#include "../include/util/parallel.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yu = yvan::util;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_positions = 1000;
+constexpr std::size_t n_scenarios = 1000;
+
+// Run: the book, its scenarios and the quantile levels
+struct Run
+{
+    std::vector<yo::OptionParams> book = std::vector<yo::OptionParams>(n_positions);
+    std::vector<double> quantities = std::vector<double>(n_positions);
+    std::vector<ye::Scenario> scenarios = std::vector<ye::Scenario>(n_scenarios);
+    std::vector<double> levels{0.01, 0.05, 0.5, 0.95, 0.99};
+};
+
+Run scenario_run()
+{
+    Run run;
+    for (std::size_t i = 0; i < n_positions; ++i)
+    {
+        yo::OptionParams& p = run.book[i];
+        p.asset_price = 100.0;
+        p.strike_price = 60.0 + 80.0 * ((i * 37) % 1000) / 1000.0;
+        p.exercise_time = 0.1 + 1.9 * ((i * 11) % 100) / 100.0;
+        p.volatility = 0.1 + 0.4 * ((i * 7) % 50) / 50.0;
+        p.option_type = (i % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+        run.quantities[i] = (i % 5) - 2.0;
+    }
+    for (std::size_t k = 0; k < n_scenarios; ++k)
+    {
+        run.scenarios[k] = ye::Scenario{ -0.25 + 0.5 * ((k * 13) % 101) / 100.0,
+                                         -0.05 + 0.1 * ((k * 7) % 51) / 50.0,
+                                         -0.01 + 0.02 * ((k * 3) % 11) / 10.0 };
+    }
+    return run;
+}
+
+// --- Scenario Engine ---
+BENCHMARK_CASE(scenarios_run_1_thread)
+{
+    const Run run = scenario_run();
+    ye::BSEngine bs_engine;
+    ye::ScenarioEngine engine{bs_engine, 1};
+    state.run(n_positions * n_scenarios, [&]{
+        yb::do_not_optimize(engine.run(run.book, run.quantities, run.scenarios, run.levels));
+    });
+}
+
+BENCHMARK_CASE(scenarios_run_all_threads)
+{
+    const Run run = scenario_run();
+    ye::BSEngine bs_engine;
+    ye::ScenarioEngine engine{bs_engine, yu::default_thread_count()};
+    ye::ScenarioReport report;
+    state.run(n_positions * n_scenarios, [&]{ report = engine.run(run.book, run.quantities, run.scenarios, run.levels); });
+
+    const ye::ScenarioReport single = ye::ScenarioEngine{bs_engine, 1}.run(run.book, run.quantities, run.scenarios, run.levels);
+    if (report.quantiles != single.quantiles) throw std::runtime_error("The quantiles depend on the thread count.");
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -pthread -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_scenarios.cpp -o bench_scenarios
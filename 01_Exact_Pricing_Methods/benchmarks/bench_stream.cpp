@@ -0,0 +1,97 @@
+/*
+bench_stream.cpp
+Copyright © 2025 Yvan Richard
+
+Generation of a 2001 x 1001 price surface (2M options) to CSV + binary:
+    - streamed: util::stream_surface (batches of rows priced while a
+      writer thread formats the previous ones, bounded queue)
+    - full grid: util::sweep_2d + BSEngine on the whole grid, then
+      util::write_surface_csv and util::write_surface_binary
+The wall time and the growth of the peak resident memory of each run are
+reported (the streamed run goes first so that its peak is not hidden by
+the full grid's).
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <sys/resource.h>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/util/param_grid.hpp"
+#include "../include/util/surface_io.hpp"
+#include "../include/util/surface_stream.hpp"
+
+namespace yo = yvan::option;
+namespace yu = yvan::util;
+namespace ye = yvan::engine;
+
+// peak_rss_mb(): peak resident memory of the process so far
+double peak_rss_mb()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1e6; // bytes
+#else
+    return usage.ru_maxrss / 1e3; // kilobytes
+#endif
+}
+
+// run(): wall time of the body in seconds and growth of the peak memory
+template<typename F>
+void run(const char* name, F&& body)
+{
+    const double rss_before = peak_rss_mb();
+    auto t0 = std::chrono::steady_clock::now();
+    body();
+    auto t1 = std::chrono::steady_clock::now();
+    std::printf("%-12s %8.1f ms   peak memory +%7.1f MB\n", name,
+                std::chrono::duration<double>(t1 - t0).count() * 1e3, peak_rss_mb() - rss_before);
+}
+
+int main()
+{
+    yo::OptionParams base{};
+    base.strike_price = 110.0;
+    const double start_S = 50.0, end_S = 150.0, step_S = 0.05;
+    const double start_T = 0.1, end_T = 1.1, step_T = 0.001;
+    ye::BSEngine bs_engine;
+
+    const yu::SurfaceCsv csv_format{ "asset_price", "exercise_time", "price", 4 };
+    const yu::SurfaceNames names{ "asset_price", "exercise_time", "price" };
+
+    run("streamed", [&]{
+        yu::CsvSurfaceSink csv("bench_stream.csv", csv_format);
+        yu::BinarySurfaceSink bin("bench_stream.bin", names);
+        yu::stream_surface(base, &yo::OptionParams::asset_price, start_S, end_S, step_S,
+                           &yo::OptionParams::exercise_time, start_T, end_T, step_T,
+                           [&](std::span<const yo::OptionParams> batch, std::span<double> out) { bs_engine.price(batch, out); },
+                           { &csv, &bin });
+    });
+
+    run("full grid", [&]{
+        yu::Grid2D<yo::OptionParams> grid = yu::sweep_2d(base,
+            &yo::OptionParams::asset_price, start_S, end_S, step_S,
+            &yo::OptionParams::exercise_time, start_T, end_T, step_T);
+        yu::Grid2D<double> prices = bs_engine.price(grid);
+        yu::write_surface_csv("bench_full.csv", grid, &yo::OptionParams::asset_price,
+                              &yo::OptionParams::exercise_time, prices, csv_format);
+        yu::write_surface_binary("bench_full.bin", grid, &yo::OptionParams::asset_price,
+                                 &yo::OptionParams::exercise_time, prices, names);
+    });
+
+    std::printf("%.1f MB of CSV + %.1f MB binary per run\n",
+                std::filesystem::file_size("bench_full.csv") / 1e6, std::filesystem::file_size("bench_full.bin") / 1e6);
+    for (const char* file : { "bench_stream.csv", "bench_stream.bin", "bench_full.csv", "bench_full.bin" })
+    {
+        std::filesystem::remove(file);
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_stream.cpp -o bench_stream
@@ -0,0 +1,347 @@
+/*
+bench_suite.cpp
+Copyright © 2025 Yvan Richard
+
+Micro-benchmarks of every engine and utility of the module, run by the
+benchmark framework (tests/support/benchmark_framework.hpp): ns/op
+(median +/- MAD of the samples), ops/s, and heap bytes / allocations
+per op. Batch benchmarks count one op per option priced.
+
+    ./bench_suite [--filter <text>] [--json <file>] [--label <text>]
+                  [--min-time <s>] [--samples <n>]
+
+e.g. ./bench_suite --json bench_$(git rev-parse --short HEAD).json
+     --label $(git rev-parse --short HEAD) keeps one JSON file per commit.
+
+The other bench_*.cpp files are larger workloads (chains, books, files)
+run by the same framework, with the same options and JSON output.
+bench_stream is the exception: it reports the wall time and the peak
+memory of one surface generation, which the samples would not show.
+
+The Monte Carlo runner of 02_Monte_Carlo (TestMC_std.cpp) is a study
+program built on the Datasim sources, which are not part of this tree,
+so it is not covered here.
+*/
+
+#include <cstdio>
+#include <span>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/options/Portfolio.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/BSEngineGreeks.hpp"
+#include "../include/engines/NumericalEngineGreeks.hpp"
+#include "../include/engines/PerpetualAmericanEngine.hpp"
+#include "../include/engines/ADEngineGreeks.hpp"
+#include "../include/engines/EngineConcepts.hpp"
+#include "../include/engines/CachedPricer.hpp"
+#include "../include/engines/ChainPricer.hpp"
+#include "../include/engines/ParityPricer.hpp"
+#include "../include/engines/PortfolioEngine.hpp"
+#include "../include/engines/TableEngine.hpp"
+#include "../include/util/distributions.hpp"
+#include "../include/util/grid2d.hpp"
+#include "../include/util/param_grid.hpp"
+#include "../include/util/validation.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace yu = yvan::util;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t batch_size = 4096;
+
+// book(): n options around the money (strikes, maturities, vols and types vary)
+std::vector<yo::OptionParams> book(std::size_t n)
+{
+    std::vector<yo::OptionParams> out(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        yo::OptionParams& p = out[i];
+        p.asset_price = 100.0;
+        p.strike_price = 70.0 + static_cast<double>(i % 61);
+        p.r = 0.04;
+        p.cost_of_carry = 0.04;
+        p.volatility = 0.1 + 0.01 * static_cast<double>(i % 41);
+        p.exercise_time = 0.1 + 0.05 * static_cast<double>(i % 39);
+        p.option_type = i % 2 ? yo::OptionType::Put : yo::OptionType::Call;
+    }
+    return out;
+}
+
+// perpetual(): the data of the perpetual American tests (b < r)
+yo::OptionParams perpetual()
+{
+    yo::OptionParams p{};
+    p.strike_price = 100.0; p.volatility = 0.1; p.r = 0.1; p.cost_of_carry = 0.02; p.asset_price = 110.0;
+    return p;
+}
+
+// --- Distributions ---
+BENCHMARK_CASE(util_N)
+{
+    double x = -3.0;
+    state.run(1, [&]{ yb::do_not_optimize(yu::N(x)); x = x > 3.0 ? -3.0 : x + 1e-3; });
+}
+
+BENCHMARK_CASE(util_n)
+{
+    double x = -3.0;
+    state.run(1, [&]{ yb::do_not_optimize(yu::n(x)); x = x > 3.0 ? -3.0 : x + 1e-3; });
+}
+
+// --- BSEngine ---
+BENCHMARK_CASE(BSEngine_price_single)
+{
+    ye::BSEngine engine;
+    const auto options = book(batch_size);
+    std::size_t i = 0;
+    state.run(1, [&]{ yb::do_not_optimize(engine.price(options[i])); i = (i + 1) % batch_size; });
+}
+
+BENCHMARK_CASE(BSEngine_price_span)
+{
+    ye::BSEngine engine;
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ engine.price(options, out); });
+}
+
+BENCHMARK_CASE(BSEngine_price_vector)
+{
+    ye::BSEngine engine;
+    const auto options = book(batch_size);
+    state.run(batch_size, [&]{ yb::do_not_optimize(engine.price(options)); });
+}
+
+BENCHMARK_CASE(BSEngine_price_checked_span)
+{
+    ye::BSEngine engine;
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ engine.price(options, out, yu::InvalidRows::NaN); });
+}
+
+BENCHMARK_CASE(BSEngine_price_float_span)
+{
+    ye::BSEngine engine;
+    std::vector<yo::OptionParamsF> options;
+    for (const auto& p : book(batch_size)) options.push_back(yo::params_cast<float>(p));
+    std::vector<float> out(batch_size);
+    state.run(batch_size, [&]{ ye::price_batch(engine, std::span<const yo::OptionParamsF>(options), std::span<float>(out)); });
+}
+
+// --- BSEngineGreeks ---
+BENCHMARK_CASE(BSEngineGreeks_delta_single)
+{
+    ye::BSEngineGreeks greeks;
+    const auto options = book(batch_size);
+    std::size_t i = 0;
+    state.run(1, [&]{ yb::do_not_optimize(greeks.delta(options[i])); i = (i + 1) % batch_size; });
+}
+
+BENCHMARK_CASE(BSEngineGreeks_gamma_single)
+{
+    ye::BSEngineGreeks greeks;
+    const auto options = book(batch_size);
+    std::size_t i = 0;
+    state.run(1, [&]{ yb::do_not_optimize(greeks.gamma(options[i])); i = (i + 1) % batch_size; });
+}
+
+BENCHMARK_CASE(BSEngineGreeks_delta_span)
+{
+    ye::BSEngineGreeks greeks;
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ greeks.delta(options, out); });
+}
+
+BENCHMARK_CASE(BSEngineGreeks_gamma_span)
+{
+    ye::BSEngineGreeks greeks;
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ greeks.gamma(options, out); });
+}
+
+// --- Other Greeks Engines ---
+BENCHMARK_CASE(NumericalEngineGreeks_delta_single)
+{
+    ye::BSEngine engine;
+    ye::NumericalEngineGreeks greeks(engine);
+    const auto options = book(batch_size);
+    std::size_t i = 0;
+    state.run(1, [&]{ yb::do_not_optimize(greeks.delta(options[i])); i = (i + 1) % batch_size; });
+}
+
+BENCHMARK_CASE(NumericalEngineGreeks_gamma_single)
+{
+    ye::BSEngine engine;
+    ye::NumericalEngineGreeks greeks(engine);
+    const auto options = book(batch_size);
+    std::size_t i = 0;
+    state.run(1, [&]{ yb::do_not_optimize(greeks.gamma(options[i])); i = (i + 1) % batch_size; });
+}
+
+BENCHMARK_CASE(NumericalEngineGreeks_delta_span)
+{
+    ye::BSEngine engine;
+    ye::NumericalEngineGreeks greeks(engine);
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ greeks.delta(options, out); });
+}
+
+BENCHMARK_CASE(ADEngineGreeks_delta_span)
+{
+    ye::BSEngine engine;
+    ye::ADEngineGreeks<ye::BSEngine> greeks(engine);
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ greeks.delta(options, out); });
+}
+
+// --- PerpetualAmericanEngine ---
+BENCHMARK_CASE(PerpetualAmericanEngine_price_single)
+{
+    ye::PerpetualAmericanEngine engine;
+    yo::OptionParams p = perpetual();
+    state.run(1, [&]{ yb::do_not_optimize(engine.price(p)); p.asset_price = p.asset_price > 150.0 ? 60.0 : p.asset_price + 0.01; });
+}
+
+BENCHMARK_CASE(PerpetualAmericanEngine_price_span)
+{
+    ye::PerpetualAmericanEngine engine;
+    const auto options = yu::sweep_1d(perpetual(), &yo::OptionParams::asset_price, 60.0, 150.0, 90.0 / batch_size);
+    std::vector<double> out(options.size());
+    state.run(options.size(), [&]{ engine.price(options, out); });
+}
+
+// --- Sweeps & Grid2D Overloads ---
+BENCHMARK_CASE(sweep_1d_4096)
+{
+    const yo::OptionParams base{};
+    std::vector<yo::OptionParams> line;
+    state.run(1, [&]{ line = yu::sweep_1d(base, &yo::OptionParams::asset_price, 50.0, 150.0, 100.0 / 4096); });
+}
+
+BENCHMARK_CASE(sweep_2d_100x100)
+{
+    const yo::OptionParams base{};
+    state.run(1, [&]{
+        yb::do_not_optimize(yu::sweep_2d(base, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                                         &yo::OptionParams::exercise_time, 0.1, 1.1, 0.01));
+    });
+}
+
+BENCHMARK_CASE(BSEngine_price_grid_alloc)
+{
+    ye::BSEngine engine;
+    const auto grid = yu::sweep_2d(yo::OptionParams{}, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                                   &yo::OptionParams::exercise_time, 0.1, 1.1, 0.01);
+    state.run(grid.data.size(), [&]{ yb::do_not_optimize(engine.price(grid)); });
+}
+
+BENCHMARK_CASE(BSEngine_price_grid_out)
+{
+    ye::BSEngine engine;
+    const auto grid = yu::sweep_2d(yo::OptionParams{}, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                                   &yo::OptionParams::exercise_time, 0.1, 1.1, 0.01);
+    yu::Grid2D<double> out(grid.nrows, grid.ncols);
+    state.run(grid.data.size(), [&]{ engine.price(grid, out); });
+}
+
+BENCHMARK_CASE(BSEngineGreeks_delta_grid_out)
+{
+    ye::BSEngineGreeks greeks;
+    const auto grid = yu::sweep_2d(yo::OptionParams{}, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                                   &yo::OptionParams::exercise_time, 0.1, 1.1, 0.01);
+    yu::Grid2D<double> out(grid.nrows, grid.ncols);
+    state.run(grid.data.size(), [&]{ greeks.delta(grid, out); });
+}
+
+// --- Batch Pricers ---
+BENCHMARK_CASE(CachedPricer_price_span_hits)
+{
+    ye::BSEngine engine;
+    ye::CachedPricer cached(engine, 2 * batch_size);
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    cached.price(options, out); // fill the cache
+    state.run(batch_size, [&]{ cached.price(options, out); });
+}
+
+BENCHMARK_CASE(ChainPricer_price_span)
+{
+    ye::ChainPricer chain;
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ chain.price(options, out); });
+}
+
+BENCHMARK_CASE(ParityPricer_price_span)
+{
+    ye::BSEngine engine;
+    ye::ParityPricer parity(engine);
+    const auto options = book(batch_size);
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ parity.price(options, out); });
+}
+
+BENCHMARK_CASE(TableEngine_price_span)
+{
+    ye::BSEngine engine;
+    ye::BSEngineGreeks greeks;
+    ye::TableSpec spec;
+    spec.base.strike_price = 100.0;
+    spec.start_x = 80.0; spec.end_x = 120.0; spec.step_x = 0.5;
+    spec.start_y = 0.1; spec.end_y = 0.5; spec.step_y = 0.01;
+    ye::TableEngine table(engine, greeks, spec);
+    std::vector<yo::OptionParams> options(batch_size, spec.base);
+    for (std::size_t i = 0; i < batch_size; ++i)
+    {
+        options[i].asset_price = 80.0 + 40.0 * static_cast<double>(i) / batch_size;
+        options[i].volatility = 0.1 + 0.4 * static_cast<double>(i % 97) / 97.0;
+    }
+    std::vector<double> out(batch_size);
+    state.run(batch_size, [&]{ table.price(options, out); });
+}
+
+BENCHMARK_CASE(PortfolioEngine_aggregate)
+{
+    ye::PortfolioEngine engine(1);
+    yo::Portfolio portfolio;
+    for (const auto& p : book(batch_size)) portfolio.add(p, 1.0);
+    state.run(batch_size, [&]{ yb::do_not_optimize(engine.aggregate(portfolio)); });
+}
+
+// --- Validation ---
+BENCHMARK_CASE(validate_batch_span)
+{
+    const auto options = book(batch_size);
+    std::vector<std::uint8_t> faults(batch_size);
+    state.run(batch_size, [&]{ yb::do_not_optimize(yu::validate_batch(options, faults)); });
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_suite.cpp -o bench_suite
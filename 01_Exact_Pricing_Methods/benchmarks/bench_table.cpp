@@ -0,0 +1,169 @@
+/*
+bench_table.cpp
+Copyright © 2025 Yvan Richard
+
+Latency of price / Greek lookups for a quoting loop: 100k random
+(spot, vol) queries on one strike and maturity:
+    - BSEngine / BSEngineGreeks (exact: log, exp, CDFs)
+    - TableEngine over a spot x vol table (bicubic interpolation)
+Single calls (price, quote = price + delta + gamma), the batch overload
+and the table build are run by the benchmark framework
+(tests/support/benchmark_framework.hpp, same options as bench_suite);
+one op is one lookup (one node for the build). The table lookup
+benchmark fails if a price is off by more than the table's error
+bound.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/engines/BSEngineGreeks.hpp"
+#include "../include/engines/TableEngine.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n_queries = 100000;
+
+// spec(): 81 x 41 nodes of spot x vol
+ye::TableSpec spec()
+{
+    ye::TableSpec s;
+    s.base.strike_price = 100.0;
+    s.base.r = 0.04;
+    s.base.cost_of_carry = 0.04;
+    s.base.exercise_time = 0.25;
+    s.field_x = &yo::OptionParams::asset_price;
+    s.start_x = 80.0; s.end_x = 120.0; s.step_x = 0.5;
+    s.field_y = &yo::OptionParams::volatility;
+    s.start_y = 0.1; s.end_y = 0.5; s.step_y = 0.01;
+    return s;
+}
+
+// queries(): random queries inside the table
+std::vector<yo::OptionParams> queries()
+{
+    std::vector<yo::OptionParams> out(n_queries, spec().base);
+    std::uint64_t state = 42;
+    auto uniform = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (state >> 11) * (1.0 / 9007199254740992.0);
+    };
+    for (auto& q : out)
+    {
+        q.asset_price = 80.0 + 40.0 * uniform();
+        q.volatility = 0.1 + 0.4 * uniform();
+    }
+    return out;
+}
+
+// --- Build ---
+BENCHMARK_CASE(table_TableEngine_build)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    const ye::TableSpec s = spec();
+    state.run(81 * 41, [&]{ yb::do_not_optimize(ye::TableEngine{bs_engine, bs_greeks, s}); });
+}
+
+// --- Price ---
+BENCHMARK_CASE(table_BSEngine_price_single)
+{
+    ye::BSEngine bs_engine;
+    const auto q = queries();
+    std::vector<double> out(n_queries);
+    state.run(n_queries, [&]{ for (std::size_t i = 0; i < n_queries; ++i) out[i] = bs_engine.price(q[i]); });
+}
+
+BENCHMARK_CASE(table_TableEngine_price_single)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    const ye::TableEngine table{bs_engine, bs_greeks, spec()};
+    const auto q = queries();
+    std::vector<double> out(n_queries);
+    state.run(n_queries, [&]{ for (std::size_t i = 0; i < n_queries; ++i) out[i] = table.price(q[i]); });
+
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < n_queries; ++i) max_diff = std::max(max_diff, std::abs(out[i] - bs_engine.price(q[i])));
+    if (max_diff > table.error_bounds().price) throw std::runtime_error("TableEngine price off by more than its bound.");
+}
+
+BENCHMARK_CASE(table_BSEngine_price_span)
+{
+    ye::BSEngine bs_engine;
+    const auto q = queries();
+    std::vector<double> out(n_queries);
+    state.run(n_queries, [&]{ bs_engine.price(std::span<const yo::OptionParams>(q), std::span<double>(out)); });
+}
+
+BENCHMARK_CASE(table_TableEngine_price_span)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    const ye::TableEngine table{bs_engine, bs_greeks, spec()};
+    const auto q = queries();
+    std::vector<double> out(n_queries);
+    state.run(n_queries, [&]{ table.price(std::span<const yo::OptionParams>(q), std::span<double>(out)); });
+}
+
+// --- Quote (price + delta + gamma) ---
+BENCHMARK_CASE(table_BSEngine_quote)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    const auto q = queries();
+    std::vector<double> out(n_queries);
+    state.run(n_queries, [&]{
+        for (std::size_t i = 0; i < n_queries; ++i)
+        {
+            out[i] = bs_engine.price(q[i]) + bs_greeks.delta(q[i]) + bs_greeks.gamma(q[i]);
+        }
+    });
+}
+
+BENCHMARK_CASE(table_TableEngine_quote)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    const ye::TableEngine table{bs_engine, bs_greeks, spec()};
+    const auto q = queries();
+    std::vector<double> out(n_queries);
+    state.run(n_queries, [&]{
+        for (std::size_t i = 0; i < n_queries; ++i)
+        {
+            const ye::TableQuote quote = table.quote(q[i]);
+            out[i] = quote.price + quote.delta + quote.gamma;
+        }
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_table.cpp -o bench_table
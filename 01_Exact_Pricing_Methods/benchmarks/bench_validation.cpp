@@ -0,0 +1,147 @@
+/*
+bench_validation.cpp
+Copyright © 2025 Yvan Richard
+
+Checking a batch of 16384 OptionParams (in cache, one row in 100
+invalid):
+    - one EuropeanOption per row in a try / catch (Option::validate_params
+      throws on a bad row)
+    - util::validate_batch on the params (one byte of fault bits per row)
+    - util::validate_batch on a Portfolio (columns)
+and pricing the batch with BSEngine:
+    - price(batch, out) on a batch with no invalid row
+    - price(batch, out, InvalidRows::NaN) on the same batch (cost of the check)
+    - price(batch, out, InvalidRows::NaN) on the batch with invalid rows
+Run by the benchmark framework (tests/support/benchmark_framework.hpp,
+same options as bench_suite); one op is one row. A benchmark fails if
+it does not find every invalid row.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/options/Option.hpp"
+#include "../include/options/EuropeanOption.hpp"
+#include "../include/options/Portfolio.hpp"
+#include "../include/engines/BSEngine.hpp"
+#include "../include/util/validation.hpp"
+#include "../tests/support/benchmark_framework.hpp"
+
+namespace yo = yvan::option;
+namespace yu = yvan::util;
+namespace ye = yvan::engine;
+namespace yb = yvan::bench;
+
+YB_COUNT_ALLOCATIONS()
+
+// --- Data ---
+constexpr std::size_t n = 16384;
+constexpr std::size_t n_invalid = n / 100;
+
+// batch(): valid rows, or one row in 100 with a negative volatility
+std::vector<yo::OptionParams> batch(bool dirty)
+{
+    std::vector<yo::OptionParams> out(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        yo::OptionParams& p = out[i];
+        p.asset_price = 50.0 + (i % 1000) * 0.1;
+        p.volatility = 0.1 + (i % 50) * 0.01;
+        p.exercise_time = 0.05 + (i % 40) * 0.05;
+        p.option_type = i % 2 ? yo::OptionType::Put : yo::OptionType::Call;
+        if (dirty && i % 100 == 99) p.volatility = -p.volatility;
+    }
+    return out;
+}
+
+// check_invalid(): throws unless the expected number of invalid rows was found
+void check_invalid(std::size_t invalid, std::size_t expected)
+{
+    if (invalid != expected) throw std::runtime_error("Wrong number of invalid rows: " + std::to_string(invalid) + ".");
+}
+
+// --- Validation ---
+BENCHMARK_CASE(validation_EuropeanOption_per_row)
+{
+    const auto dirty = batch(true);
+    std::size_t invalid = 0;
+    state.run(n, [&]{
+        invalid = 0;
+        for (const auto& p : dirty)
+        {
+            try { yo::EuropeanOption check(p); }
+            catch (const std::invalid_argument&) { ++invalid; }
+        }
+    });
+    check_invalid(invalid, n_invalid);
+}
+
+BENCHMARK_CASE(validation_validate_batch_params)
+{
+    const auto dirty = batch(true);
+    std::vector<std::uint8_t> faults(n);
+    std::size_t invalid = 0;
+    state.run(n, [&]{ invalid = yu::validate_batch(dirty, faults); });
+    check_invalid(invalid, n_invalid);
+}
+
+BENCHMARK_CASE(validation_validate_batch_portfolio)
+{
+    yo::Portfolio book;
+    book.reserve(n);
+    for (const auto& p : batch(true)) book.add(p, 1.0);
+    std::vector<std::uint8_t> faults(n);
+    std::size_t invalid = 0;
+    state.run(n, [&]{ invalid = yu::validate_batch(book, faults); });
+    check_invalid(invalid, n_invalid);
+}
+
+// --- Pricing ---
+BENCHMARK_CASE(validation_BSEngine_price_clean)
+{
+    ye::BSEngine bs_engine;
+    const auto clean = batch(false);
+    std::vector<double> out(n);
+    state.run(n, [&]{ bs_engine.price(clean, out); });
+}
+
+BENCHMARK_CASE(validation_BSEngine_price_checked_clean)
+{
+    ye::BSEngine bs_engine;
+    const auto clean = batch(false);
+    std::vector<double> out(n);
+    std::size_t invalid = 0;
+    state.run(n, [&]{ invalid = bs_engine.price(clean, out, yu::InvalidRows::NaN); });
+    check_invalid(invalid, 0);
+}
+
+BENCHMARK_CASE(validation_BSEngine_price_checked_dirty)
+{
+    ye::BSEngine bs_engine;
+    const auto dirty = batch(true);
+    std::vector<double> out(n);
+    std::size_t invalid = 0;
+    state.run(n, [&]{ invalid = bs_engine.price(dirty, out, yu::InvalidRows::NaN); });
+    check_invalid(invalid, n_invalid);
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (yb::failures(yb::run_all_benchmarks(yb::parse_options(argc, argv))) > 0) return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+// Compilation command (from 01_Exact_Pricing_Methods/benchmarks):
+//   g++-15 -std=c++20 -O3 -march=native -I /opt/homebrew/opt/boost/include
+//       ../src/engines/*.cpp ../src/options/*.cpp ../src/util/*.cpp
+//       bench_validation.cpp -o bench_validation
@@ -0,0 +1,129 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |         ADEngineGreeks          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This header defines an engine computing
+                            the Greeks by forward-mode automatic
+                            differentiation (dual numbers, see
+                            util/dual.hpp). It works with any engine
+                            whose price_kernel() is generic over the
+                            scalar type (BSEngine,
+                            PerpetualAmericanEngine, ...) and gives
+                            exact derivatives, unlike the finite
+                            differences of NumericalEngineGreeks:
+                            no step size h to tune and no
+                            truncation / cancellation trade-off.
+*/
+
+#ifndef ADEngineGreeks_hpp
+#define ADEngineGreeks_hpp
+
+#include <vector>
+#include "../options/Option.hpp"
+#include "../util/dual.hpp"
+#include "EngineConcepts.hpp"
+#include "IGreeks.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Price and all first-order sensitivities of one config
+        // (partial derivatives: e.g. rho holds cost_of_carry fixed,
+        //  for stocks with b = r the total rate sensitivity is rho + carry)
+        struct Sensitivities
+        {
+            double price{};
+            double delta{};   // dV/dS
+            double dstrike{}; // dV/dK
+            double rho{};     // dV/dr
+            double carry{};   // dV/db
+            double vega{};    // dV/dsigma
+            double theta{};   // -dV/dT (time decay)
+        };
+
+        // ADScalar: one dual number carrying the 6 tangents (S, K, r, b, sigma, T)
+        using ADScalar = util::Dual<double, 6>;
+
+        // ADKernel: engines whose kernel can be evaluated on dual numbers
+        template<typename Engine>
+        concept ADKernel = PricingKernel<Engine, ADScalar>;
+
+        // Forward-mode AD Greeks Engine
+        template<typename Engine> requires ADKernel<Engine>
+        class ADEngineGreeks : public IGreeks
+        {
+        private:
+            // --- Member variables ---
+            const Engine& pricer_;
+
+        public:
+            // --- Constructor & Destructor ---
+            explicit ADEngineGreeks(const Engine& pricer) : pricer_(pricer) {}
+            virtual ~ADEngineGreeks() = default;
+
+            // --- Greeks Implementations ---
+            using IGreeks::delta; // bring base class overloads into scope
+            using IGreeks::gamma; // bring base class overloads into scope
+
+            // --- delta(): one tangent (S) only
+            double delta(const option::OptionParams& p) const override
+            {
+                using D1 = util::Dual<double, 1>;
+                option::BasicOptionParams<D1> q = seed<D1>(p);
+                q.asset_price = D1::variable(p.asset_price, 0);
+                return pricer_.price_kernel(q).d[0];
+            }
+
+            // --- gamma(): nested duals (dual of a dual) give the second derivative in S
+            double gamma(const option::OptionParams& p) const override
+            {
+                using D1 = util::Dual<double, 1>;
+                using D2 = util::Dual<D1, 1>;
+                option::BasicOptionParams<D2> q = seed<D2>(p);
+                // S with tangent 1 at both levels: value.v = V, d[0].d[0] = d2V/dS2
+                q.asset_price = D2{ D1::variable(p.asset_price, 0), { D1{ 1.0 } } };
+                return pricer_.price_kernel(q).d[0].d[0];
+            }
+
+            // --- sensitivities(): price + every first-order sensitivity in a single pass
+            Sensitivities sensitivities(const option::OptionParams& p) const
+            {
+                option::BasicOptionParams<ADScalar> q{
+                    ADScalar::variable(p.asset_price, 0),
+                    ADScalar::variable(p.strike_price, 1),
+                    ADScalar::variable(p.r, 2),
+                    ADScalar::variable(p.cost_of_carry, 3),
+                    ADScalar::variable(p.volatility, 4),
+                    ADScalar::variable(p.exercise_time, 5),
+                    p.option_type };
+
+                ADScalar V = pricer_.price_kernel(q);
+                return Sensitivities{ V.v, V.d[0], V.d[1], V.d[2], V.d[3], V.d[4], -V.d[5] };
+            }
+
+            // overload for sweep_1d(.)
+            std::vector<Sensitivities> sensitivities(const std::vector<option::OptionParams>& batch) const
+            {
+                std::vector<Sensitivities> out;
+                out.reserve(batch.size());
+                for (const auto& p : batch) out.push_back(sensitivities(p));
+                return out;
+            }
+
+        private:
+            // seed(): promote every field to a constant of the dual type
+            template<typename D>
+            static option::BasicOptionParams<D> seed(const option::OptionParams& p)
+            {
+                return option::BasicOptionParams<D>{ D{ p.asset_price }, D{ p.strike_price }, D{ p.r },
+                                                     D{ p.cost_of_carry }, D{ p.volatility },
+                                                     D{ p.exercise_time }, p.option_type };
+            }
+        };
+    }
+}
+
+#endif // ADEngineGreeks_hpp
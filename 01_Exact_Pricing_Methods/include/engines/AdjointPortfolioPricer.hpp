@@ -0,0 +1,82 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |      AdjointPortfolioPricer     |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object prices a portfolio of
+                            European options with the Black-Scholes
+                            kernel on active numbers (util::AReal)
+                            and returns the gradient of the portfolio
+                            value with respect to every input of every
+                            position, plus the shared market inputs
+                            (a parallel shift of r and, optionally,
+                            every node of a vol surface), from the
+                            backward sweep of the tape (AAD).
+*/
+
+#ifndef AdjointPortfolioPricer_hpp
+#define AdjointPortfolioPricer_hpp
+
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "../util/grid2d.hpp"
+#include "../util/vol_surface.hpp"
+#include "BSEngine.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Gradient of the portfolio value w.r.t. the inputs of one position
+        // (already multiplied by the quantity of the position)
+        struct PositionGradient
+        {
+            double dS{};
+            double dK{};
+            double dr{};
+            double db{};
+            double dsigma{}; // w.r.t. the position vol (the interpolated vol if a surface is used)
+            double dT{};
+        };
+
+        // Result of the adjoint pricing of a portfolio
+        struct AdjointRisk
+        {
+            double value{};                           // sum of quantity * price
+            std::vector<PositionGradient> positions;  // one per position
+            double rate{};                            // dV/dr for a parallel shift of every r
+            double carry{};                           // dV/db for a parallel shift of every b
+            util::Grid2D<double> vol_surface;         // dV/d(node vol), empty without surface
+        };
+
+        // Adjoint (reverse-mode AAD) portfolio pricer
+        class AdjointPortfolioPricer
+        {
+        private:
+            // --- Member variables ---
+            BSEngine engine_;  // its price_kernel is generic over the scalar type
+            bool checkpoint_;  // sweep and rewind the tape after every position
+
+        public:
+            // --- Constructor & Destructor ---
+            // checkpoint = true keeps the tape at the size of one position (bounded memory),
+            // checkpoint = false records the whole book and runs a single backward sweep;
+            // both give the same gradient
+            explicit AdjointPortfolioPricer(bool checkpoint = true) : checkpoint_(checkpoint) {}
+            ~AdjointPortfolioPricer() = default;
+
+            // --- Risk ---
+            // risk(): value and full gradient of sum_i quantities[i] * price(positions[i])
+            // if surface is not null, the vol of every position is interpolated on it
+            // (at its strike and expiry) instead of read from the params
+            // throws std::invalid_argument if positions and quantities differ in size
+            AdjointRisk risk(std::span<const option::OptionParams> positions,
+                             std::span<const double> quantities,
+                             const util::VolSurface* surface = nullptr) const;
+        };
+    }
+}
+
+#endif // AdjointPortfolioPricer_hpp
@@ -14,34 +14,37 @@
 
 #include "../options/Option.hpp"
 #include "IGreeks.hpp"
+#include "EngineConcepts.hpp"
+#include "Kernels.hpp"
 
 namespace yvan
 {
     namespace engine
     {
         // Black and Scholes Greeks Engine
-        class BSEngineGreeks : public IGreeks
+        class BSEngineGreeks final : public KernelGreeks<BSEngineGreeks>
         {
-        private:
-            // --- Internal Helpers ---
-            // d1 and d2 calculations
-            double d1(const option::OptionParams& p) const;
-            double d2(const option::OptionParams& p) const;
-
         public:
             // --- Constructor & Destructor ---
             BSEngineGreeks() = default;
             virtual ~BSEngineGreeks() = default;
 
             // --- Greeks Implementations ---
-            using IGreeks::delta; // bring base class overloads into scope
-            using IGreeks::gamma; // bring base class overloads into scope
+            using KernelGreeks<BSEngineGreeks>::delta; // bring base class overloads into scope
+            using KernelGreeks<BSEngineGreeks>::gamma; // bring base class overloads into scope
             
             // --- delta()
             double delta(const option::OptionParams& p) const override;
 
             // --- gamma()
             double gamma(const option::OptionParams& p) const override;
+
+            // --- non-virtual kernels used by the batch algorithms (inlined into their loops)
+            // generic over the floating type (double, float, ...)
+            template<typename Real>
+            Real delta_kernel(const option::BasicOptionParams<Real>& p) const { return kernels::bs_delta(p); }
+            template<typename Real>
+            Real gamma_kernel(const option::BasicOptionParams<Real>& p) const { return kernels::bs_gamma(p); }
         };
     }
 }
@@ -0,0 +1,60 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        CachedGreeks Class       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object is a decorator around any
+                            IGreeks: delta and gamma are memoized
+                            in two independent util::PricingCache.
+*/
+
+#ifndef CachedGreeks_hpp
+#define CachedGreeks_hpp
+
+#include <cstdint>
+#include "../options/Option.hpp"
+#include "../util/pricing_cache.hpp"
+#include "IGreeks.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Memoizing decorator for greeks engines
+        class CachedGreeks : public IGreeks
+        {
+        private:
+            // --- Member variables ---
+            const IGreeks& greeks_;                   // wrapped engine (must outlive the decorator)
+            mutable util::PricingCache delta_cache_;
+            mutable util::PricingCache gamma_cache_;
+
+        public:
+            // --- Constructor & Destructor ---
+            CachedGreeks(const IGreeks& greeks, std::size_t capacity = 4096, std::size_t n_shards = 16) :
+                greeks_(greeks), delta_cache_(capacity, n_shards), gamma_cache_(capacity, n_shards) {}
+            virtual ~CachedGreeks() = default;
+
+            // --- Greeks Implementations ---
+            using IGreeks::delta; // bring base class overloads into scope
+            using IGreeks::gamma; // bring base class overloads into scope
+
+            // --- delta()
+            double delta(const option::OptionParams& p) const override;
+
+            // --- gamma()
+            double gamma(const option::OptionParams& p) const override;
+
+            // --- Cache Statistics ---
+            // hits() and misses() are summed over the two caches
+            std::uint64_t hits() const { return delta_cache_.hits() + gamma_cache_.hits(); }
+            std::uint64_t misses() const { return delta_cache_.misses() + gamma_cache_.misses(); }
+            const util::PricingCache& delta_cache() const noexcept { return delta_cache_; }
+            const util::PricingCache& gamma_cache() const noexcept { return gamma_cache_; }
+            void clear() { delta_cache_.clear(); gamma_cache_.clear(); }
+        };
+    }
+}
+
+#endif // CachedGreeks_hpp
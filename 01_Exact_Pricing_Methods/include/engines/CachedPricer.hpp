@@ -0,0 +1,53 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        CachedPricer Class       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object is a decorator around any
+                            IPricer: prices are memoized in a
+                            util::PricingCache so that duplicated
+                            OptionParams in a request stream are
+                            only priced once.
+*/
+
+#ifndef CachedPricer_hpp
+#define CachedPricer_hpp
+
+#include <cstdint>
+#include "../options/Option.hpp"
+#include "../util/pricing_cache.hpp"
+#include "IPricer.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Memoizing decorator for pricing engines
+        class CachedPricer : public IPricer
+        {
+        private:
+            // --- Member variables ---
+            const IPricer& pricer_;              // wrapped engine (must outlive the decorator)
+            mutable util::PricingCache cache_;   // mutable: caching is not an observable state change
+
+        public:
+            // --- Constructor & Destructor ---
+            CachedPricer(const IPricer& pricer, std::size_t capacity = 4096, std::size_t n_shards = 16) :
+                pricer_(pricer), cache_(capacity, n_shards) {}
+            virtual ~CachedPricer() = default;
+
+            // --- Price ---
+            using IPricer::price; // bring base class overloads into scope (they route through the cache)
+            double price(const option::OptionParams& params) const override;
+
+            // --- Cache Statistics ---
+            std::uint64_t hits() const { return cache_.hits(); }
+            std::uint64_t misses() const { return cache_.misses(); }
+            const util::PricingCache& cache() const noexcept { return cache_; }
+            void clear() { cache_.clear(); }
+        };
+    }
+}
+
+#endif // CachedPricer_hpp
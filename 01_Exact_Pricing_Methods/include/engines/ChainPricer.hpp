@@ -0,0 +1,72 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |           ChainPricer           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object prices option chains with
+                            the Black-Scholes formula. The options of
+                            a chain share (S, T, r, b): the batch is
+                            grouped on that key, the maturity work
+                            (sqrt(T), e^-rT, e^(b-r)T and log(F)) is
+                            done once per group, and the strikes of a
+                            group run through a branch-free loop
+                            (d1 / d2 for a block of strikes, then the
+                            normal CDFs) that the compiler can
+                            vectorize when vector math is available.
+*/
+
+#ifndef ChainPricer_hpp
+#define ChainPricer_hpp
+
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "IPricer.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Work shared by the options of one (S, T, r, b) group
+        struct ChainFactors
+        {
+            double sqrt_t{};
+            double df{};       // e^(-rT)
+            double fwd_df{};   // S e^((b-r)T) = df * F
+            double log_fwd{};  // log(F) = log(S) + bT
+
+            static ChainFactors make(double S, double T, double r, double b);
+        };
+
+        class ChainPricer final : public IPricer
+        {
+        public:
+            // strikes per block of the inner loop
+            static constexpr std::size_t block_size = 64;
+
+            // --- Constructor & Destructor ---
+            ChainPricer() = default;
+            virtual ~ChainPricer() = default;
+
+            // --- Price ---
+            using IPricer::price; // bring base class overloads into scope
+            double price(const option::OptionParams& p) const override;
+            std::vector<double> price(const std::vector<option::OptionParams>& batch) const override;
+            // groups the batch by (S, T, r, b) (a batch already sorted by key is not re-sorted)
+            void price(std::span<const option::OptionParams> batch, std::span<double> out) const override;
+
+            // --- Chain API ---
+            // price_chain(): the options of one group given as columns
+            // (common holds S, T, r, b; its strike / vol / type are ignored)
+            // throws std::invalid_argument if the column sizes differ
+            static void price_chain(const option::OptionParams& common,
+                                    std::span<const double> strikes,
+                                    std::span<const double> vols,
+                                    std::span<const option::OptionType> types,
+                                    std::span<double> out);
+        };
+    }
+}
+
+#endif // ChainPricer_hpp
@@ -0,0 +1,83 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          CurveBSEngine          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object is a Black-Scholes engine
+                            reading the rates from term structures
+                            instead of the flat r and cost_of_carry
+                            of OptionParams: a discount curve (e^-rT)
+                            and a dividend / carry curve (e^(b-r)T,
+                            i.e. e^-qT for a dividend yield q).
+
+                            One engine is meant per underlying: the
+                            factors of its listed maturities are
+                            precomputed once (prepare()), and the
+                            batch overloads reuse the factors of the
+                            previous option while the maturity does
+                            not change, so the options of a chain
+                            cost one log and two N each (no exp and
+                            no curve lookup).
+*/
+
+#ifndef CurveBSEngine_hpp
+#define CurveBSEngine_hpp
+
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "../util/curve.hpp"
+#include "IPricer.hpp"
+#include "Kernels.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        class CurveBSEngine final : public IPricer
+        {
+        public:
+            using Factors = kernels::MaturityFactors<double>;
+
+        private:
+            // --- Member variables ---
+            util::DiscountCurve discount_; // e^(-rT)
+            util::DiscountCurve dividend_; // e^((b-r)T)
+            std::vector<Factors> cache_;   // precomputed maturities, sorted by exercise_time
+
+        public:
+            // --- Constructor & Destructor ---
+            // maturities: listed expiries of the underlying, precomputed right away
+            CurveBSEngine(util::DiscountCurve discount, util::DiscountCurve dividend = util::DiscountCurve{},
+                          std::span<const double> maturities = {});
+            virtual ~CurveBSEngine() = default;
+
+            // --- Price ---
+            // p.r and p.cost_of_carry are ignored (read from the curves)
+            using IPricer::price; // bring base class overloads into scope
+            double price(const option::OptionParams& p) const override;
+            std::vector<double> price(const std::vector<option::OptionParams>& batch) const override;
+            void price(std::span<const option::OptionParams> batch, std::span<double> out) const override;
+
+            // --- Curves ---
+            // prepare(): precompute the factors of more maturities
+            // (not thread-safe against concurrent pricing: call it while setting the engine up)
+            void prepare(std::span<const double> maturities);
+            // factors(): maturity factors (from the cache when T was prepared)
+            Factors factors(double T) const;
+            // flat_params(): params with the flat r, b equivalent to the curves at p.exercise_time
+            option::OptionParams flat_params(const option::OptionParams& p) const;
+
+            // --- Getters ---
+            const util::DiscountCurve& discount_curve() const noexcept { return discount_; }
+            const util::DiscountCurve& dividend_curve() const noexcept { return dividend_; }
+            std::size_t cached_maturities() const noexcept { return cache_.size(); }
+
+        private:
+            Factors compute_factors(double T) const;
+        };
+    }
+}
+
+#endif // CurveBSEngine_hpp
@@ -0,0 +1,274 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        EngineConcepts.hpp       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This header defines the compile-time
+                            (devirtualized) path of the engines:
+                                - C++20 concepts describing a
+                                  pricing / greeks kernel
+                                - generic price_batch(.) and
+                                  greeks_batch(.) algorithms
+                                - CRTP bases that implement the
+                                  IPricer / IGreeks batch overloads
+                                  with those algorithms
+                            The batch loops call the non-virtual
+                            *_kernel() member of the concrete engine,
+                            so the kernel can be inlined into the loop.
+                            IPricer / IGreeks stay the type-erased
+                            front-end for runtime polymorphism.
+*/
+
+#ifndef EngineConcepts_hpp
+#define EngineConcepts_hpp
+
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../options/Option.hpp"
+#include "../util/grid2d.hpp"
+#include "../util/instrumentation.hpp"
+#include "IPricer.hpp"
+#include "IGreeks.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // --- Concepts ---
+        // PricingKernel: exposes a non-virtual price_kernel(params) -> Real
+        // (Real defaults to double; engines with templated kernels also model
+        // PricingKernel<Engine, float>)
+        template<typename Engine, typename Real = double>
+        concept PricingKernel = requires(const Engine& e, const option::BasicOptionParams<Real>& p)
+        {
+            { e.price_kernel(p) } -> std::convertible_to<Real>;
+        };
+
+        // GreeksKernel: exposes non-virtual delta_kernel(params) and gamma_kernel(params)
+        template<typename Engine, typename Real = double>
+        concept GreeksKernel = requires(const Engine& e, const option::BasicOptionParams<Real>& p)
+        {
+            { e.delta_kernel(p) } -> std::convertible_to<Real>;
+            { e.gamma_kernel(p) } -> std::convertible_to<Real>;
+        };
+
+        // --- Generic Batch Algorithms ---
+        // All algorithms are generic over the floating type Real of the params
+        // (OptionParams -> double results, OptionParamsF -> float results).
+        // The span overloads write into caller-provided buffers and never allocate
+        // (the callers are responsible for out.size() == batch.size()).
+
+        // price_batch(): into a caller-provided buffer
+        template<typename Engine, typename Real> requires PricingKernel<Engine, Real>
+        void price_batch(const Engine& engine, std::span<const option::BasicOptionParams<Real>> batch, std::span<Real> out)
+        {
+            YVAN_PROBE_TIME(price_batch, batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) out[i] = engine.price_kernel(batch[i]);
+        }
+
+        // delta_batch() / gamma_batch(): into a caller-provided buffer
+        template<typename Engine, typename Real> requires GreeksKernel<Engine, Real>
+        void delta_batch(const Engine& engine, std::span<const option::BasicOptionParams<Real>> batch, std::span<Real> out)
+        {
+            YVAN_PROBE_TIME(delta_batch, batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) out[i] = engine.delta_kernel(batch[i]);
+        }
+        template<typename Engine, typename Real> requires GreeksKernel<Engine, Real>
+        void gamma_batch(const Engine& engine, std::span<const option::BasicOptionParams<Real>> batch, std::span<Real> out)
+        {
+            YVAN_PROBE_TIME(gamma_batch, batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) out[i] = engine.gamma_kernel(batch[i]);
+        }
+
+        // price_batch(): overload for util::sweep_1d()
+        template<typename Engine, typename Real> requires PricingKernel<Engine, Real>
+        std::vector<Real>
+        price_batch(const Engine& engine, const std::vector<option::BasicOptionParams<Real>>& batch)
+        {
+            std::vector<Real> out(batch.size());
+            price_batch(engine, std::span<const option::BasicOptionParams<Real>>(batch), std::span<Real>(out));
+            return out;
+        }
+
+        // price_batch(): overload for util::sweep_2d() (flat loop over the row-major storage)
+        template<typename Engine, typename Real> requires PricingKernel<Engine, Real>
+        util::Grid2D<Real>
+        price_batch(const Engine& engine, const util::Grid2D<option::BasicOptionParams<Real>>& grid)
+        {
+            util::Grid2D<Real> out(grid.nrows, grid.ncols);
+            price_batch(engine, std::span<const option::BasicOptionParams<Real>>(grid.data), std::span<Real>(out.data));
+            return out;
+        }
+
+        // Greeks of a whole batch computed in a single pass
+        struct GreeksBatch
+        {
+            std::vector<double> delta;
+            std::vector<double> gamma;
+        };
+
+        // delta_batch() / gamma_batch(): one greek over a batch
+        template<typename Engine, typename Real> requires GreeksKernel<Engine, Real>
+        std::vector<Real>
+        delta_batch(const Engine& engine, const std::vector<option::BasicOptionParams<Real>>& batch)
+        {
+            std::vector<Real> out(batch.size());
+            delta_batch(engine, std::span<const option::BasicOptionParams<Real>>(batch), std::span<Real>(out));
+            return out;
+        }
+        template<typename Engine, typename Real> requires GreeksKernel<Engine, Real>
+        std::vector<Real>
+        gamma_batch(const Engine& engine, const std::vector<option::BasicOptionParams<Real>>& batch)
+        {
+            std::vector<Real> out(batch.size());
+            gamma_batch(engine, std::span<const option::BasicOptionParams<Real>>(batch), std::span<Real>(out));
+            return out;
+        }
+        template<typename Engine, typename Real> requires GreeksKernel<Engine, Real>
+        util::Grid2D<Real>
+        delta_batch(const Engine& engine, const util::Grid2D<option::BasicOptionParams<Real>>& grid)
+        {
+            util::Grid2D<Real> out(grid.nrows, grid.ncols);
+            delta_batch(engine, std::span<const option::BasicOptionParams<Real>>(grid.data), std::span<Real>(out.data));
+            return out;
+        }
+        template<typename Engine, typename Real> requires GreeksKernel<Engine, Real>
+        util::Grid2D<Real>
+        gamma_batch(const Engine& engine, const util::Grid2D<option::BasicOptionParams<Real>>& grid)
+        {
+            util::Grid2D<Real> out(grid.nrows, grid.ncols);
+            gamma_batch(engine, std::span<const option::BasicOptionParams<Real>>(grid.data), std::span<Real>(out.data));
+            return out;
+        }
+
+        // greeks_batch(): delta and gamma of every config in one loop
+        template<GreeksKernel Engine>
+        GreeksBatch
+        greeks_batch(const Engine& engine, const std::vector<option::OptionParams>& batch)
+        {
+            YVAN_PROBE_TIME(delta_batch, batch.size());
+            YVAN_PROBE_TIME(gamma_batch, batch.size());
+            GreeksBatch out{ std::vector<double>(batch.size()), std::vector<double>(batch.size()) };
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                out.delta[i] = engine.delta_kernel(batch[i]);
+                out.gamma[i] = engine.gamma_kernel(batch[i]);
+            }
+            return out;
+        }
+
+        // --- Mixed Precision ---
+        // price_batch_mixed(): double params in, double prices out, float arithmetic inside.
+        // The params are narrowed chunk by chunk into a small stack buffer so the float
+        // kernel loop runs on contiguous float data (no heap allocation).
+        // Accuracy: see the error bound documented in BSEngine.hpp.
+        template<typename Engine> requires PricingKernel<Engine, float>
+        void price_batch_mixed(const Engine& engine, std::span<const option::OptionParams> batch, std::span<double> out)
+        {
+            YVAN_PROBE_TIME(price_batch, batch.size());
+            constexpr std::size_t chunk = 256;
+            option::OptionParamsF params_f[chunk];
+            float prices_f[chunk];
+            for (std::size_t start = 0; start < batch.size(); start += chunk)
+            {
+                const std::size_t n = (batch.size() - start < chunk) ? batch.size() - start : chunk;
+                for (std::size_t i = 0; i < n; ++i) params_f[i] = option::params_cast<float>(batch[start + i]);
+                for (std::size_t i = 0; i < n; ++i) prices_f[i] = engine.price_kernel(params_f[i]); // (one probe for the batch)
+                for (std::size_t i = 0; i < n; ++i) out[start + i] = static_cast<double>(prices_f[i]);
+            }
+        }
+
+        // --- CRTP Bases ---
+        // KernelPricer: implements the IPricer batch overloads on top of Derived::price_kernel()
+        // so that a runtime caller holding an IPricer& pays one virtual call per batch
+        // instead of one per element (Derived still overrides the single config price())
+        template<typename Derived>
+        class KernelPricer : public IPricer
+        {
+        public:
+            using IPricer::price; // bring base class overloads into scope
+
+            // Overloaded price function for util::sweep_1d()
+            std::vector<double>
+            price(const std::vector<option::OptionParams>& batch) const override
+            {
+                return price_batch(derived(), batch);
+            }
+
+            // Overloaded price function for util::sweep_2d()
+            util::Grid2D<double>
+            price(const util::Grid2D<option::OptionParams>& grid) const override
+            {
+                return price_batch(derived(), grid);
+            }
+
+            // Output-parameter overloads (no heap allocation)
+            void
+            price(std::span<const option::OptionParams> batch, std::span<double> out) const override
+            {
+                if (out.size() != batch.size())
+                {
+                    throw std::invalid_argument("Output buffer size must match the batch size.");
+                }
+                price_batch(derived(), batch, out);
+            }
+
+        private:
+            const Derived& derived() const { return static_cast<const Derived&>(*this); }
+        };
+
+        // KernelGreeks: same idea for the IGreeks batch overloads on top of
+        // Derived::delta_kernel() / gamma_kernel()
+        template<typename Derived>
+        class KernelGreeks : public IGreeks
+        {
+        public:
+            using IGreeks::delta; // bring base class overloads into scope
+            using IGreeks::gamma; // bring base class overloads into scope
+
+            // --- delta()
+            std::vector<double>
+            delta(const std::vector<option::OptionParams>& batch) const override
+            {
+                return delta_batch(derived(), batch);
+            }
+            util::Grid2D<double>
+            delta(const util::Grid2D<option::OptionParams>& grid) override
+            {
+                return delta_batch(derived(), grid);
+            }
+            void
+            delta(std::span<const option::OptionParams> batch, std::span<double> out) const override
+            {
+                check_sizes(batch.size(), out.size());
+                delta_batch(derived(), batch, out);
+            }
+
+            // --- gamma()
+            std::vector<double>
+            gamma(const std::vector<option::OptionParams>& batch) const override
+            {
+                return gamma_batch(derived(), batch);
+            }
+            util::Grid2D<double>
+            gamma(const util::Grid2D<option::OptionParams>& grid) override
+            {
+                return gamma_batch(derived(), grid);
+            }
+            void
+            gamma(std::span<const option::OptionParams> batch, std::span<double> out) const override
+            {
+                check_sizes(batch.size(), out.size());
+                gamma_batch(derived(), batch, out);
+            }
+
+        private:
+            const Derived& derived() const { return static_cast<const Derived&>(*this); }
+        };
+    }
+}
+
+#endif // EngineConcepts_hpp
@@ -16,11 +16,16 @@
 #ifndef IGreeks_hpp
 #define IGreeks_hpp
 
+#include <cstdint>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include "../options/Option.hpp"
 #include "../util/distributions.hpp"
 #include "../util/grid2d.hpp"
+#include "../util/instrumentation.hpp"
 #include "../util/param_grid.hpp"
+#include "../util/validation.hpp"
 
 
 namespace yvan
@@ -44,6 +49,8 @@ namespace yvan
             virtual std::vector<double>
             delta(const std::vector<option::OptionParams>& bacthes) const
             {
+                YVAN_PROBE_TIME(delta_batch, bacthes.size());
+
                 // init vector
                 std::vector<double> out;
                 out.reserve(bacthes.size());
@@ -66,6 +73,8 @@ namespace yvan
             virtual util::Grid2D<double>
             delta(const util::Grid2D<option::OptionParams>& grid)
             {
+                YVAN_PROBE_TIME(delta_batch, grid.data.size());
+
                 // create the grid (init to 0.0)
                 util::Grid2D<double> out(grid.nrows, grid.ncols);
 
@@ -82,6 +91,24 @@ namespace yvan
                 return out;
             }
 
+            // output-parameter overload for sweep_1d(.) (no heap allocation)
+            // throws std::invalid_argument if out.size() != batch.size()
+            virtual void
+            delta(std::span<const option::OptionParams> batch, std::span<double> out) const
+            {
+                check_sizes(batch.size(), out.size());
+                YVAN_PROBE_TIME(delta_batch, batch.size());
+                for (std::size_t i = 0; i < batch.size(); ++i) out[i] = delta(batch[i]);
+            }
+
+            // output-parameter overload for sweep_2d(.) (out must be pre-sized)
+            virtual void
+            delta(const util::Grid2D<option::OptionParams>& grid, util::Grid2D<double>& out) const
+            {
+                check_dims(grid, out);
+                delta(std::span<const option::OptionParams>(grid.data), std::span<double>(out.data));
+            }
+
             // --- gamma
             // basic 
             virtual double gamma(const option::OptionParams& params) const = 0;
@@ -90,6 +117,8 @@ namespace yvan
             virtual std::vector<double>
             gamma(const std::vector<option::OptionParams>& bacthes) const
             {
+                YVAN_PROBE_TIME(gamma_batch, bacthes.size());
+
                 // init vector
                 std::vector<double> out;
                 out.reserve(bacthes.size());
@@ -112,6 +141,8 @@ namespace yvan
             virtual util::Grid2D<double>
             gamma(const util::Grid2D<option::OptionParams>& grid)
             {
+                YVAN_PROBE_TIME(gamma_batch, grid.data.size());
+
                 // create the grid (init to 0.0)
                 util::Grid2D<double> out(grid.nrows, grid.ncols);
 
@@ -128,8 +159,61 @@ namespace yvan
                 return out;
             }
 
+            // output-parameter overload for sweep_1d(.) (no heap allocation)
+            // throws std::invalid_argument if out.size() != batch.size()
+            virtual void
+            gamma(std::span<const option::OptionParams> batch, std::span<double> out) const
+            {
+                check_sizes(batch.size(), out.size());
+                YVAN_PROBE_TIME(gamma_batch, batch.size());
+                for (std::size_t i = 0; i < batch.size(); ++i) out[i] = gamma(batch[i]);
+            }
+
+            // output-parameter overload for sweep_2d(.) (out must be pre-sized)
+            virtual void
+            gamma(const util::Grid2D<option::OptionParams>& grid, util::Grid2D<double>& out) const
+            {
+                check_dims(grid, out);
+                gamma(std::span<const option::OptionParams>(grid.data), std::span<double>(out.data));
+            }
 
-    
+            // --- Batches With Invalid Rows (no exception for a bad row) ---
+            // delta() / gamma(): the valid rows in one call of the span overload, the
+            // invalid ones NaN-filled or skipped (see util::evaluate_valid)
+            // faults, if not empty, receives the fault bits of every row (util::fault)
+            // return the number of invalid rows
+            std::size_t
+            delta(std::span<const option::OptionParams> batch, std::span<double> out,
+                  util::InvalidRows invalid, std::span<std::uint8_t> faults = {}) const
+            {
+                return util::evaluate_valid(batch, out, invalid, faults,
+                    [this](std::span<const option::OptionParams> b, std::span<double> o) { delta(b, o); });
+            }
+
+            std::size_t
+            gamma(std::span<const option::OptionParams> batch, std::span<double> out,
+                  util::InvalidRows invalid, std::span<std::uint8_t> faults = {}) const
+            {
+                return util::evaluate_valid(batch, out, invalid, faults,
+                    [this](std::span<const option::OptionParams> b, std::span<double> o) { gamma(b, o); });
+            }
+
+        protected:
+            // --- Buffer Checks for the output-parameter overloads ---
+            static void check_sizes(std::size_t n_batch, std::size_t n_out)
+            {
+                if (n_out != n_batch)
+                {
+                    throw std::invalid_argument("Output buffer size must match the batch size.");
+                }
+            }
+            static void check_dims(const util::Grid2D<option::OptionParams>& grid, const util::Grid2D<double>& out)
+            {
+                if (out.nrows != grid.nrows || out.ncols != grid.ncols || out.data.size() != grid.data.size())
+                {
+                    throw std::invalid_argument("Output grid must have the dimensions of the parameter grid.");
+                }
+            }
         };
     }
 }
@@ -17,6 +17,11 @@
 
 #include "../options/Option.hpp"
 #include "../util/grid2d.hpp"
+#include "../util/instrumentation.hpp"
+#include "../util/validation.hpp"
+#include <cstdint>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace yvan
@@ -39,6 +44,8 @@ namespace yvan
             virtual std::vector<double>
             price(const std::vector<option::OptionParams>& batch) const
             {
+                YVAN_PROBE_TIME(price_batch, batch.size());
+
                 // init return vector
                 std::vector<double> out;
                 out.reserve(batch.size());
@@ -54,6 +61,8 @@ namespace yvan
             virtual util::Grid2D<double>
             price(const util::Grid2D<option::OptionParams>& grid) const
             {
+                YVAN_PROBE_TIME(price_batch, grid.data.size());
+
                 // init the return grid to 0.0 everywhere
                 util::Grid2D<double> out(grid.nrows,  grid.ncols);
 
@@ -69,6 +78,45 @@ namespace yvan
                 // return 
                 return out;
             }
+
+            // --- Output-Parameter Overloads (no heap allocation) ---
+            // Overloaded price function writing into a caller-provided buffer
+            // throws std::invalid_argument if out.size() != batch.size()
+            virtual void
+            price(std::span<const option::OptionParams> batch, std::span<double> out) const
+            {
+                if (out.size() != batch.size())
+                {
+                    throw std::invalid_argument("Output buffer size must match the batch size.");
+                }
+                YVAN_PROBE_TIME(price_batch, batch.size());
+                for (std::size_t i = 0; i < batch.size(); ++i) out[i] = price(batch[i]);
+            }
+
+            // Overloaded price function writing into a pre-sized grid
+            // throws std::invalid_argument if out does not have the dimensions of grid
+            virtual void
+            price(const util::Grid2D<option::OptionParams>& grid, util::Grid2D<double>& out) const
+            {
+                if (out.nrows != grid.nrows || out.ncols != grid.ncols || out.data.size() != grid.data.size())
+                {
+                    throw std::invalid_argument("Output grid must have the dimensions of the parameter grid.");
+                }
+                price(std::span<const option::OptionParams>(grid.data), std::span<double>(out.data));
+            }
+
+            // --- Batches With Invalid Rows (no exception for a bad row) ---
+            // price(): the valid rows of batch priced in one call of the span overload,
+            // the invalid ones NaN-filled or skipped (see util::evaluate_valid)
+            // faults, if not empty, receives the fault bits of every row (util::fault)
+            // returns the number of invalid rows
+            std::size_t
+            price(std::span<const option::OptionParams> batch, std::span<double> out,
+                  util::InvalidRows invalid, std::span<std::uint8_t> faults = {}) const
+            {
+                return util::evaluate_valid(batch, out, invalid, faults,
+                    [this](std::span<const option::OptionParams> b, std::span<double> o) { price(b, o); });
+            }
         };
     }
 }
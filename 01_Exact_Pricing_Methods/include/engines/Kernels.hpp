@@ -0,0 +1,159 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |           Kernels.hpp           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This header gathers the closed-form
+                            pricing kernels of the engines as inline
+                            free functions. Keeping them in a header
+                            lets the batch algorithms of
+                            EngineConcepts.hpp inline them into
+                            their loops, while the virtual
+                            IPricer/IGreeks functions simply
+                            forward to the same code.
+*/
+
+#ifndef Kernels_hpp
+#define Kernels_hpp
+
+#include <cmath>
+#include "../options/Option.hpp"
+#include "../util/distributions.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        namespace kernels
+        {
+            // All kernels are templated on the scalar type Real
+            // (double, float, or any user-defined scalar providing the usual
+            // arithmetic and log/exp/sqrt/erfc/pow by ADL). The math functions
+            // are therefore called unqualified after a using-declaration.
+
+            // --- Black and Scholes ---
+            // d1 and d2 calculations
+            template<typename Real>
+            inline Real bs_d1(const option::BasicOptionParams<Real>& p)
+            {
+                using std::log; using std::sqrt;
+                // Compute d1 using the Black-Scholes formula
+                Real num = log(p.asset_price / p.strike_price)
+                    + p.exercise_time * (p.cost_of_carry + (p.volatility * p.volatility) / Real(2));
+                Real den = p.volatility * sqrt(p.exercise_time);
+                return num / den;
+            }
+            template<typename Real>
+            inline Real bs_d2(const option::BasicOptionParams<Real>& p)
+            {
+                using std::sqrt;
+                return bs_d1(p) - p.volatility * sqrt(p.exercise_time);
+            }
+
+            // bs_price(): Black-Scholes price (Call or Put)
+            template<typename Real>
+            inline Real bs_price(const option::BasicOptionParams<Real>& p)
+            {
+                using std::exp;
+                // Compute d1 and d2
+                Real D1 = bs_d1(p);
+                Real D2 = bs_d2(p);
+
+                // Retrieve sign based on option type
+                Real sign = Real(static_cast<int>(p.option_type));
+
+                // Compute the Black-Scholes price (Call or Put)
+                Real df_r = exp(-p.r * p.exercise_time);
+                Real fwd_factor = exp((p.cost_of_carry - p.r) * p.exercise_time);
+                return sign * ( p.asset_price * fwd_factor * util::N(sign * D1)
+                            - p.strike_price * df_r * util::N(sign * D2) );
+            }
+
+            // bs_delta(): delta_c = e^((b-r)*T) * N(d1), delta_p = -e^((b-r)*T) * N(-d1)
+            template<typename Real>
+            inline Real bs_delta(const option::BasicOptionParams<Real>& p)
+            {
+                using std::exp;
+                Real sign = Real(static_cast<int>(p.option_type)); // := 1 for Call, := -1 for Put
+                return sign * exp((p.cost_of_carry - p.r) * p.exercise_time) * util::N(sign * bs_d1(p));
+            }
+
+            // bs_gamma(): same for both put and call
+            template<typename Real>
+            inline Real bs_gamma(const option::BasicOptionParams<Real>& p)
+            {
+                using std::exp; using std::sqrt;
+                Real num = util::n(bs_d1(p)) * exp((p.cost_of_carry - p.r) * p.exercise_time);
+                Real den = p.asset_price * p.volatility * sqrt(p.exercise_time);
+                return num / den;
+            }
+
+            // --- Black and Scholes on precomputed maturity factors ---
+            // everything that depends on the maturity only (shared by all the strikes
+            // of a chain), e.g. read from discount / dividend curves
+            template<typename Real>
+            struct MaturityFactors
+            {
+                Real exercise_time{};
+                Real sqrt_t{};      // sqrt(T)
+                Real df{};          // e^(-rT)
+                Real carry_df{};    // e^((b-r)T), e.g. the dividend discount factor e^(-qT)
+                Real log_growth{};  // bT = log(carry_df / df)
+            };
+
+            // bs_price_factors(): Black-Scholes price with d1 = (log(S/K) + bT + sigma^2 T / 2) / (sigma sqrt(T))
+            // (one log and two N per option, no exp). N is the erfc form, also for doubles
+            // (as in ChainPricer): the Boost CDF would cost more than the exps saved
+            template<typename Real>
+            inline Real bs_price_factors(Real S, Real K, Real sigma, option::OptionType type,
+                                         const MaturityFactors<Real>& f)
+            {
+                using std::log;
+                Real vol_sqrt_t = sigma * f.sqrt_t;
+                Real D1 = (log(S / K) + f.log_growth + vol_sqrt_t * vol_sqrt_t / Real(2)) / vol_sqrt_t;
+                Real D2 = D1 - vol_sqrt_t;
+
+                Real sign = Real(static_cast<int>(type));
+                return sign * ( S * f.carry_df * util::N<Real>(sign * D1)
+                            - K * f.df * util::N<Real>(sign * D2) );
+            }
+
+            // --- Perpetual American ---
+            // a1 and a2 calculations (roughly analogous to y1 and y2 but different)
+            template<typename Real>
+            inline Real pa_a1(const option::BasicOptionParams<Real>& p)
+            {
+                return Real(0.5) - (p.cost_of_carry / (p.volatility * p.volatility));
+            }
+            template<typename Real>
+            inline Real pa_a2(const option::BasicOptionParams<Real>& p)
+            {
+                using std::sqrt;
+                Real sigma_sq = (p.volatility * p.volatility);
+                Real m1 = ((p.cost_of_carry / sigma_sq) - Real(0.5));
+                Real m2 = Real(2) * p.r / sigma_sq;
+                return sqrt(m1 * m1 + m2);
+            }
+
+            // perpetual_american_price(): closed-form perpetual American price
+            template<typename Real>
+            inline Real perpetual_american_price(const option::BasicOptionParams<Real>& p)
+            {
+                using std::pow;
+                // retrieve the sign based on option type
+                Real sign = Real(static_cast<int>(p.option_type));
+
+                // y1 = a1 + a2 (call), y2 = a1 - a2 (put)
+                Real y = pa_a1(p) + sign * pa_a2(p);
+
+                // first and second members
+                Real m1 = p.strike_price / (sign * (y - Real(1)));
+                Real m2 = pow(((y - Real(1)) * p.asset_price) / (y * p.strike_price), y);
+                return m1 * m2;
+            }
+        }
+    }
+}
+
+#endif // Kernels_hpp
@@ -7,44 +7,103 @@
                             This header defines the engine for
                             computing the Greeks of options priced
                             using numerical methods (finite differences).
+                            It works with any pricer (IPricer) and can
+                            bump any field of OptionParams (vega, rho,
+                            theta, cross-gammas, ...). All the bumped
+                            configs of a request are priced in one
+                            batched call of the pricer, and delta and
+                            gamma share their evaluations.
 */
 
 #ifndef NumericalEngineGreeks_hpp
 #define NumericalEngineGreeks_hpp
 
+#include <span>
+#include <vector>
 #include "../options/Option.hpp"
 #include "IGreeks.hpp"
 #include "IPricer.hpp"
-#include "BSEngine.hpp"
 
 namespace yvan
 {
     namespace engine
     {
+        // Delta and gamma from the same three evaluations
+        struct DeltaGamma
+        {
+            double delta{};
+            double gamma{};
+        };
+
         class NumericalEngineGreeks : public IGreeks
         {
+        public:
+            // a bumpable input of the pricer (e.g. &option::OptionParams::volatility)
+            using Field = double option::OptionParams::*;
+
+            // number of configs per batched pricer call in the batch overloads
+            // (bounds the scratch memory to a few hundred KB)
+            static constexpr std::size_t chunk_size = 1024;
+
         private:
             // --- Member variables ---
-            const BSEngine& pricer_;
+            const IPricer& pricer_;
             double h_; // size of the step
 
         public:
             // --- Constructor & Destructor ---
             // default h = 0.01
-            NumericalEngineGreeks(const engine::BSEngine& pricer, double h = 0.01) :
+            NumericalEngineGreeks(const IPricer& pricer, double h = 0.01) :
                 pricer_(pricer), h_(h) {}
             virtual ~NumericalEngineGreeks() = default;
 
             // --- Overriden Greeks ---
-            // --- delta()
+            using IGreeks::delta; // bring base class overloads into scope
+            using IGreeks::gamma; // bring base class overloads into scope
+
+            // --- delta(): central difference in asset_price (2 evaluations)
             double delta(const option::OptionParams& p) const override;
 
-            // --- gamma()
+            // --- gamma(): second difference in asset_price (3 evaluations)
             double gamma(const option::OptionParams& p) const override;
 
-            
+            // batch overloads: all the bumped configs go through the pricer's batch call
+            std::vector<double> delta(const std::vector<option::OptionParams>& batch) const override;
+            std::vector<double> gamma(const std::vector<option::OptionParams>& batch) const override;
+            void delta(std::span<const option::OptionParams> batch, std::span<double> out) const override;
+            void gamma(std::span<const option::OptionParams> batch, std::span<double> out) const override;
+
+            // --- delta_and_gamma(): both from the same 3 evaluations (instead of 5)
+            DeltaGamma delta_and_gamma(const option::OptionParams& p) const;
+            // throws std::invalid_argument if an output size differs from the batch size
+            void delta_and_gamma(std::span<const option::OptionParams> batch,
+                                 std::span<double> delta_out, std::span<double> gamma_out) const;
+
+            // --- Any Input ---
+            // derivative(): dV/dx by central difference (e.g. vega with &OptionParams::volatility)
+            double derivative(const option::OptionParams& p, Field x) const { return derivative(p, x, h_); }
+            double derivative(const option::OptionParams& p, Field x, double h) const;
+
+            // second_derivative(): d2V/dx2 by second difference
+            double second_derivative(const option::OptionParams& p, Field x) const { return second_derivative(p, x, h_); }
+            double second_derivative(const option::OptionParams& p, Field x, double h) const;
+
+            // cross_derivative(): d2V/dxdy from the 4 corners (e.g. vanna with asset_price, volatility)
+            double cross_derivative(const option::OptionParams& p, Field x, Field y) const
+            {
+                return cross_derivative(p, x, y, h_, h_);
+            }
+            double cross_derivative(const option::OptionParams& p, Field x, Field y, double hx, double hy) const;
+
+            // batch versions (throw std::invalid_argument if out.size() != batch.size())
+            void derivative(std::span<const option::OptionParams> batch, Field x, std::span<double> out) const;
+            void second_derivative(std::span<const option::OptionParams> batch, Field x, std::span<double> out) const;
+
+            // --- Getters ---
+            double step() const noexcept { return h_; }
+            const IPricer& pricer() const noexcept { return pricer_; }
         };
     }
 }
 
-#endif // NumericalEngineGreeks_hpp
\ No newline at end of file
+#endif // NumericalEngineGreeks_hpp
@@ -0,0 +1,57 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          ParityPricer           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object is a decorator for European
+                            pricing engines. In a batch containing
+                            both the call and the put of the same
+                            config (same S, K, r, b, sigma, T), only
+                            one leg goes through the wrapped engine
+                            and the other one follows from put-call
+                            parity (util::call_minus_put), so a book
+                            of pairs costs about half the CDF
+                            evaluations. The out-of-the-money leg
+                            (w.r.t. the spot) is the one priced: the
+                            in-the-money leg is the larger one, so its
+                            parity derivation loses no relative
+                            precision.
+*/
+
+#ifndef ParityPricer_hpp
+#define ParityPricer_hpp
+
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "IPricer.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        class ParityPricer final : public IPricer
+        {
+        private:
+            // --- Member variables ---
+            const IPricer& pricer_; // European engine (must outlive the decorator)
+
+        public:
+            // --- Constructor & Destructor ---
+            explicit ParityPricer(const IPricer& pricer) : pricer_(pricer) {}
+            virtual ~ParityPricer() = default;
+
+            // --- Price ---
+            using IPricer::price; // bring base class overloads into scope
+            double price(const option::OptionParams& p) const override { return pricer_.price(p); }
+            std::vector<double> price(const std::vector<option::OptionParams>& batch) const override;
+            // pairs the calls and puts of the batch (the legs next to each other directly, as in
+            // a chain, the others by a hash join on every field but the type), prices the unpaired options and one leg of every pair in a single call of the
+            // wrapped engine, and derives the other legs from put-call parity
+            void price(std::span<const option::OptionParams> batch, std::span<double> out) const override;
+        };
+    }
+}
+
+#endif // ParityPricer_hpp
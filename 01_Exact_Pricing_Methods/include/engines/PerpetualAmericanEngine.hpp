@@ -14,29 +14,33 @@
 
 #include "../options/Option.hpp"
 #include "IPricer.hpp"
+#include "EngineConcepts.hpp"
+#include "Kernels.hpp"
 
 namespace yvan
 {
     namespace engine
     {
         // Perpetual American Option Engine
-        class PerpetualAmericanEngine : public IPricer
+        class PerpetualAmericanEngine final : public KernelPricer<PerpetualAmericanEngine>
         {
-        private:
-            // --- Internal Helpers ---
-            // a1 and a2 calculations (roughly analogous to y1 and y2 but different)
-            double a1(const option::OptionParams& p) const;
-            double a2(const option::OptionParams& p) const;
-
         public:
             // --- Constructor & Destructor ---
             PerpetualAmericanEngine() = default;
             virtual ~PerpetualAmericanEngine() = default;
 
             // --- Price ---
-            using IPricer::price; // bring base class overloads into scope
+            using KernelPricer<PerpetualAmericanEngine>::price; // bring base class overloads into scope
             // price function according to perpetual American option formula
             double price(const option::OptionParams& params) const override;
+
+            // non-virtual kernel used by the batch algorithms (inlined into their loops)
+            // generic over the floating type (double, float, ...)
+            template<typename Real>
+            Real price_kernel(const option::BasicOptionParams<Real>& params) const
+            {
+                return kernels::perpetual_american_price(params);
+            }
         };
     }
 }
@@ -0,0 +1,83 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |         PortfolioEngine         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object prices a Portfolio (SoA book)
+                            and aggregates its value, delta and gamma,
+                            in total and per bucket of expiry and of
+                            strike, in a single parallel reduction.
+
+                            The book is cut into chunks of a fixed
+                            size (independent of the thread count);
+                            every chunk is reduced with compensated
+                            (Neumaier) sums and the chunk partials are
+                            merged in chunk order. The result is
+                            therefore bit-identical whatever the
+                            number of threads.
+*/
+
+#ifndef PortfolioEngine_hpp
+#define PortfolioEngine_hpp
+
+#include <span>
+#include <vector>
+#include "../options/Portfolio.hpp"
+#include "../util/parallel.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Aggregated risk of a set of positions (quantity weighted)
+        struct RiskTotals
+        {
+            double value{};
+            double delta{};
+            double gamma{};
+        };
+
+        // Output of the aggregation
+        // n edges define n + 1 buckets: (-inf, e0), [e0, e1), ..., [e_{n-1}, +inf)
+        struct PortfolioRisk
+        {
+            RiskTotals total;
+            std::vector<double> expiry_edges;
+            std::vector<double> strike_edges;
+            std::vector<RiskTotals> by_expiry; // expiry_edges.size() + 1 buckets
+            std::vector<RiskTotals> by_strike; // strike_edges.size() + 1 buckets
+        };
+
+        class PortfolioEngine
+        {
+        private:
+            // --- Member variables ---
+            std::size_t n_threads_;
+            std::size_t chunk_size_; // positions per chunk (fixes the summation order)
+
+        public:
+            // --- Constructor & Destructor ---
+            explicit PortfolioEngine(std::size_t n_threads = util::default_thread_count(),
+                                     std::size_t chunk_size = 1024);
+            ~PortfolioEngine() = default;
+
+            // --- Aggregation ---
+            // aggregate(): value, delta and gamma of the book, in total and per bucket
+            // European positions use the Black-Scholes formulas, perpetual American
+            // positions their closed form (delta / gamma by nested dual numbers)
+            // throws std::invalid_argument if the edges are not strictly increasing
+            PortfolioRisk aggregate(const option::Portfolio& book,
+                                    std::span<const double> expiry_edges = {},
+                                    std::span<const double> strike_edges = {}) const;
+
+            // position_risk(): price, delta and gamma of one unit of a position
+            static RiskTotals position_risk(const option::OptionParams& p, option::OptionStyle style);
+
+            // bucket_of(): index of the bucket containing x
+            static std::size_t bucket_of(std::span<const double> edges, double x);
+        };
+    }
+}
+
+#endif // PortfolioEngine_hpp
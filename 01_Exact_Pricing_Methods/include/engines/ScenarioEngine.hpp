@@ -0,0 +1,109 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          ScenarioEngine         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object reprices a book of options
+                            under a set of market scenarios (spot,
+                            vol and rate shocks) with any pricer and
+                            returns the P&L of the book per scenario
+                            and its quantiles (VaR-style stress).
+
+                            The shocked params are generated lazily,
+                            one tile of (positions x scenarios) at a
+                            time, in a buffer small enough to stay in
+                            cache: the full positions x scenarios
+                            matrix is never materialized. Scenarios
+                            are split across threads; every scenario
+                            sums its positions in the same order, so
+                            the result does not depend on the number
+                            of threads.
+*/
+
+#ifndef ScenarioEngine_hpp
+#define ScenarioEngine_hpp
+
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "../util/parallel.hpp"
+#include "IPricer.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // One market scenario
+        struct Scenario
+        {
+            double spot_shock{}; // relative: S -> S * (1 + spot_shock)
+            double vol_shift{};  // absolute: sigma -> sigma + vol_shift (floored at min_volatility)
+            double rate_shift{}; // absolute: r -> r + rate_shift and b -> b + rate_shift (yield r - b kept)
+        };
+
+        // apply_scenario(): shocked copy of a position's params
+        option::OptionParams apply_scenario(const option::OptionParams& p, const Scenario& s);
+
+        // Output of a scenario run
+        struct ScenarioReport
+        {
+            double base_value{};               // value of the book without shock
+            std::vector<double> pnl;           // shocked value - base value, one per scenario
+            std::vector<double> probabilities; // requested levels
+            std::vector<double> quantiles;     // P&L quantile at each level
+        };
+
+        // quantile(): empirical quantile of a sample (linear interpolation between order statistics)
+        // throws std::invalid_argument if the sample is empty or prob is not in [0, 1]
+        double quantile(std::vector<double> sample, double prob);
+
+        // Scenario / stress engine
+        class ScenarioEngine
+        {
+        public:
+            static constexpr double min_volatility = 1e-6;
+
+        private:
+            // --- Member variables ---
+            const IPricer& pricer_;          // must be safe to call from several threads
+            std::size_t n_threads_;
+            std::size_t tile_positions_;
+            std::size_t tile_scenarios_;
+
+        public:
+            // --- Constructor & Destructor ---
+            // default tile: 64 positions x 32 scenarios (2048 params, ~115 KB per thread)
+            explicit ScenarioEngine(const IPricer& pricer,
+                                    std::size_t n_threads = util::default_thread_count(),
+                                    std::size_t tile_positions = 64,
+                                    std::size_t tile_scenarios = 32);
+            ~ScenarioEngine() = default;
+
+            // --- Scenario P&L ---
+            // pnl(): P&L of sum_i quantities[i] * price(positions[i]) under every scenario
+            // throws std::invalid_argument if positions and quantities differ in size
+            std::vector<double> pnl(std::span<const option::OptionParams> positions,
+                                    std::span<const double> quantities,
+                                    std::span<const Scenario> scenarios) const;
+
+            // run(): P&L vector + base value + quantiles at the requested levels
+            ScenarioReport run(std::span<const option::OptionParams> positions,
+                               std::span<const double> quantities,
+                               std::span<const Scenario> scenarios,
+                               std::span<const double> probabilities) const;
+
+            // --- Getters ---
+            std::size_t n_threads() const noexcept { return n_threads_; }
+
+        private:
+            // evaluate(): P&L per scenario, also returns the base value of the book
+            std::vector<double> evaluate(std::span<const option::OptionParams> positions,
+                                         std::span<const double> quantities,
+                                         std::span<const Scenario> scenarios,
+                                         double& base_value) const;
+        };
+    }
+}
+
+#endif // ScenarioEngine_hpp
@@ -0,0 +1,148 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |           TableEngine           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object answers price / delta / gamma
+                            queries from precomputed tables. The nodes
+                            come from util::sweep_2d over two fields of
+                            a base config (e.g. spot x vol) and are
+                            priced once by the exact engines; a query
+                            is then a bicubic (4 x 4 Lagrange)
+                            interpolation of the nodes around it, with
+                            no log / exp / CDF evaluation.
+
+                            The interpolation error is bounded when
+                            a table is built, from the remainder of
+                            the cubic interpolation in each cell:
+                                |f - P_x P_y f| <= omega_x M_x
+                                    + lebesgue_x omega_y M_y
+                            where omega is the max of the node
+                            polynomial over the cell, lebesgue the
+                            growth of the stencil weights, and M the
+                            max fourth derivative over the stencil.
+                            M comes from the fourth differences of
+                            the nodes around the stencil (the fourth
+                            derivative at a point of each window of
+                            5 nodes, plus its change to the next
+                            window), times a safety factor of 2: the
+                            bound holds as long as the fourth
+                            derivative does not turn faster than the
+                            nodes see, i.e. for a table fine enough
+                            to be worth using (on Black-Scholes
+                            tables, down to T = 0.01 on an axis, the
+                            errors stay under 3/4 of it).
+                            error_bounds() reports the max over the
+                            cells. With a tolerance in the spec, a
+                            table whose price bound exceeds it is
+                            rejected.
+
+                            Queries outside the table (other fields
+                            than the base, or outside the axes) fall
+                            back to the exact engines. The table can
+                            be rebuilt in the background while it is
+                            being queried: the new table is swapped in
+                            atomically, and lookups in flight finish
+                            on the table they started with.
+*/
+
+#ifndef TableEngine_hpp
+#define TableEngine_hpp
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "IGreeks.hpp"
+#include "IPricer.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // Axes and base config of a table (same arguments as util::sweep_2d)
+        struct TableSpec
+        {
+            option::OptionParams base{};
+            double option::OptionParams::* field_x = &option::OptionParams::asset_price;
+            double start_x{}, end_x{}, step_x{};
+            double option::OptionParams::* field_y = &option::OptionParams::volatility;
+            double start_y{}, end_y{}, step_y{};
+            // max price error bound allowed (0: no check)
+            double tolerance = 0.0;
+        };
+
+        // Bounds of the interpolation errors (max over the cells)
+        struct TableErrorBounds
+        {
+            double price{};
+            double delta{};
+            double gamma{};
+        };
+
+        // Price and Greeks of one lookup
+        struct TableQuote
+        {
+            double price{};
+            double delta{};
+            double gamma{};
+        };
+
+        class TableEngine final : public IPricer
+        {
+        private:
+            struct Table; // immutable once built (defined in the .cpp)
+
+            // --- Member variables ---
+            const IPricer& pricer_; // exact engines (must outlive the table engine)
+            const IGreeks& greeks_;
+            std::atomic<std::shared_ptr<const Table>> table_;
+            std::mutex rebuilds_mutex_;
+            std::vector<std::future<void>> rebuilds_; // background rebuilds (waited for on destruction)
+
+            // build(): nodes priced by the exact engines, then the error bounds
+            static std::shared_ptr<const Table> build(const IPricer& pricer, const IGreeks& greeks,
+                                                      const TableSpec& spec);
+
+        public:
+            // --- Constructor & Destructor ---
+            // builds the first table (throws std::invalid_argument on a bad spec,
+            // e.g. fewer than 5 nodes on an axis, or a tolerance not met)
+            TableEngine(const IPricer& pricer, const IGreeks& greeks, const TableSpec& spec);
+            // waits for the rebuilds in flight
+            virtual ~TableEngine();
+
+            // --- Price ---
+            using IPricer::price; // bring base class overloads into scope
+            double price(const option::OptionParams& p) const override;
+            std::vector<double> price(const std::vector<option::OptionParams>& batch) const override;
+            // the whole batch is served by the same table
+            void price(std::span<const option::OptionParams> batch, std::span<double> out) const override;
+
+            // --- Greeks ---
+            double delta(const option::OptionParams& p) const;
+            double gamma(const option::OptionParams& p) const;
+            // quote(): price, delta and gamma of one lookup
+            TableQuote quote(const option::OptionParams& p) const;
+
+            // --- Table ---
+            // covers(): true if p is answered from the table (no fallback)
+            bool covers(const option::OptionParams& p) const;
+            TableErrorBounds error_bounds() const;
+            TableSpec spec() const;
+
+            // rebuild(): build a table for spec and swap it in
+            // (if the build throws, the current table is kept)
+            void rebuild(const TableSpec& spec);
+            // rebuild_async(): rebuild() on a background thread; the future rethrows its errors
+            // (it can outlive the engine, whose destructor waits for the rebuild)
+            std::future<void> rebuild_async(const TableSpec& spec);
+        };
+    }
+}
+
+#endif // TableEngine_hpp
@@ -32,17 +32,39 @@ namespace yvan
 
         // Struct for Option Params
         // Default value to accomodate data from batch 1
-        struct OptionParams
+        // Templated on the floating type so that the kernels can run in
+        // single precision (OptionParamsF) as well as in double (OptionParams)
+        template<typename Real>
+        struct BasicOptionParams
         {
-            double asset_price = 60.0;
-            double strike_price = 65.0;
-            double r = 0.08;                                   // for stocks, we assume b = r
-            double cost_of_carry = 0.08;
-            double volatility = 0.30;
-            double exercise_time = 0.25;                       // (unit in years)
+            Real asset_price = Real(60.0);
+            Real strike_price = Real(65.0);
+            Real r = Real(0.08);                               // for stocks, we assume b = r
+            Real cost_of_carry = Real(0.08);
+            Real volatility = Real(0.30);
+            Real exercise_time = Real(0.25);                   // (unit in years)
             OptionType option_type = OptionType::Call;         // either Call or Put
         };
 
+        // the double precision params are the default everywhere in the project
+        using OptionParams = BasicOptionParams<double>;
+        // single precision params (indicative quoting, twice the SIMD width)
+        using OptionParamsF = BasicOptionParams<float>;
+
+        // params_cast(): convert params between floating types (e.g. double -> float)
+        template<typename To, typename From>
+        BasicOptionParams<To> params_cast(const BasicOptionParams<From>& p)
+        {
+            return BasicOptionParams<To>{ static_cast<To>(p.asset_price), static_cast<To>(p.strike_price),
+                                          static_cast<To>(p.r), static_cast<To>(p.cost_of_carry),
+                                          static_cast<To>(p.volatility), static_cast<To>(p.exercise_time),
+                                          p.option_type };
+        }
+
+        // params_error(): why params are invalid (the message Option::validate_params
+        // throws), nullptr if they are valid; for checking many params without exceptions
+        const char* params_error(const OptionParams& params) noexcept;
+
         // The Option Class (Abstract Base Class)
         class Option
         {
@@ -0,0 +1,75 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |         Portfolio Class         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This object is a book of option positions
+                            stored as a structure of arrays (one
+                            contiguous column per parameter, plus the
+                            quantity and the style of every position)
+                            instead of one polymorphic heap object per
+                            option. Engines walk the columns linearly
+                            (see engine::PortfolioEngine).
+*/
+
+#ifndef Portfolio_hpp
+#define Portfolio_hpp
+
+#include <cstddef>
+#include <vector>
+#include "Option.hpp"
+
+namespace yvan
+{
+    namespace option
+    {
+        class Portfolio
+        {
+        private:
+            // --- Member Variables (one entry per position) ---
+            std::vector<double> asset_price_;
+            std::vector<double> strike_price_;
+            std::vector<double> r_;
+            std::vector<double> cost_of_carry_;
+            std::vector<double> volatility_;
+            std::vector<double> exercise_time_;
+            std::vector<OptionType> option_type_;
+            std::vector<OptionStyle> style_;
+            std::vector<double> quantity_;     // signed number of contracts
+
+        public:
+            // --- Constructors & Destructor ---
+            Portfolio() = default;
+            ~Portfolio() = default;
+
+            // --- Positions ---
+            // add(): append a position (quantity < 0 for a short position)
+            void add(const OptionParams& params, double quantity, OptionStyle style = OptionStyle::European);
+            void add(const Option& option, double quantity);
+            void reserve(std::size_t n);
+            void clear() noexcept;
+
+            // --- Getters ---
+            std::size_t size() const noexcept { return quantity_.size(); }
+            bool empty() const noexcept { return quantity_.empty(); }
+            // params(): the OptionParams of position i (gathered from the columns)
+            OptionParams params(std::size_t i) const;
+            double quantity(std::size_t i) const { return quantity_[i]; }
+            OptionStyle style(std::size_t i) const { return style_[i]; }
+
+            // --- Columns ---
+            const std::vector<double>& asset_prices() const noexcept { return asset_price_; }
+            const std::vector<double>& strike_prices() const noexcept { return strike_price_; }
+            const std::vector<double>& rates() const noexcept { return r_; }
+            const std::vector<double>& costs_of_carry() const noexcept { return cost_of_carry_; }
+            const std::vector<double>& volatilities() const noexcept { return volatility_; }
+            const std::vector<double>& exercise_times() const noexcept { return exercise_time_; }
+            const std::vector<OptionType>& option_types() const noexcept { return option_type_; }
+            const std::vector<OptionStyle>& styles() const noexcept { return style_; }
+            const std::vector<double>& quantities() const noexcept { return quantity_; }
+        };
+    }
+}
+
+#endif // Portfolio_hpp
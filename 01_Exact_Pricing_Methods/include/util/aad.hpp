@@ -0,0 +1,231 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |             aad.hpp             |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for reverse-mode
+                            (adjoint) automatic differentiation.
+                            Every operation on an AReal records a
+                            node (its arguments and local partial
+                            derivatives) on the active Tape. One
+                            backward sweep over the tape then gives
+                            the derivative of one output with respect
+                            to every input, at a cost independent of
+                            the number of inputs.
+
+                            The tape is an arena: nodes live in fixed
+                            size blocks that are never reallocated and
+                            are reused after rewind(), so a warmed-up
+                            tape records without touching the heap.
+                            mark() / rewind() allow checkpointing:
+                            record a segment, sweep it, and drop it
+                            while keeping the nodes recorded before
+                            the mark (e.g. shared market inputs).
+*/
+
+#ifndef aad_hpp
+#define aad_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace yvan
+{
+    namespace util
+    {
+        // Tape of recorded operations
+        class Tape
+        {
+        public:
+            // one recorded operation: result adjoint + up to two (argument, partial) pairs
+            struct Node
+            {
+                double adjoint = 0.0;
+                double weight[2]{};
+                std::size_t arg[2]{};
+                unsigned n_args = 0;
+            };
+
+            // index of "no node" (constants are not recorded)
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+            // number of nodes per arena block
+            static constexpr std::size_t block_size = 4096;
+
+            using Mark = std::size_t;
+
+        private:
+            // --- Member Variables ---
+            std::vector<std::unique_ptr<Node[]>> blocks_;
+            std::size_t size_ = 0;
+
+        public:
+            // --- Constructor & Destructor ---
+            Tape() = default;
+            ~Tape();
+
+            // non-copyable (the AReals refer to node indices of this tape)
+            Tape(const Tape&) = delete;
+            Tape& operator=(const Tape&) = delete;
+
+            // --- Recording ---
+            // record(): append a node and return its index
+            std::size_t record(unsigned n_args, std::size_t a0 = npos, double w0 = 0.0,
+                               std::size_t a1 = npos, double w1 = 0.0)
+            {
+                if (size_ == blocks_.size() * block_size) grow();
+                Node& n = node(size_);
+                n.adjoint = 0.0;
+                n.n_args = n_args;
+                n.arg[0] = a0; n.weight[0] = w0;
+                n.arg[1] = a1; n.weight[1] = w1;
+                return size_++;
+            }
+
+            // --- Accessors ---
+            Node& node(std::size_t i) { return blocks_[i / block_size][i % block_size]; }
+            const Node& node(std::size_t i) const { return blocks_[i / block_size][i % block_size]; }
+            std::size_t size() const noexcept { return size_; }
+            std::size_t capacity() const noexcept { return blocks_.size() * block_size; }
+
+            // --- Checkpointing ---
+            Mark mark() const noexcept { return size_; }
+            void rewind(Mark m) noexcept { size_ = m; } // nodes >= m are dropped (memory kept)
+            void clear() noexcept { size_ = 0; }
+
+            // --- Adjoints ---
+            // propagate(): backward sweep from node `from` down to node `to` (inclusive).
+            // The caller seeds the adjoint of `from` first. Arguments recorded before `to`
+            // (e.g. shared inputs) receive their contributions but are not swept.
+            void propagate(std::size_t from, Mark to);
+
+            // reset_adjoints(): zero the adjoints of the nodes >= m
+            void reset_adjoints(Mark m = 0);
+
+            // --- Active Tape ---
+            // every AReal operation records on the active tape of the calling thread
+            static Tape*& active()
+            {
+                thread_local Tape* tape = nullptr;
+                return tape;
+            }
+
+            // Activation: RAII guard making a tape the active one
+            class Activation
+            {
+                Tape* previous_;
+            public:
+                explicit Activation(Tape& tape) : previous_(active()) { active() = &tape; }
+                ~Activation() { active() = previous_; }
+                Activation(const Activation&) = delete;
+                Activation& operator=(const Activation&) = delete;
+            };
+
+        private:
+            void grow();
+        };
+
+        // Active (recorded) real number
+        class AReal
+        {
+        private:
+            double v_ = 0.0;
+            std::size_t idx_ = Tape::npos; // npos: constant (not on the tape)
+
+            // unary(): result of an operation with one recorded argument
+            static AReal unary(double value, const AReal& a, double wa)
+            {
+                AReal out{ value };
+                if (a.idx_ != Tape::npos) out.idx_ = Tape::active()->record(1, a.idx_, wa);
+                return out;
+            }
+
+            // binary(): result of an operation with two arguments (constants are skipped)
+            static AReal binary(double value, const AReal& a, double wa, const AReal& b, double wb)
+            {
+                AReal out{ value };
+                if (a.idx_ != Tape::npos && b.idx_ != Tape::npos)
+                {
+                    out.idx_ = Tape::active()->record(2, a.idx_, wa, b.idx_, wb);
+                }
+                else if (a.idx_ != Tape::npos)
+                {
+                    out.idx_ = Tape::active()->record(1, a.idx_, wa);
+                }
+                else if (b.idx_ != Tape::npos)
+                {
+                    out.idx_ = Tape::active()->record(1, b.idx_, wb);
+                }
+                return out;
+            }
+
+        public:
+            // --- Constructors ---
+            AReal() = default;
+            AReal(double value) : v_(value) {} // constants (implicit to mix with literals)
+            template<typename S> requires std::is_arithmetic_v<S>
+            AReal(S value) : v_(static_cast<double>(value)) {}
+
+            // input(): an independent variable recorded on the active tape
+            static AReal input(double value)
+            {
+                AReal x{ value };
+                x.idx_ = Tape::active()->record(0);
+                return x;
+            }
+
+            // --- Accessors ---
+            double value() const noexcept { return v_; }
+            std::size_t index() const noexcept { return idx_; }
+            // adjoint(): dOutput/dThis after a backward sweep (0 for constants)
+            double adjoint() const { return idx_ == Tape::npos ? 0.0 : Tape::active()->node(idx_).adjoint; }
+
+            // --- Arithmetic ---
+            friend AReal operator+(const AReal& a, const AReal& b) { return binary(a.v_ + b.v_, a, 1.0, b, 1.0); }
+            friend AReal operator-(const AReal& a, const AReal& b) { return binary(a.v_ - b.v_, a, 1.0, b, -1.0); }
+            friend AReal operator*(const AReal& a, const AReal& b) { return binary(a.v_ * b.v_, a, b.v_, b, a.v_); }
+            friend AReal operator/(const AReal& a, const AReal& b)
+            {
+                double q = a.v_ / b.v_;
+                return binary(q, a, 1.0 / b.v_, b, -q / b.v_);
+            }
+            friend AReal operator-(const AReal& a) { return unary(-a.v_, a, -1.0); }
+            AReal& operator+=(const AReal& b) { return *this = *this + b; }
+            AReal& operator-=(const AReal& b) { return *this = *this - b; }
+            AReal& operator*=(const AReal& b) { return *this = *this * b; }
+            AReal& operator/=(const AReal& b) { return *this = *this / b; }
+
+            // --- Math Functions ---
+            friend AReal exp(const AReal& x) { double e = std::exp(x.v_); return unary(e, x, e); }
+            friend AReal log(const AReal& x) { return unary(std::log(x.v_), x, 1.0 / x.v_); }
+            friend AReal sqrt(const AReal& x) { double s = std::sqrt(x.v_); return unary(s, x, 0.5 / s); }
+            friend AReal erfc(const AReal& x)
+            {
+                // erfc'(x) = -2/sqrt(pi) * exp(-x^2)
+                return unary(std::erfc(x.v_), x, -1.12837916709551257390 * std::exp(-x.v_ * x.v_));
+            }
+            // pow(): d/da = b a^(b-1) (finite at a = 0), d/db = a^b log(a), recorded only
+            // for an active exponent (log(a) is not finite for a <= 0)
+            friend AReal pow(const AReal& a, const AReal& b)
+            {
+                if (b.idx_ == Tape::npos) return pow(a, b.v_);
+                double p = std::pow(a.v_, b.v_);
+                return binary(p, a, b.v_ * std::pow(a.v_, b.v_ - 1.0), b, p * std::log(a.v_));
+            }
+            template<typename S> requires std::is_arithmetic_v<S>
+            friend AReal pow(const AReal& a, S b)
+            {
+                double e = static_cast<double>(b);
+                return unary(std::pow(a.v_, e), a, e * std::pow(a.v_, e - 1.0));
+            }
+
+            // value_of(): plain double (for branching, e.g. interpolation brackets)
+            friend double value_of(const AReal& x) noexcept { return x.v_; }
+        };
+    }
+}
+
+#endif // aad_hpp
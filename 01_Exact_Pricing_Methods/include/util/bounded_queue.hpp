@@ -0,0 +1,103 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        bounded_queue.hpp        |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for a blocking FIFO of
+                            fixed capacity between threads: push()
+                            waits while the queue is full (back
+                            pressure on the producer), pop() waits
+                            while it is empty. The items live in a
+                            ring buffer allocated once, so moving
+                            buffers through the queue never touches
+                            the heap. close() wakes everybody up:
+                            pushes fail from then on and pops drain
+                            what is left.
+*/
+
+#ifndef bounded_queue_hpp
+#define bounded_queue_hpp
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace yvan
+{
+    namespace util
+    {
+        template<typename T>
+        class BoundedQueue
+        {
+        private:
+            // --- Member Variables ---
+            std::mutex mutex_;
+            std::condition_variable not_empty_;
+            std::condition_variable not_full_;
+            std::vector<T> ring_;
+            std::size_t head_ = 0;  // next item to pop
+            std::size_t count_ = 0;
+            bool closed_ = false;
+
+        public:
+            // --- Constructor ---
+            // throws std::invalid_argument if capacity is 0
+            explicit BoundedQueue(std::size_t capacity) : ring_(capacity)
+            {
+                if (capacity == 0)
+                {
+                    throw std::invalid_argument("Queue capacity must be positive.");
+                }
+            }
+
+            BoundedQueue(const BoundedQueue&) = delete;
+            BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+            // push(): blocks while full; false (item dropped) if the queue is closed
+            bool push(T item)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_full_.wait(lock, [this] { return count_ < ring_.size() || closed_; });
+                if (closed_) return false;
+                ring_[(head_ + count_) % ring_.size()] = std::move(item);
+                ++count_;
+                lock.unlock();
+                not_empty_.notify_one();
+                return true;
+            }
+
+            // pop(): blocks while empty; false once the queue is closed and drained
+            bool pop(T& out)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [this] { return count_ > 0 || closed_; });
+                if (count_ == 0) return false;
+                out = std::move(ring_[head_]);
+                head_ = (head_ + 1) % ring_.size();
+                --count_;
+                lock.unlock();
+                not_full_.notify_one();
+                return true;
+            }
+
+            // close(): no more pushes; waiting threads wake up
+            void close()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    closed_ = true;
+                }
+                not_empty_.notify_all();
+                not_full_.notify_all();
+            }
+
+            std::size_t capacity() const noexcept { return ring_.size(); }
+        };
+    }
+}
+
+#endif // bounded_queue_hpp
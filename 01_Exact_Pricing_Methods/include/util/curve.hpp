@@ -0,0 +1,65 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |            curve.hpp            |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for discount curves
+                            (term structure of rates or of dividend
+                            yields). The curve stores log discount
+                            factors at its pillars and interpolates
+                            them linearly in time (log-linear
+                            interpolation of the discount factors,
+                            i.e. piecewise flat forward rates), with
+                            D(0) = 1 and flat forward extrapolation
+                            after the last pillar.
+*/
+
+#ifndef curve_hpp
+#define curve_hpp
+
+#include <cmath>
+#include <vector>
+
+namespace yvan
+{
+    namespace util
+    {
+        class DiscountCurve
+        {
+        private:
+            // --- Member Variables ---
+            std::vector<double> times_;   // pillar times, increasing and > 0
+            std::vector<double> log_df_;  // log discount factors at the pillars
+
+        public:
+            // --- Constructors & Destructor ---
+            // default: zero rate everywhere (D(T) = 1)
+            DiscountCurve() : times_{ 1.0 }, log_df_{ 0.0 } {}
+            // from discount factors at the pillars
+            // throws std::invalid_argument if the sizes differ, the times are not positive
+            // and increasing or a discount factor is not positive
+            DiscountCurve(const std::vector<double>& times, const std::vector<double>& discount_factors);
+            ~DiscountCurve() = default;
+
+            // --- Factories ---
+            // flat(): constant continuously compounded rate
+            static DiscountCurve flat(double rate);
+            // from_zero_rates(): D(t_i) = e^(-z_i t_i)
+            static DiscountCurve from_zero_rates(const std::vector<double>& times, const std::vector<double>& zero_rates);
+
+            // --- Lookups ---
+            // log_discount(): log D(T) (T <= 0 gives 0)
+            double log_discount(double T) const;
+            double discount(double T) const { return std::exp(log_discount(T)); }
+            // zero_rate(): continuously compounded zero rate -log D(T) / T
+            double zero_rate(double T) const;
+
+            // --- Getters ---
+            const std::vector<double>& times() const noexcept { return times_; }
+            const std::vector<double>& log_discount_factors() const noexcept { return log_df_; }
+        };
+    }
+}
+
+#endif // curve_hpp
@@ -12,6 +12,9 @@
 #ifndef distributions_hpp
 #define distributions_hpp
 
+#include <cmath>
+#include "instrumentation.hpp"
+
 namespace yvan
 {
     namespace util
@@ -21,6 +24,26 @@ namespace yvan
 
         // Standard normal probability density function
         double n(double x);
+
+        // Generic versions for the other scalar types (e.g. float)
+        // The non-template double overloads above (Boost) are preferred for doubles,
+        // these are picked for every other type. The math functions are called
+        // unqualified so that user-defined scalars can provide them by ADL.
+        template<typename Real>
+        Real N(Real x)
+        {
+            YVAN_PROBE_COUNT(cdf, 1);
+            using std::erfc;
+            return Real(0.5) * erfc(-x * Real(0.70710678118654752440)); // 1/sqrt(2)
+        }
+
+        template<typename Real>
+        Real n(Real x)
+        {
+            YVAN_PROBE_COUNT(pdf, 1);
+            using std::exp;
+            return Real(0.39894228040143267794) * exp(Real(-0.5) * x * x); // 1/sqrt(2*pi)
+        }
     }
 }
 
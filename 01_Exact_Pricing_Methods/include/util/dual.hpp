@@ -0,0 +1,179 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |            dual.hpp             |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for forward-mode
+                            automatic differentiation. A Dual<T, N>
+                            carries a value and its N partial
+                            derivatives (tangents); every arithmetic
+                            operation and math function propagates
+                            them with the chain rule. Evaluating a
+                            kernel generic over its scalar type with
+                            Dual inputs therefore returns the exact
+                            derivatives in the same pass as the value.
+                            Duals nest (Dual<Dual<double, 1>, 1>) to
+                            get second order derivatives.
+*/
+
+#ifndef dual_hpp
+#define dual_hpp
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace yvan
+{
+    namespace util
+    {
+        // is_zero(): plain values (the Duals have their own, found by ADL)
+        template<typename T> requires std::is_arithmetic_v<T>
+        bool is_zero(T x) { return x == T(0); }
+
+        template<typename T, std::size_t N>
+        struct Dual
+        {
+            T v{};                 // value
+            std::array<T, N> d{};  // tangents (partial derivatives w.r.t. the N seeded inputs)
+
+            // --- Constructors ---
+            Dual() = default;
+            // constants (zero tangents); implicit so that kernels can mix Duals and literals
+            Dual(const T& value) : v(value) {}
+            template<typename S> requires std::is_arithmetic_v<S>
+            Dual(S value) : v(static_cast<T>(value)) {}
+            Dual(const T& value, const std::array<T, N>& tangents) : v(value), d(tangents) {}
+
+            // variable(): the i-th independent input (tangent e_i)
+            static Dual variable(const T& value, std::size_t i)
+            {
+                Dual x{ value };
+                x.d[i] = T(1);
+                return x;
+            }
+
+            // --- Arithmetic (hidden friends: found by ADL, allow implicit constants) ---
+            friend Dual operator+(const Dual& a, const Dual& b)
+            {
+                Dual out{ a.v + b.v };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = a.d[i] + b.d[i];
+                return out;
+            }
+            friend Dual operator-(const Dual& a, const Dual& b)
+            {
+                Dual out{ a.v - b.v };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = a.d[i] - b.d[i];
+                return out;
+            }
+            friend Dual operator*(const Dual& a, const Dual& b)
+            {
+                Dual out{ a.v * b.v };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = a.d[i] * b.v + a.v * b.d[i];
+                return out;
+            }
+            friend Dual operator/(const Dual& a, const Dual& b)
+            {
+                // (a/b)' = (a' - (a/b) b') / b
+                T q = a.v / b.v;
+                Dual out{ q };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = (a.d[i] - q * b.d[i]) / b.v;
+                return out;
+            }
+            friend Dual operator-(const Dual& a)
+            {
+                Dual out{ -a.v };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = -a.d[i];
+                return out;
+            }
+            Dual& operator+=(const Dual& b) { return *this = *this + b; }
+            Dual& operator-=(const Dual& b) { return *this = *this - b; }
+            Dual& operator*=(const Dual& b) { return *this = *this * b; }
+            Dual& operator/=(const Dual& b) { return *this = *this / b; }
+
+            // --- Math Functions ---
+            // the value type is called unqualified so nested Duals recurse through ADL
+            friend Dual exp(const Dual& x)
+            {
+                using std::exp;
+                T e = exp(x.v);
+                Dual out{ e };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = e * x.d[i];
+                return out;
+            }
+            friend Dual log(const Dual& x)
+            {
+                using std::log;
+                Dual out{ log(x.v) };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = x.d[i] / x.v;
+                return out;
+            }
+            friend Dual sqrt(const Dual& x)
+            {
+                using std::sqrt;
+                T s = sqrt(x.v);
+                Dual out{ s };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = x.d[i] / (T(2) * s);
+                return out;
+            }
+            friend Dual erfc(const Dual& x)
+            {
+                // erfc'(x) = -2/sqrt(pi) * exp(-x^2)
+                using std::erfc; using std::exp;
+                T slope = T(-1.12837916709551257390) * exp(-(x.v * x.v));
+                Dual out{ erfc(x.v) };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = slope * x.d[i];
+                return out;
+            }
+            friend Dual pow(const Dual& a, const Dual& b)
+            {
+                // (a^b)' = b a^(b-1) a' + a^b log(a) b'
+                // the log term only where b has a tangent: with a constant exponent
+                // a <= 0 has a finite derivative (as for pow(a, constant) below)
+                using std::pow; using std::log;
+                bool constant_b = true;
+                for (std::size_t i = 0; i < N; ++i) constant_b = constant_b && is_zero(b.d[i]);
+                if (constant_b) return pow_constant(a, b.v);
+
+                T p = pow(a.v, b.v);
+                T slope = b.v * pow(a.v, b.v - T(1));
+                T p_log_a = p * log(a.v);
+                Dual out{ p };
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    out.d[i] = slope * a.d[i];
+                    if (!is_zero(b.d[i])) out.d[i] += p_log_a * b.d[i];
+                }
+                return out;
+            }
+            // constant exponent: (a^b)' = b a^(b-1) a' (no log(a), so a <= 0 is fine)
+            template<typename S> requires std::is_arithmetic_v<S>
+            friend Dual pow(const Dual& a, S b)
+            {
+                return pow_constant(a, T(b));
+            }
+
+            // is_zero(): value and tangents all zero
+            friend bool is_zero(const Dual& x)
+            {
+                if (!is_zero(x.v)) return false;
+                for (std::size_t i = 0; i < N; ++i) if (!is_zero(x.d[i])) return false;
+                return true;
+            }
+
+        private:
+            static Dual pow_constant(const Dual& a, const T& b)
+            {
+                using std::pow;
+                T slope = b * pow(a.v, b - T(1));
+                Dual out{ pow(a.v, b) };
+                for (std::size_t i = 0; i < N; ++i) out.d[i] = slope * a.d[i];
+                return out;
+            }
+        };
+    }
+}
+
+#endif // dual_hpp
@@ -0,0 +1,278 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |       instrumentation.hpp       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header only instrumentation
+                            layer for the hot paths: how many calls,
+                            how many items (options, points, paths)
+                            and how much time went through each
+                            probe (batch calls of the engines, CDF
+                            evaluations, sweeps, Monte Carlo runs).
+
+                            The probes are compiled in with
+                            -DYVAN_INSTRUMENTATION=1. Otherwise the
+                            YVAN_PROBE_* macros expand to nothing
+                            (their arguments are not evaluated), so
+                            the hot paths cost nothing; snapshot()
+                            then returns zeros.
+
+                            Every thread counts into its own slot
+                            (plain relaxed stores, no shared cache
+                            line, no lock); snapshot() adds up the
+                            slots. Slots are linked once in a
+                            lock-free list and are reused by later
+                            threads, so the counts of a thread that
+                            ended are kept. The counters only grow:
+                            take two snapshots and subtract them to
+                            measure a section.
+
+                            A batch that delegates to the batch of
+                            another engine (e.g. ParityPricer) counts
+                            in both calls.
+*/
+
+#ifndef instrumentation_hpp
+#define instrumentation_hpp
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#ifndef YVAN_INSTRUMENTATION
+#define YVAN_INSTRUMENTATION 0
+#endif
+
+namespace yvan
+{
+    namespace util
+    {
+        namespace instr
+        {
+            constexpr bool enabled = YVAN_INSTRUMENTATION != 0;
+
+            // Probes (timed: calls, items and time; counted: calls and items)
+            enum class Probe : std::uint8_t
+            {
+                price_batch,    // timed, items = options (IPricer batches, price_batch())
+                delta_batch,    // timed, items = options (IGreeks batches, delta_batch())
+                gamma_batch,    // timed, items = options (IGreeks batches, gamma_batch())
+                cdf,            // counted, util::N()
+                pdf,            // counted, util::n()
+                sweep_1d,       // timed, items = points
+                sweep_2d,       // timed, items = points
+                mc_run,         // timed, items = paths (02_Monte_Carlo)
+                count
+            };
+            constexpr std::size_t probe_count = static_cast<std::size_t>(Probe::count);
+
+            inline const char* probe_name(Probe probe) noexcept
+            {
+                constexpr const char* names[probe_count] =
+                    { "price_batch", "delta_batch", "gamma_batch", "cdf", "pdf", "sweep_1d", "sweep_2d", "mc_run" };
+                return static_cast<std::size_t>(probe) < probe_count ? names[static_cast<std::size_t>(probe)] : "unknown";
+            }
+
+            // --- Per-Thread Slots ---
+            struct alignas(64) Slot
+            {
+                std::atomic<std::uint64_t> calls[probe_count] = {};
+                std::atomic<std::uint64_t> items[probe_count] = {};
+                std::atomic<std::uint64_t> ns[probe_count] = {};
+                std::atomic<bool> in_use{ false };
+                Slot* next = nullptr;   // set once, before the slot is published
+            };
+
+            // head of the list of slots (slots are never freed)
+            inline std::atomic<Slot*>& slots()
+            {
+                static std::atomic<Slot*> head{ nullptr };
+                return head;
+            }
+
+            // acquire_slot(): a free slot of the list, or a new one pushed at the head
+            inline Slot* acquire_slot()
+            {
+                for (Slot* s = slots().load(std::memory_order_acquire); s != nullptr; s = s->next)
+                {
+                    bool free = false;
+                    if (s->in_use.compare_exchange_strong(free, true, std::memory_order_acquire)) return s;
+                }
+                Slot* s = new Slot;
+                s->in_use.store(true, std::memory_order_relaxed);
+                s->next = slots().load(std::memory_order_relaxed);
+                while (!slots().compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed)) {}
+                return s;
+            }
+
+            // the slot of this thread, given back when the thread ends
+            inline Slot& thread_slot()
+            {
+                struct Owner
+                {
+                    Slot* slot = acquire_slot();
+                    ~Owner() { slot->in_use.store(false, std::memory_order_release); }
+                };
+                thread_local Owner owner;
+                return *owner.slot;
+            }
+
+            // only the owning thread writes a slot: load + store instead of a locked add
+            inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t n) noexcept
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+
+            // record(): one call of probe over items items, taking ns nanoseconds
+            inline void record(Probe probe, std::uint64_t items, std::uint64_t ns = 0)
+            {
+                Slot& s = thread_slot();
+                const std::size_t k = static_cast<std::size_t>(probe);
+                bump(s.calls[k], 1);
+                bump(s.items[k], items);
+                if (ns != 0) bump(s.ns[k], ns);
+            }
+
+            // ScopedTimer: records a call of probe with its wall time when it goes out of scope
+            class ScopedTimer
+            {
+            private:
+                Probe probe_;
+                std::uint64_t items_;
+                std::chrono::steady_clock::time_point start_;
+
+            public:
+                ScopedTimer(Probe probe, std::uint64_t items)
+                    : probe_(probe), items_(items), start_(std::chrono::steady_clock::now()) {}
+                ~ScopedTimer()
+                {
+                    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start_).count();
+                    record(probe_, items_, static_cast<std::uint64_t>(ns > 0 ? ns : 1));
+                }
+                // items(): the number of items, when it is only known at the end
+                void items(std::uint64_t n) noexcept { items_ = n; }
+
+                ScopedTimer(const ScopedTimer&) = delete;
+                ScopedTimer& operator=(const ScopedTimer&) = delete;
+            };
+
+            // --- Snapshots ---
+            struct ProbeStats
+            {
+                std::uint64_t calls = 0;
+                std::uint64_t items = 0;
+                std::uint64_t ns = 0;       // 0 for the counted probes
+            };
+
+            struct Snapshot
+            {
+                std::array<ProbeStats, probe_count> probes{};
+                std::size_t threads = 0;    // slots (threads that recorded, at most that many at once)
+
+                const ProbeStats& operator[](Probe probe) const { return probes[static_cast<std::size_t>(probe)]; }
+
+                // operator-(): what was recorded between two snapshots (earlier on the right)
+                Snapshot operator-(const Snapshot& earlier) const
+                {
+                    Snapshot d = *this;
+                    for (std::size_t k = 0; k < probe_count; ++k)
+                    {
+                        d.probes[k].calls -= earlier.probes[k].calls;
+                        d.probes[k].items -= earlier.probes[k].items;
+                        d.probes[k].ns -= earlier.probes[k].ns;
+                    }
+                    return d;
+                }
+            };
+
+            // snapshot(): the totals over all threads (a thread may be recording meanwhile:
+            // every counter is read atomically, the probes are not read at the same instant)
+            inline Snapshot snapshot()
+            {
+                Snapshot snap;
+                for (Slot* s = slots().load(std::memory_order_acquire); s != nullptr; s = s->next)
+                {
+                    ++snap.threads;
+                    for (std::size_t k = 0; k < probe_count; ++k)
+                    {
+                        snap.probes[k].calls += s->calls[k].load(std::memory_order_relaxed);
+                        snap.probes[k].items += s->items[k].load(std::memory_order_relaxed);
+                        snap.probes[k].ns += s->ns[k].load(std::memory_order_relaxed);
+                    }
+                }
+                return snap;
+            }
+
+            // --- Dumps ---
+            // to_text(): one line per probe (calls, items, total ms, ns per item)
+            inline std::string to_text(const Snapshot& snap)
+            {
+                char line[128];
+                std::snprintf(line, sizeof(line), "%-12s %14s %16s %12s %10s\n", "probe", "calls", "items", "total ms", "ns/item");
+                std::string out = line;
+                for (std::size_t k = 0; k < probe_count; ++k)
+                {
+                    const ProbeStats& p = snap.probes[k];
+                    if (p.ns != 0)
+                    {
+                        std::snprintf(line, sizeof(line), "%-12s %14llu %16llu %12.3f %10.2f\n", probe_name(static_cast<Probe>(k)),
+                                      static_cast<unsigned long long>(p.calls), static_cast<unsigned long long>(p.items),
+                                      static_cast<double>(p.ns) * 1e-6,
+                                      p.items ? static_cast<double>(p.ns) / static_cast<double>(p.items) : 0.0);
+                    }
+                    else
+                    {
+                        std::snprintf(line, sizeof(line), "%-12s %14llu %16llu %12s %10s\n", probe_name(static_cast<Probe>(k)),
+                                      static_cast<unsigned long long>(p.calls), static_cast<unsigned long long>(p.items), "-", "-");
+                    }
+                    out += line;
+                }
+                return out;
+            }
+
+            // to_json(): {"enabled": ..., "threads": ..., "probes": {"<name>": {"calls": ..., "items": ..., "ns": ...}, ...}}
+            inline std::string to_json(const Snapshot& snap)
+            {
+                std::string out = std::string("{\"enabled\": ") + (enabled ? "true" : "false")
+                                + ", \"threads\": " + std::to_string(snap.threads) + ", \"probes\": {";
+                for (std::size_t k = 0; k < probe_count; ++k)
+                {
+                    const ProbeStats& p = snap.probes[k];
+                    out += std::string(k ? ", " : "") + "\"" + probe_name(static_cast<Probe>(k)) + "\": {\"calls\": "
+                         + std::to_string(p.calls) + ", \"items\": " + std::to_string(p.items)
+                         + ", \"ns\": " + std::to_string(p.ns) + "}";
+                }
+                return out + "}}";
+            }
+        }
+    }
+}
+
+// --- Probe Macros ---
+// YVAN_PROBE_TIME(probe, items): times the rest of the enclosing scope
+// YVAN_PROBE_TIMER(timer, probe, items): same, with a named timer whose
+//     number of items can be set later by YVAN_PROBE_ITEMS(timer, items)
+// YVAN_PROBE_COUNT(probe, items): counts one call over items
+#define YVAN_PROBE_CONCAT_(a, b) a##b
+#define YVAN_PROBE_CONCAT(a, b) YVAN_PROBE_CONCAT_(a, b)
+#if YVAN_INSTRUMENTATION
+#define YVAN_PROBE_TIMER(timer, probe, items) \
+    ::yvan::util::instr::ScopedTimer timer(::yvan::util::instr::Probe::probe, static_cast<std::uint64_t>(items))
+#define YVAN_PROBE_ITEMS(timer, n) timer.items(static_cast<std::uint64_t>(n))
+#define YVAN_PROBE_TIME(probe, items) YVAN_PROBE_TIMER(YVAN_PROBE_CONCAT(yvan_probe_timer_, __LINE__), probe, items)
+#define YVAN_PROBE_COUNT(probe, items) \
+    ::yvan::util::instr::record(::yvan::util::instr::Probe::probe, static_cast<std::uint64_t>(items))
+#else
+#define YVAN_PROBE_TIMER(timer, probe, items) ((void)0)
+#define YVAN_PROBE_ITEMS(timer, n) ((void)0)
+#define YVAN_PROBE_TIME(probe, items) ((void)0)
+#define YVAN_PROBE_COUNT(probe, items) ((void)0)
+#endif
+
+#endif // instrumentation_hpp
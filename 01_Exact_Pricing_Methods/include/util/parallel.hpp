@@ -0,0 +1,110 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |           parallel.hpp          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for a minimal fork-join
+                            helper: parallel_for splits an index range
+                            into one contiguous block per thread
+                            (std::thread, static partition) and waits
+                            for all of them. An exception thrown by a
+                            block is rethrown in the calling thread.
+
+                            parallel_for_dynamic hands out single
+                            indices instead: each worker takes the
+                            next one from a shared counter, which
+                            balances items of very different costs
+                            (e.g. whole jobs) across the threads.
+*/
+
+#ifndef parallel_hpp
+#define parallel_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace yvan
+{
+    namespace util
+    {
+        // default_thread_count(): number of hardware threads (at least 1)
+        inline std::size_t default_thread_count()
+        {
+            return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        // parallel_for(): body(begin, end) on n_threads contiguous blocks of [0, n)
+        // (the calling thread runs the body itself when a single block is needed)
+        template<typename Body>
+        void parallel_for(std::size_t n, std::size_t n_threads, Body&& body)
+        {
+            if (n == 0) return;
+            n_threads = std::clamp<std::size_t>(n_threads, 1, n);
+            if (n_threads == 1) { body(std::size_t{ 0 }, n); return; }
+
+            const std::size_t block = (n + n_threads - 1) / n_threads;
+            std::vector<std::exception_ptr> errors(n_threads);
+            std::vector<std::thread> workers;
+            workers.reserve(n_threads);
+            for (std::size_t t = 0; t < n_threads; ++t)
+            {
+                const std::size_t begin = t * block;
+                const std::size_t end = std::min(n, begin + block);
+                if (begin >= end) break;
+                workers.emplace_back([&body, &errors, t, begin, end]
+                {
+                    try { body(begin, end); }
+                    catch (...) { errors[t] = std::current_exception(); }
+                });
+            }
+            for (auto& w : workers) w.join();
+            for (const auto& e : errors) if (e) std::rethrow_exception(e);
+        }
+
+        // parallel_for_dynamic(): body(i) for every i in [0, n), each of n_threads workers
+        // taking the next index from a shared counter (items are not started in a fixed
+        // order across threads); after an exception no new item is started
+        template<typename Body>
+        void parallel_for_dynamic(std::size_t n, std::size_t n_threads, Body&& body)
+        {
+            if (n == 0) return;
+            n_threads = std::clamp<std::size_t>(n_threads, 1, n);
+            if (n_threads == 1) { for (std::size_t i = 0; i < n; ++i) body(i); return; }
+
+            std::atomic<std::size_t> next{ 0 };
+            std::atomic<bool> failed{ false };
+            std::vector<std::exception_ptr> errors(n_threads);
+            std::vector<std::thread> workers;
+            workers.reserve(n_threads);
+            for (std::size_t t = 0; t < n_threads; ++t)
+            {
+                workers.emplace_back([&body, &errors, &next, &failed, n, t]
+                {
+                    try
+                    {
+                        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                             i < n && !failed.load(std::memory_order_relaxed);
+                             i = next.fetch_add(1, std::memory_order_relaxed))
+                        {
+                            body(i);
+                        }
+                    }
+                    catch (...)
+                    {
+                        errors[t] = std::current_exception();
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+            for (const auto& e : errors) if (e) std::rethrow_exception(e);
+        }
+    }
+}
+
+#endif // parallel_hpp
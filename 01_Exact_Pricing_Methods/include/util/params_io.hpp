@@ -0,0 +1,124 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          params_io.hpp          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for loading books of
+                            option positions from files into
+                            OptionParams (or a Portfolio). The files
+                            are memory-mapped and cut into chunks that
+                            are parsed by several threads (CSV chunks
+                            end on line boundaries); numbers are read
+                            with std::from_chars. The result does not
+                            depend on the number of threads.
+
+                            Every row is checked with the rules of
+                            Option::validate_params (option::
+                            params_error). A bad row does not stop the
+                            load: it is left out and reported with the
+                            reason, and all the other rows are kept.
+
+                            CSV files have a header line; the columns
+                            are found by name (see ParamsCsv), other
+                            columns are ignored. Fields are not quoted.
+
+                            The binary format stores the book by
+                            columns, like a Portfolio:
+
+                              offset 0    ParamsHeader (128 bytes)
+                              offsets[k]  column k, count values
+
+                            with the six parameters and the quantity
+                            as doubles, then the option type as one
+                            byte (0 call, 1 put). Everything is
+                            little-endian and every column starts on
+                            a 64-byte boundary.
+*/
+
+#ifndef params_io_hpp
+#define params_io_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../options/Option.hpp"
+#include "../options/Portfolio.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // Names of the CSV columns of each field (the header may list them in any order)
+        struct ParamsCsv
+        {
+            std::string asset_price = "asset_price";
+            std::string strike_price = "strike_price";
+            std::string r = "r";
+            std::string cost_of_carry = "cost_of_carry";
+            std::string volatility = "volatility";
+            std::string exercise_time = "exercise_time";
+            std::string option_type = "option_type"; // call / put, or c / p (any case)
+            std::string quantity = "quantity";       // optional column (1 if absent)
+            char separator = ',';
+        };
+
+        // A row that was left out, and why
+        struct ParamsRowError
+        {
+            std::size_t row;            // line of the CSV file (1: header), record of a binary file (0: first)
+            std::string message;
+        };
+
+        // Rows loaded from a file (in file order)
+        struct ParamsLoad
+        {
+            std::vector<option::OptionParams> params;
+            std::vector<double> quantities;        // quantity of params[k]
+            std::vector<std::size_t> rows;         // row of params[k] in the file (as in ParamsRowError)
+            std::vector<ParamsRowError> errors;    // rows left out
+        };
+
+        // parse_params_csv(): the rows of a CSV text (header line first)
+        // throws std::invalid_argument if a required column is missing from the header
+        ParamsLoad parse_params_csv(std::string_view text, const ParamsCsv& format = {}, std::size_t n_threads = 1);
+
+        // load_params_csv(): parse_params_csv() of a memory-mapped file
+        // throws std::invalid_argument if the file cannot be read or a column is missing
+        ParamsLoad load_params_csv(const std::string& path, const ParamsCsv& format = {}, std::size_t n_threads = 1);
+
+        // --- Binary Books ---
+        // Header of a binary book
+        struct ParamsHeader
+        {
+            char magic[8];              // "YPARAMS" padded with '\0'
+            std::uint32_t version;      // params_format_version
+            std::uint32_t header_size;  // sizeof(ParamsHeader)
+            std::uint64_t count;        // number of positions
+            std::uint64_t offsets[8];   // byte offsets of the columns: asset_price, strike_price, r,
+                                        // cost_of_carry, volatility, exercise_time, quantity, option_type
+            char reserved[40];
+        };
+        static_assert(sizeof(ParamsHeader) == 128, "ParamsHeader must have no padding.");
+
+        constexpr std::uint32_t params_format_version = 1;
+
+        // write_params_binary(): params[k] with quantities[k] (all 1 if quantities is empty)
+        // throws std::invalid_argument if the sizes do not match or the file cannot be opened
+        void write_params_binary(const std::string& path,
+                                 std::span<const option::OptionParams> params,
+                                 std::span<const double> quantities = {});
+
+        // load_params_binary(): the records of a memory-mapped binary book
+        // throws std::invalid_argument if the file is not a binary book
+        ParamsLoad load_params_binary(const std::string& path, std::size_t n_threads = 1);
+
+        // to_portfolio(): the loaded rows as a book (European positions)
+        option::Portfolio to_portfolio(const ParamsLoad& load);
+    }
+}
+
+#endif // params_io_hpp
@@ -6,11 +6,17 @@
 
                             This object is a utility header for
                             functions exploiting the call put parity.
+                            The parity honours the cost of carry:
+                            C - P = S * e^((b-r)T) - K * e^(-rT)
+                            (b = r for stocks: C - P = S - K * e^(-rT)).
 */
 
 #ifndef parity_hpp
 #define parity_hpp
 
+#include <cstddef>
+#include <span>
+#include <vector>
 #include "../options/Option.hpp"
 #include "../options/EuropeanOption.hpp"
 
@@ -18,6 +24,9 @@ namespace yvan
 {
     namespace util
     {
+        // call_minus_put(): C - P implied by the parity, S * e^((b-r)T) - K * e^(-rT)
+        double call_minus_put(const option::OptionParams& params);
+
         // put_from_call(): compute the put price from the call price using put-call parity
         double put_from_call(double C, const option::OptionParams& params);
         double put_from_call(double C, const option::EuropeanOption& option); // overload
@@ -30,7 +39,32 @@ namespace yvan
         bool check_parity(double C, double P, const option::OptionParams& params, double tol = 1e-6);
         bool check_parity(double C, double P, const option::EuropeanOption& option, double tol = 1e-6);
 
-        
+        // --- Batch Parity Scanner ---
+        // A call and a put quote on the same market (S, K, T, r, b) whose prices
+        // break C - P = S e^((b-r)T) - K e^(-rT) by more than the tolerance
+        struct ParityViolation
+        {
+            std::size_t call_index{}; // index of the call quote in the scanned chain
+            std::size_t put_index{};  // index of the put quote
+            double residual{};        // C - P - (S e^((b-r)T) - K e^(-rT))
+        };
+
+        // Result of a scan
+        struct ParityScan
+        {
+            std::vector<ParityViolation> violations; // sorted by decreasing |residual|
+            std::vector<std::size_t> duplicates;     // quotes replaced by a later one of the same key (sorted)
+        };
+
+        // scan_parity(): pair the calls and puts of a chain by (S, K, T, r, b) (hash join) and
+        // return the pairs with |residual| > tol, so that the chains of several underlyings
+        // (or curves) can be scanned together
+        // quotes[i] holds the market data and the type of quote i, prices[i] its price
+        // (when several quotes share a key and a type, the last one is paired and the
+        // others are reported in duplicates)
+        // throws std::invalid_argument if quotes and prices differ in size
+        ParityScan scan_parity(std::span<const option::OptionParams> quotes,
+                               std::span<const double> prices, double tol = 1e-6);
     }
 }
 
@@ -0,0 +1,106 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        pricing_cache.hpp        |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for a fixed-capacity
+                            memoization cache keyed on the bit
+                            pattern of an OptionParams struct.
+                            The table is split into shards (each one
+                            guarded by its own mutex) so that several
+                            threads pricing a batch do not fight over
+                            a single lock. Inside a shard we use open
+                            addressing with a bounded probe window and
+                            CLOCK (second chance) eviction.
+*/
+
+#ifndef pricing_cache_hpp
+#define pricing_cache_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../options/Option.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // hash_params(): hash the bit pattern of every field of an OptionParams
+        // note: 0.0 and -0.0 (or two different NaNs) are different keys on purpose
+        std::uint64_t hash_params(const option::OptionParams& p) noexcept;
+
+        // same_params(): bitwise equality of two OptionParams (consistent with hash_params)
+        bool same_params(const option::OptionParams& a, const option::OptionParams& b) noexcept;
+
+        // Pricing Cache
+        class PricingCache
+        {
+        private:
+            // --- Internal Types ---
+            // one entry of the open addressing table
+            struct Slot
+            {
+                option::OptionParams key{};
+                double value{};
+                std::uint64_t hash{};
+                bool occupied = false;
+                bool referenced = false; // CLOCK bit: set on hit, cleared by the hand
+            };
+
+            // one shard = one independent table with its own lock and counters
+            // (aligned to a cache line so neighbouring shards do not false share)
+            struct alignas(64) Shard
+            {
+                std::mutex mutex;
+                std::vector<Slot> slots;
+                std::size_t hand = 0;    // CLOCK hand (offset inside the probe window)
+                std::uint64_t hits = 0;
+                std::uint64_t misses = 0;
+            };
+
+            // --- Member Variables ---
+            std::unique_ptr<Shard[]> shards_; // std::mutex is not movable, hence no std::vector
+            std::size_t n_shards_;
+            std::size_t slots_per_shard_;     // power of two
+
+            // --- Internal Helpers ---
+            Shard& shard_for(std::uint64_t h) const noexcept;
+
+        public:
+            // maximum number of slots inspected for one key
+            static constexpr std::size_t probe_window = 8;
+
+            // --- Constructor & Destructor ---
+            // capacity and n_shards are rounded up to powers of two
+            // throws std::invalid_argument if capacity or n_shards is 0
+            explicit PricingCache(std::size_t capacity = 4096, std::size_t n_shards = 16);
+            ~PricingCache() = default;
+
+            // non-copyable (owns mutexes)
+            PricingCache(const PricingCache&) = delete;
+            PricingCache& operator=(const PricingCache&) = delete;
+
+            // --- Lookup & Insertion ---
+            // find(): returns true and writes the cached value if the key is present
+            bool find(const option::OptionParams& p, double& value) const;
+
+            // insert(): store (or overwrite) the value for the key, evicting with CLOCK if needed
+            void insert(const option::OptionParams& p, double value);
+
+            // clear(): drop every entry and reset the counters
+            void clear();
+
+            // --- Statistics ---
+            std::uint64_t hits() const;
+            std::uint64_t misses() const;
+            std::size_t capacity() const noexcept { return n_shards_ * slots_per_shard_; }
+            std::size_t size() const; // number of occupied slots
+        };
+    }
+}
+
+#endif // pricing_cache_hpp
@@ -0,0 +1,58 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          summation.hpp          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for compensated
+                            (Neumaier) summation: the rounding error
+                            of every addition is carried in a second
+                            accumulator, so the error of the sum does
+                            not grow with the number of terms (and
+                            large positions of opposite signs do not
+                            wipe out the small ones).
+*/
+
+#ifndef summation_hpp
+#define summation_hpp
+
+#include <cmath>
+#include <span>
+
+namespace yvan
+{
+    namespace util
+    {
+        // Neumaier compensated sum
+        class NeumaierSum
+        {
+        private:
+            double sum_ = 0.0;
+            double c_ = 0.0; // running compensation (lost low-order bits)
+
+        public:
+            void add(double x) noexcept
+            {
+                const double t = sum_ + x;
+                if (std::abs(sum_) >= std::abs(x)) c_ += (sum_ - t) + x; // low bits of x were lost
+                else c_ += (x - t) + sum_;                              // low bits of sum_ were lost
+                sum_ = t;
+            }
+            // add(): merge another compensated sum
+            void add(const NeumaierSum& other) noexcept { add(other.sum_); c_ += other.c_; }
+            NeumaierSum& operator+=(double x) noexcept { add(x); return *this; }
+
+            double value() const noexcept { return sum_ + c_; }
+        };
+
+        // compensated_sum(): Neumaier sum of a range of doubles
+        inline double compensated_sum(std::span<const double> xs) noexcept
+        {
+            NeumaierSum s;
+            for (double x : xs) s.add(x);
+            return s.value();
+        }
+    }
+}
+
+#endif // summation_hpp
@@ -0,0 +1,233 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          surface_io.hpp         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for exporting surfaces
+                            (a Grid2D of values over a sweep_2d grid
+                            of parameters) to files. Numbers are
+                            formatted with std::to_chars (no locale,
+                            no stream state) into a large reusable
+                            buffer that goes to the file in a few
+                            large writes. The rows of a surface can
+                            be formatted by several threads: each one
+                            fills its own buffer with a chunk of rows
+                            and the buffers are written in order, so
+                            the file does not depend on the number of
+                            threads.
+
+                            Surfaces can also be written in a binary
+                            layout meant to be memory-mapped (e.g. by
+                            numpy.memmap) instead of parsed:
+
+                              offset 0    SurfaceHeader (128 bytes)
+                              x_offset    x axis, nrows doubles
+                              y_offset    y axis, ncols doubles
+                              data_offset values, nrows x ncols doubles
+                                          (row-major: values(i, j) is
+                                          the value at (x[i], y[j]))
+
+                            Everything is little-endian and every
+                            array starts on a 64-byte boundary.
+
+                            Both formats are also available as
+                            SurfaceSinks, which receive a surface row
+                            by row (see util/surface_stream.hpp).
+*/
+
+#ifndef surface_io_hpp
+#define surface_io_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../options/Option.hpp"
+#include "grid2d.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // max digits after the decimal point of the CSV writers
+        constexpr int max_csv_precision = 100;
+
+        // Buffered file writer (few large fwrite calls, the stdio buffer is bypassed)
+        class CsvWriter
+        {
+        private:
+            // --- Member Variables ---
+            std::FILE* file_ = nullptr;
+            std::vector<char> buffer_;
+            std::size_t used_ = 0;
+
+        public:
+            static constexpr std::size_t default_buffer_size = std::size_t{ 1 } << 20;
+
+            // --- Constructor & Destructor ---
+            // throws std::invalid_argument if the file cannot be opened
+            explicit CsvWriter(const std::string& path, std::size_t buffer_size = default_buffer_size);
+            // flushes and closes (errors are lost: call close() to get them)
+            ~CsvWriter();
+
+            CsvWriter(const CsvWriter&) = delete;
+            CsvWriter& operator=(const CsvWriter&) = delete;
+
+            // --- Writing ---
+            void write(std::string_view text);
+            // write_row(): fields in fixed notation, comma separated, '\n' terminated
+            // throws std::invalid_argument if precision is not in [0, max_csv_precision]
+            void write_row(std::span<const double> fields, int precision);
+            // write_block(): already formatted rows (e.g. from another thread)
+            void write_block(std::span<const char> bytes);
+
+            // flush() / close(): throw std::runtime_error if the write fails
+            void flush();
+            void close();
+        };
+
+        // Layout of a surface CSV: one "x,y,value" row per node, rows of the grid first
+        struct SurfaceCsv
+        {
+            std::string x_name;
+            std::string y_name;
+            std::string value_name;
+            int precision = 4; // digits after the decimal point
+        };
+
+        // write_surface_csv(): export values(i, j) at (grid(i, j).*field_x, grid(i, j).*field_y)
+        // with n_threads formatting chunks of rows (the file is the same for any n_threads)
+        // throws std::invalid_argument if values does not have the dimensions of grid
+        void write_surface_csv(const std::string& path,
+                               const Grid2D<option::OptionParams>& grid,
+                               double option::OptionParams::* field_x,
+                               double option::OptionParams::* field_y,
+                               const Grid2D<double>& values,
+                               const SurfaceCsv& format,
+                               std::size_t n_threads = 1);
+
+        // --- Binary Surfaces ---
+        // names of the two axes and of the values (at most 23 chars each)
+        struct SurfaceNames
+        {
+            std::string x;
+            std::string y;
+            std::string value;
+        };
+
+        // Header of a binary surface file
+        struct SurfaceHeader
+        {
+            char magic[8];              // "YSURF" padded with '\0'
+            std::uint32_t version;      // surface_format_version
+            std::uint32_t header_size;  // sizeof(SurfaceHeader)
+            std::uint64_t nrows;
+            std::uint64_t ncols;
+            std::uint64_t x_offset;     // byte offsets from the start of the file
+            std::uint64_t y_offset;
+            std::uint64_t data_offset;
+            char x_name[24];            // '\0' terminated
+            char y_name[24];
+            char value_name[24];
+        };
+        static_assert(sizeof(SurfaceHeader) == 128, "SurfaceHeader must have no padding.");
+
+        constexpr std::uint32_t surface_format_version = 1;
+        constexpr std::size_t surface_alignment = 64;
+
+        // Binary surface read back in memory
+        struct SurfaceFile
+        {
+            SurfaceNames names;
+            std::vector<double> x;
+            std::vector<double> y;
+            Grid2D<double> values;
+        };
+
+        // write_surface_binary(): values(i, j) at (x[i], y[j])
+        // throws std::invalid_argument if the sizes do not match or a name is too long
+        void write_surface_binary(const std::string& path,
+                                  std::span<const double> x,
+                                  std::span<const double> y,
+                                  const Grid2D<double>& values,
+                                  const SurfaceNames& names);
+
+        // overload taking the axes from a sweep_2d grid
+        void write_surface_binary(const std::string& path,
+                                  const Grid2D<option::OptionParams>& grid,
+                                  double option::OptionParams::* field_x,
+                                  double option::OptionParams::* field_y,
+                                  const Grid2D<double>& values,
+                                  const SurfaceNames& names);
+
+        // read_surface_binary(): throws std::invalid_argument if the file is not a surface
+        SurfaceFile read_surface_binary(const std::string& path);
+
+        // --- Sinks ---
+        // Output format of a surface received row by row
+        class SurfaceSink
+        {
+        public:
+            virtual ~SurfaceSink() = default;
+
+            // begin(): the two axes, once before the rows
+            virtual void begin(std::span<const double> x, std::span<const double> y) = 0;
+            // write_row(): values[j] at (x[i], y[j]); rows arrive in order i = 0, 1, ...
+            virtual void write_row(std::size_t i, std::span<const double> values) = 0;
+            // end(): after the last row (the file is complete and closed)
+            virtual void end() = 0;
+        };
+
+        // CSV sink (same file as write_surface_csv)
+        class CsvSurfaceSink final : public SurfaceSink
+        {
+        private:
+            std::string path_;
+            CsvWriter writer_;
+            SurfaceCsv format_;
+            std::vector<double> x_, y_;
+            std::size_t rows_written_{};
+
+        public:
+            // throws std::invalid_argument if the file cannot be opened or the precision is invalid
+            CsvSurfaceSink(const std::string& path, SurfaceCsv format);
+
+            void begin(std::span<const double> x, std::span<const double> y) override;
+            // throws std::invalid_argument if the row is out of order or has the wrong size
+            void write_row(std::size_t i, std::span<const double> values) override;
+            // throws std::runtime_error if rows are missing
+            void end() override;
+        };
+
+        // Binary sink (same file as write_surface_binary)
+        class BinarySurfaceSink final : public SurfaceSink
+        {
+        private:
+            std::string path_;
+            SurfaceNames names_;
+            std::FILE* file_ = nullptr;
+            std::size_t nrows_{}, ncols_{};
+            std::size_t rows_written_{};
+
+        public:
+            // throws std::invalid_argument if the file cannot be opened or a name is too long
+            BinarySurfaceSink(const std::string& path, SurfaceNames names);
+            ~BinarySurfaceSink();
+
+            BinarySurfaceSink(const BinarySurfaceSink&) = delete;
+            BinarySurfaceSink& operator=(const BinarySurfaceSink&) = delete;
+
+            void begin(std::span<const double> x, std::span<const double> y) override;
+            // throws std::invalid_argument if the row is out of order or has the wrong size
+            void write_row(std::size_t i, std::span<const double> values) override;
+            // throws std::runtime_error if rows are missing
+            void end() override;
+        };
+    }
+}
+
+#endif // surface_io_hpp
@@ -0,0 +1,68 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |       surface_stream.hpp        |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for generating surfaces
+                            without holding them in memory. Instead of
+                            a full sweep_2d grid of parameters and a
+                            full grid of results, the surface is
+                            produced by batches of rows: the calling
+                            thread fills the parameters of a batch and
+                            evaluates it (any IPricer / IGreeks batch
+                            call), then hands the finished rows to a
+                            writer thread through a BoundedQueue. The
+                            writer passes them on to the sinks (CSV,
+                            binary, ... see util/surface_io.hpp) while
+                            the next batch is evaluated.
+
+                            The row buffers are allocated once and
+                            recycled between the two threads, so the
+                            memory used is
+                                (queue_capacity + 2) batches of values
+                              + one batch of parameters
+                            whatever the number of rows.
+*/
+
+#ifndef surface_stream_hpp
+#define surface_stream_hpp
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+#include "../options/Option.hpp"
+#include "surface_io.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // RowEvaluator: out[k] = result for batch[k] (e.g. a lambda calling IPricer::price
+        // or IGreeks::delta on the span overloads)
+        using RowEvaluator = std::function<void(std::span<const option::OptionParams>, std::span<double>)>;
+
+        struct SurfaceStreamOptions
+        {
+            std::size_t rows_per_batch = 0; // rows evaluated per call (0: about 4096 values per call)
+            std::size_t queue_capacity = 4; // finished batches waiting for the writer
+        };
+
+        // stream_surface(): the surface of sweep_2d(base, field_x, ..., field_y, ...) evaluated
+        // batch by batch and written to every sink (rows in order, same axes as sweep_2d)
+        // an exception of the evaluator or of a sink stops both threads and is rethrown
+        // (end() is then not called on the sinks)
+        // throws std::invalid_argument on bad axes, no sinks or a zero queue capacity
+        void stream_surface(const option::OptionParams& base,
+                            double option::OptionParams::* field_x,
+                            double start_x, double end_x, double step_x,
+                            double option::OptionParams::* field_y,
+                            double start_y, double end_y, double step_y,
+                            const RowEvaluator& evaluate,
+                            const std::vector<SurfaceSink*>& sinks,
+                            const SurfaceStreamOptions& options = {});
+    }
+}
+
+#endif // surface_stream_hpp
@@ -0,0 +1,98 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          validation.hpp         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for checking batches of
+                            OptionParams without exceptions. Every row
+                            gets a byte of fault bits (0: valid). The
+                            rules and their messages are defined here
+                            only: Option::validate_params applies all
+                            of them but the NaN / infinite check.
+                            The checks of a row are branch-free, so a
+                            batch is one pass over the data (and the
+                            Portfolio overload, which reads columns,
+                            is vectorized by the compiler).
+
+                            evaluate_valid() runs a batch evaluation
+                            on the valid rows only: the engines use it
+                            for their price / delta / gamma overloads
+                            taking an InvalidRows policy, so one bad
+                            row never fails a whole batch.
+*/
+
+#ifndef validation_hpp
+#define validation_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include "../options/Option.hpp"
+#include "../options/Portfolio.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // Fault bits of a row (combined with |)
+        namespace fault
+        {
+            constexpr std::uint8_t negative_asset_price = 1 << 0;
+            constexpr std::uint8_t negative_strike_price = 1 << 1;
+            constexpr std::uint8_t negative_volatility = 1 << 2;
+            constexpr std::uint8_t negative_exercise_time = 1 << 3;
+            constexpr std::uint8_t invalid_type = 1 << 4;
+            constexpr std::uint8_t not_finite = 1 << 5;   // NaN or infinite field (not checked by validate_params)
+        }
+
+        // params_faults(): fault bits of one row
+        inline std::uint8_t params_faults(const option::OptionParams& p) noexcept
+        {
+            const bool finite = std::isfinite(p.asset_price) & std::isfinite(p.strike_price) & std::isfinite(p.r)
+                              & std::isfinite(p.cost_of_carry) & std::isfinite(p.volatility) & std::isfinite(p.exercise_time);
+            const bool known_type = (p.option_type == option::OptionType::Call) | (p.option_type == option::OptionType::Put);
+            return static_cast<std::uint8_t>(
+                  (p.asset_price < 0.0) * fault::negative_asset_price
+                | (p.strike_price < 0.0) * fault::negative_strike_price
+                | (p.volatility < 0.0) * fault::negative_volatility
+                | (p.exercise_time < 0.0) * fault::negative_exercise_time
+                | !known_type * fault::invalid_type
+                | !finite * fault::not_finite);
+        }
+
+        // validate_batch(): faults[k] = params_faults(batch[k]); returns the number of invalid rows
+        // throws std::invalid_argument if faults.size() != batch.size()
+        std::size_t validate_batch(std::span<const option::OptionParams> batch, std::span<std::uint8_t> faults);
+        // same for the positions of a book (reads the columns)
+        std::size_t validate_batch(const option::Portfolio& book, std::span<std::uint8_t> faults);
+
+        // fault_message(): the message of the first fault bit (the one Option::validate_params
+        // throws, see option::params_error), nullptr if faults == 0
+        const char* fault_message(std::uint8_t faults) noexcept;
+
+        // --- Batches With Invalid Rows ---
+        // output of a row that fails validation
+        enum class InvalidRows
+        {
+            NaN,    // quiet NaN
+            Skip    // left as it is (not written)
+        };
+
+        // BatchEvaluator: out[k] = result for batch[k] (e.g. a span overload of IPricer / IGreeks)
+        using BatchEvaluator = std::function<void(std::span<const option::OptionParams>, std::span<double>)>;
+
+        // evaluate_valid(): evaluate on the valid rows of batch, in one call (on a
+        // compacted copy when some rows are invalid), and the invalid rows as per policy
+        // faults, if not empty, receives the fault bits of every row
+        // returns the number of invalid rows
+        // throws std::invalid_argument if out (or a non-empty faults) does not have the batch size
+        std::size_t evaluate_valid(std::span<const option::OptionParams> batch, std::span<double> out,
+                                   InvalidRows policy, std::span<std::uint8_t> faults,
+                                   const BatchEvaluator& evaluate);
+    }
+}
+
+#endif // validation_hpp
@@ -0,0 +1,96 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |         vol_surface.hpp         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a header for a simple implied
+                            volatility surface: a Grid2D of vols on
+                            (strike x expiry) nodes with bilinear
+                            interpolation and flat extrapolation.
+                            The interpolation is generic over the
+                            scalar type so that the surface nodes can
+                            be AAD inputs (sensitivity of a book to
+                            every node of the surface).
+*/
+
+#ifndef vol_surface_hpp
+#define vol_surface_hpp
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "grid2d.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // value_of(): plain double of a scalar (identity for doubles; AReal provides its own)
+        inline double value_of(double x) noexcept { return x; }
+
+        namespace detail
+        {
+            // locate(): bracket x on an increasing axis -> (i0, i1, weight of i1)
+            // outside the axis the value is clamped (flat extrapolation, zero weight)
+            template<typename Real>
+            void locate(const std::vector<double>& axis, const Real& x,
+                        std::size_t& i0, std::size_t& i1, Real& w)
+            {
+                const double xv = value_of(x);
+                const std::size_t n = axis.size();
+                if (n == 1 || xv <= axis.front()) { i0 = i1 = 0; w = Real(0); return; }
+                if (xv >= axis.back()) { i0 = i1 = n - 1; w = Real(0); return; }
+
+                std::size_t hi = 1;
+                while (axis[hi] < xv) ++hi;
+                i0 = hi - 1; i1 = hi;
+                w = (x - Real(axis[i0])) / Real(axis[i1] - axis[i0]);
+            }
+        }
+
+        // interpolate_vol(): bilinear interpolation of the node vols at (K, T)
+        template<typename Real>
+        Real interpolate_vol(const std::vector<double>& strikes, const std::vector<double>& expiries,
+                             const Grid2D<Real>& nodes, const Real& K, const Real& T)
+        {
+            std::size_t i0, i1, j0, j1;
+            Real wk, wt;
+            detail::locate(strikes, K, i0, i1, wk);
+            detail::locate(expiries, T, j0, j1, wt);
+
+            Real lo = nodes(i0, j0) + wt * (nodes(i0, j1) - nodes(i0, j0));
+            Real hi = nodes(i1, j0) + wt * (nodes(i1, j1) - nodes(i1, j0));
+            return lo + wk * (hi - lo);
+        }
+
+        // Implied volatility surface
+        struct VolSurface
+        {
+            std::vector<double> strikes;  // increasing (rows of vols)
+            std::vector<double> expiries; // increasing (cols of vols)
+            Grid2D<double> vols;          // vols(i, j) at (strikes[i], expiries[j])
+
+            // validate(): throws std::invalid_argument if the shapes do not match
+            void validate() const
+            {
+                if (strikes.empty() || expiries.empty())
+                {
+                    throw std::invalid_argument("Vol surface axes must not be empty.");
+                }
+                if (vols.nrows != strikes.size() || vols.ncols != expiries.size())
+                {
+                    throw std::invalid_argument("Vol surface grid must be strikes.size() x expiries.size().");
+                }
+            }
+
+            // vol(): interpolated volatility at (K, T)
+            double vol(double K, double T) const
+            {
+                return interpolate_vol(strikes, expiries, vols, K, T);
+            }
+        };
+    }
+}
+
+#endif // vol_surface_hpp
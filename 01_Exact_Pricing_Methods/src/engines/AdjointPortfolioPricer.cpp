@@ -0,0 +1,124 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |      AdjointPortfolioPricer     |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the adjoint
+                            (reverse-mode AAD) portfolio pricer.
+*/
+
+#include "../../include/engines/AdjointPortfolioPricer.hpp"
+#include "../../include/util/aad.hpp"
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace engine
+    {
+        AdjointRisk AdjointPortfolioPricer::risk(std::span<const option::OptionParams> positions,
+                                                 std::span<const double> quantities,
+                                                 const util::VolSurface* surface) const
+        {
+            // Validate inputs
+            if (positions.size() != quantities.size())
+            {
+                throw std::invalid_argument("Positions and quantities must have the same size.");
+            }
+            if (surface) surface->validate();
+
+            using util::AReal;
+            util::Tape tape;
+            util::Tape::Activation activation{ tape };
+
+            AdjointRisk out;
+            out.positions.resize(positions.size());
+
+            // shared market inputs first: they sit below every checkpoint mark,
+            // so their adjoints accumulate over all the positions
+            util::Grid2D<AReal> nodes;
+            if (surface)
+            {
+                nodes = util::Grid2D<AReal>(surface->vols.nrows, surface->vols.ncols);
+                for (std::size_t k = 0; k < nodes.data.size(); ++k) nodes.data[k] = AReal::input(surface->vols.data[k]);
+            }
+            const util::Tape::Mark book_start = tape.mark();
+
+            // inputs of every position (kept for the non-checkpointed sweep); with a surface,
+            // sigma is the interpolated vol: not an input but a node of the tape whose
+            // adjoint after the sweep is still dV/dsigma (K and T get the total derivative,
+            // through the kernel and through the surface)
+            struct Inputs { AReal S, K, r, b, sigma, T; };
+            std::vector<Inputs> inputs(checkpoint_ ? 1 : positions.size());
+            std::vector<AReal> values(checkpoint_ ? 0 : positions.size());
+
+            // read_gradient(): copy the adjoints of one position's inputs
+            auto read_gradient = [&](const Inputs& in, PositionGradient& g)
+            {
+                g = PositionGradient{ in.S.adjoint(), in.K.adjoint(), in.r.adjoint(),
+                                      in.b.adjoint(), in.sigma.adjoint(), in.T.adjoint() };
+            };
+
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                const option::OptionParams& p = positions[i];
+                const util::Tape::Mark position_start = tape.mark();
+
+                // forward pass: record the position on the tape
+                Inputs& in = inputs[checkpoint_ ? 0 : i];
+                in = Inputs{ AReal::input(p.asset_price), AReal::input(p.strike_price), AReal::input(p.r),
+                             AReal::input(p.cost_of_carry), AReal::input(p.volatility), AReal::input(p.exercise_time) };
+
+                if (surface)
+                {
+                    in.sigma = util::interpolate_vol(surface->strikes, surface->expiries, nodes, in.K, in.T);
+                }
+                option::BasicOptionParams<AReal> q{ in.S, in.K, in.r, in.b, in.sigma, in.T, p.option_type };
+                AReal value = AReal(quantities[i]) * engine_.price_kernel(q);
+                out.value += value.value();
+
+                if (checkpoint_)
+                {
+                    // backward sweep of this segment only, then drop it
+                    if (value.index() != util::Tape::npos)
+                    {
+                        tape.node(value.index()).adjoint = 1.0;
+                        tape.propagate(value.index(), position_start);
+                    }
+                    read_gradient(in, out.positions[i]);
+                    tape.rewind(position_start);
+                }
+                else
+                {
+                    values[i] = value;
+                }
+            }
+
+            if (!checkpoint_ && !values.empty())
+            {
+                // one backward sweep over the whole book: seed every position value with 1
+                // (the portfolio value is their sum)
+                for (const auto& v : values)
+                {
+                    if (v.index() != util::Tape::npos) tape.node(v.index()).adjoint += 1.0;
+                }
+                tape.propagate(tape.size() - 1, book_start);
+                for (std::size_t i = 0; i < positions.size(); ++i) read_gradient(inputs[i], out.positions[i]);
+            }
+
+            // shared market inputs
+            for (const auto& g : out.positions)
+            {
+                out.rate += g.dr;
+                out.carry += g.db;
+            }
+            if (surface)
+            {
+                out.vol_surface = util::Grid2D<double>(nodes.nrows, nodes.ncols);
+                for (std::size_t k = 0; k < nodes.data.size(); ++k) out.vol_surface.data[k] = nodes.data[k].adjoint();
+            }
+
+            return out;
+        }
+    }
+}
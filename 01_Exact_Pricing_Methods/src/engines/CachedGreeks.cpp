@@ -0,0 +1,39 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        CachedGreeks Class       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the memoizing
+                            decorator around any IGreeks.
+*/
+
+#include "../../include/engines/CachedGreeks.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // --- delta()
+        double CachedGreeks::delta(const option::OptionParams& p) const
+        {
+            double value;
+            if (delta_cache_.find(p, value)) return value;
+
+            value = greeks_.delta(p);
+            delta_cache_.insert(p, value);
+            return value;
+        }
+
+        // --- gamma()
+        double CachedGreeks::gamma(const option::OptionParams& p) const
+        {
+            double value;
+            if (gamma_cache_.find(p, value)) return value;
+
+            value = greeks_.gamma(p);
+            gamma_cache_.insert(p, value);
+            return value;
+        }
+    }
+}
@@ -0,0 +1,31 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        CachedPricer Class       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the memoizing
+                            decorator around any IPricer.
+*/
+
+#include "../../include/engines/CachedPricer.hpp"
+
+namespace yvan
+{
+    namespace engine
+    {
+        // --- Price ---
+        double CachedPricer::price(const option::OptionParams& p) const
+        {
+            // cache hit: no pricing at all
+            double value;
+            if (cache_.find(p, value)) return value;
+
+            // cache miss: price with the wrapped engine and remember the result
+            // (two threads missing on the same key both price it, which is harmless)
+            value = pricer_.price(p);
+            cache_.insert(p, value);
+            return value;
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |           ChainPricer           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the chain-aware
+                            Black-Scholes pricer.
+*/
+
+#include "../../include/engines/ChainPricer.hpp"
+#include "../../include/util/distributions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace engine
+    {
+        namespace
+        {
+            // key order of the groups: std::strong_order is a total order on the doubles
+            // (NaN included), so the sort stays well defined on bad rows; those are
+            // priced on their own (NaN never matches in same_key) and give NaN
+            bool key_less(const option::OptionParams& a, const option::OptionParams& b)
+            {
+                if (auto c = std::strong_order(a.asset_price, b.asset_price); c != 0) return c < 0;
+                if (auto c = std::strong_order(a.exercise_time, b.exercise_time); c != 0) return c < 0;
+                if (auto c = std::strong_order(a.r, b.r); c != 0) return c < 0;
+                return std::strong_order(a.cost_of_carry, b.cost_of_carry) < 0;
+            }
+
+            bool same_key(const option::OptionParams& a, const option::OptionParams& b)
+            {
+                return a.asset_price == b.asset_price && a.exercise_time == b.exercise_time
+                    && a.r == b.r && a.cost_of_carry == b.cost_of_carry;
+            }
+
+            // price_block(): n <= block_size options of one group
+            // strike(i), vol(i), sign(i) read the i-th option; the loops have no branch
+            template<typename Strike, typename Vol, typename Sign, typename Out>
+            void price_block(const ChainFactors& f, std::size_t n, Strike strike, Vol vol, Sign sign, Out out)
+            {
+                double d1[ChainPricer::block_size];
+                double d2[ChainPricer::block_size];
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const double vol_sqrt_t = vol(i) * f.sqrt_t;
+                    d1[i] = (f.log_fwd - std::log(strike(i))) / vol_sqrt_t + 0.5 * vol_sqrt_t;
+                    d2[i] = d1[i] - vol_sqrt_t;
+                }
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const double s = sign(i);
+                    out(i, s * (f.fwd_df * util::N<double>(s * d1[i]) - strike(i) * f.df * util::N<double>(s * d2[i])));
+                }
+            }
+
+            // price_groups(): idx(j) is the batch index of the j-th option in key order;
+            // one factor computation per run of equal keys, then blocks of strikes
+            template<typename Index>
+            void price_groups(std::span<const option::OptionParams> batch, std::span<double> out, Index idx)
+            {
+                std::size_t begin = 0;
+                while (begin < batch.size())
+                {
+                    const option::OptionParams& head = batch[idx(begin)];
+                    std::size_t end = begin + 1;
+                    while (end < batch.size() && same_key(batch[idx(end)], head)) ++end;
+
+                    const ChainFactors f = ChainFactors::make(head.asset_price, head.exercise_time, head.r, head.cost_of_carry);
+                    for (std::size_t b0 = begin; b0 < end; b0 += ChainPricer::block_size)
+                    {
+                        price_block(f, std::min(ChainPricer::block_size, end - b0),
+                            [&](std::size_t i) { return batch[idx(b0 + i)].strike_price; },
+                            [&](std::size_t i) { return batch[idx(b0 + i)].volatility; },
+                            [&](std::size_t i) { return static_cast<double>(static_cast<int>(batch[idx(b0 + i)].option_type)); },
+                            [&](std::size_t i, double v) { out[idx(b0 + i)] = v; });
+                    }
+                    begin = end;
+                }
+            }
+
+            // scratch: sort permutation of the batch (per thread, reused across calls)
+            std::vector<std::size_t>& scratch_order()
+            {
+                thread_local std::vector<std::size_t> order;
+                return order;
+            }
+        }
+
+        // --- Factors ---
+        ChainFactors ChainFactors::make(double S, double T, double r, double b)
+        {
+            const double df = std::exp(-r * T);
+            return ChainFactors{ std::sqrt(T), df, S * std::exp((b - r) * T), std::log(S) + b * T };
+        }
+
+        // --- Price ---
+        double ChainPricer::price(const option::OptionParams& p) const
+        {
+            double out = 0.0;
+            price(std::span<const option::OptionParams>(&p, 1), std::span<double>(&out, 1));
+            return out;
+        }
+
+        std::vector<double> ChainPricer::price(const std::vector<option::OptionParams>& batch) const
+        {
+            std::vector<double> out(batch.size());
+            price(std::span<const option::OptionParams>(batch), std::span<double>(out));
+            return out;
+        }
+
+        void ChainPricer::price(std::span<const option::OptionParams> batch, std::span<double> out) const
+        {
+            if (out.size() != batch.size())
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            YVAN_PROBE_TIME(price_batch, batch.size());
+
+            // already grouped (sorted by key): direct indexing
+            if (std::is_sorted(batch.begin(), batch.end(), key_less))
+            {
+                price_groups(batch, out, [](std::size_t j) { return j; });
+                return;
+            }
+
+            // otherwise group through a permutation sorted by key
+            std::vector<std::size_t>& order = scratch_order();
+            order.resize(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(),
+                             [&](std::size_t a, std::size_t b) { return key_less(batch[a], batch[b]); });
+            price_groups(batch, out, [&order](std::size_t j) { return order[j]; });
+        }
+
+        // --- Chain API ---
+        void ChainPricer::price_chain(const option::OptionParams& common,
+                                      std::span<const double> strikes,
+                                      std::span<const double> vols,
+                                      std::span<const option::OptionType> types,
+                                      std::span<double> out)
+        {
+            if (vols.size() != strikes.size() || types.size() != strikes.size() || out.size() != strikes.size())
+            {
+                throw std::invalid_argument("Chain columns must all have the same size.");
+            }
+
+            const ChainFactors f = ChainFactors::make(common.asset_price, common.exercise_time, common.r, common.cost_of_carry);
+            for (std::size_t b0 = 0; b0 < strikes.size(); b0 += block_size)
+            {
+                price_block(f, std::min(block_size, strikes.size() - b0),
+                    [&](std::size_t i) { return strikes[b0 + i]; },
+                    [&](std::size_t i) { return vols[b0 + i]; },
+                    [&](std::size_t i) { return static_cast<double>(static_cast<int>(types[b0 + i])); },
+                    [&](std::size_t i, double v) { out[b0 + i] = v; });
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          CurveBSEngine          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the Black-Scholes
+                            engine on discount and dividend curves.
+*/
+
+#include "../../include/engines/CurveBSEngine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace yvan
+{
+    namespace engine
+    {
+        // --- Constructor ---
+        CurveBSEngine::CurveBSEngine(util::DiscountCurve discount, util::DiscountCurve dividend,
+                                     std::span<const double> maturities) :
+            discount_(std::move(discount)), dividend_(std::move(dividend))
+        {
+            prepare(maturities);
+        }
+
+        // --- Curves ---
+        CurveBSEngine::Factors CurveBSEngine::compute_factors(double T) const
+        {
+            // both curves are stored in log space: bT comes without any log
+            const double log_df = discount_.log_discount(T);
+            const double log_carry_df = dividend_.log_discount(T);
+            return Factors{ T, std::sqrt(T), std::exp(log_df), std::exp(log_carry_df), log_carry_df - log_df };
+        }
+
+        void CurveBSEngine::prepare(std::span<const double> maturities)
+        {
+            for (double T : maturities)
+            {
+                auto it = std::lower_bound(cache_.begin(), cache_.end(), T,
+                                           [](const Factors& f, double t) { return f.exercise_time < t; });
+                if (it != cache_.end() && it->exercise_time == T) continue;
+                cache_.insert(it, compute_factors(T));
+            }
+        }
+
+        CurveBSEngine::Factors CurveBSEngine::factors(double T) const
+        {
+            auto it = std::lower_bound(cache_.begin(), cache_.end(), T,
+                                       [](const Factors& f, double t) { return f.exercise_time < t; });
+            if (it != cache_.end() && it->exercise_time == T) return *it;
+            return compute_factors(T);
+        }
+
+        option::OptionParams CurveBSEngine::flat_params(const option::OptionParams& p) const
+        {
+            option::OptionParams q = p;
+            q.r = discount_.zero_rate(p.exercise_time);
+            q.cost_of_carry = q.r - dividend_.zero_rate(p.exercise_time);
+            return q;
+        }
+
+        // --- Price ---
+        double CurveBSEngine::price(const option::OptionParams& p) const
+        {
+            return kernels::bs_price_factors(p.asset_price, p.strike_price, p.volatility, p.option_type,
+                                             factors(p.exercise_time));
+        }
+
+        std::vector<double> CurveBSEngine::price(const std::vector<option::OptionParams>& batch) const
+        {
+            std::vector<double> out(batch.size());
+            price(std::span<const option::OptionParams>(batch), std::span<double>(out));
+            return out;
+        }
+
+        void CurveBSEngine::price(std::span<const option::OptionParams> batch, std::span<double> out) const
+        {
+            if (out.size() != batch.size())
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            YVAN_PROBE_TIME(price_batch, batch.size());
+
+            // chains come grouped by maturity: look the factors up only when T changes
+            Factors f{};
+            bool have_factors = false;
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                const option::OptionParams& p = batch[i];
+                if (!have_factors || p.exercise_time != f.exercise_time)
+                {
+                    f = factors(p.exercise_time);
+                    have_factors = true;
+                }
+                out[i] = kernels::bs_price_factors(p.asset_price, p.strike_price, p.volatility, p.option_type, f);
+            }
+        }
+    }
+}
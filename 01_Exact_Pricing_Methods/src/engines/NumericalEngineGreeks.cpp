@@ -11,41 +11,186 @@
 
 #include "../../include/engines/NumericalEngineGreeks.hpp"
 #include "../../include/engines/IPricer.hpp"
-#include "../../include/engines/BSEngine.hpp"
+#include <algorithm>
+#include <array>
+#include <utility>
 
 namespace yvan
 {
     namespace engine
     {
-        double NumericalEngineGreeks::delta(const option::OptionParams& p) const
+        namespace
         {
-            // We build to configs from the base by modifying the asset price
-            auto p_minus = p; // copy
-            p_minus.asset_price -= h_;
-            auto p_plus = p; // copy
-            p_plus.asset_price += h_;
+            using option::OptionParams;
+
+            // --- Internal Helpers ---
+            // per-thread buffers of the bumped configs and their prices (reused across calls,
+            // so the batch overloads do not allocate once warmed up); taken out of the
+            // thread_local slot while in use, so a pricer that calls back into a
+            // NumericalEngineGreeks batch gets its own
+            struct Scratch
+            {
+                std::vector<OptionParams> scenarios;
+                std::vector<double> values;
+            };
+
+            thread_local Scratch cache;
+
+            // price_points(): the K bumped configs of one config in a single pricer call
+            // bump(q, k) edits the copy q into the k-th point of the stencil
+            template<std::size_t K, typename Bump>
+            std::array<double, K> price_points(const IPricer& pricer, const OptionParams& p, Bump bump)
+            {
+                std::array<OptionParams, K> points;
+                for (std::size_t k = 0; k < K; ++k) { points[k] = p; bump(points[k], k); }
+                std::array<double, K> values;
+                pricer.price(std::span<const OptionParams>(points), std::span<double>(values));
+                return values;
+            }
+
+            // price_stencil(): same for a batch; the K x n bumped configs of a chunk are priced
+            // in one pricer call and combine(i, v) receives the K prices of config i
+            template<std::size_t K, typename Bump, typename Combine>
+            void price_stencil(const IPricer& pricer, std::span<const OptionParams> batch, Bump bump, Combine combine)
+            {
+                const std::size_t chunk = NumericalEngineGreeks::chunk_size;
+                Scratch s = std::move(cache);
+                s.scenarios.resize(K * std::min(batch.size(), chunk));
+                s.values.resize(s.scenarios.size());
+
+                for (std::size_t start = 0; start < batch.size(); start += chunk)
+                {
+                    const std::size_t n = std::min(chunk, batch.size() - start);
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        for (std::size_t k = 0; k < K; ++k)
+                        {
+                            s.scenarios[i * K + k] = batch[start + i];
+                            bump(s.scenarios[i * K + k], k);
+                        }
+                    }
+                    pricer.price(std::span<const OptionParams>(s.scenarios.data(), K * n),
+                                 std::span<double>(s.values.data(), K * n));
+                    for (std::size_t i = 0; i < n; ++i) combine(start + i, &s.values[i * K]);
+                }
+                cache = std::move(s); // an exception of the pricer only loses the buffers
+            }
 
-            // compute price difference with the BSEngine
-            double V_plus = pricer_.price(p_plus);
-            double V_minus = pricer_.price(p_minus);
+            // stencils: points x + h, x - h (first derivative) and x + h, x, x - h (second)
+            auto central(NumericalEngineGreeks::Field x, double h)
+            {
+                return [x, h](OptionParams& q, std::size_t k) { q.*x += (k == 0) ? h : -h; };
+            }
+            auto three_point(NumericalEngineGreeks::Field x, double h)
+            {
+                return [x, h](OptionParams& q, std::size_t k) { if (k != 1) q.*x += (k == 0) ? h : -h; };
+            }
 
-            // return numerical greek
-            return (V_plus - V_minus) / (2.0 * h_);
+            // finite difference formulas on the prices of the stencils
+            double first_difference(const double* v, double h) { return (v[0] - v[1]) / (2.0 * h); }
+            double second_difference(const double* v, double h) { return (v[0] - 2.0 * v[1] + v[2]) / (h * h); }
+        }
+
+        // --- Greeks in the asset price ---
+        double NumericalEngineGreeks::delta(const option::OptionParams& p) const
+        {
+            return derivative(p, &option::OptionParams::asset_price, h_);
         }
 
         double NumericalEngineGreeks::gamma(const option::OptionParams& p) const
         {
-            // edit the two configs
-            auto p_plus = p; p_plus.asset_price += h_;
-            auto p_minus = p; p_minus.asset_price -= h_;
+            return second_derivative(p, &option::OptionParams::asset_price, h_);
+        }
 
-            // compute price difference with the BSEngine
-            double V_plus = pricer_.price(p_plus);
-            double V_mid  = pricer_.price(p);
-            double V_minus = pricer_.price(p_minus);
+        DeltaGamma NumericalEngineGreeks::delta_and_gamma(const option::OptionParams& p) const
+        {
+            // the two outer points serve both Greeks
+            auto v = price_points<3>(pricer_, p, three_point(&option::OptionParams::asset_price, h_));
+            return DeltaGamma{ (v[0] - v[2]) / (2.0 * h_), second_difference(v.data(), h_) };
+        }
+
+        // --- Batch Overloads ---
+        std::vector<double> NumericalEngineGreeks::delta(const std::vector<option::OptionParams>& batch) const
+        {
+            std::vector<double> out(batch.size());
+            delta(std::span<const option::OptionParams>(batch), std::span<double>(out));
+            return out;
+        }
 
-            // return numerical greek
-            return (V_plus - 2.0 * V_mid + V_minus) / (h_ * h_);
+        std::vector<double> NumericalEngineGreeks::gamma(const std::vector<option::OptionParams>& batch) const
+        {
+            std::vector<double> out(batch.size());
+            gamma(std::span<const option::OptionParams>(batch), std::span<double>(out));
+            return out;
+        }
+
+        void NumericalEngineGreeks::delta(std::span<const option::OptionParams> batch, std::span<double> out) const
+        {
+            YVAN_PROBE_TIME(delta_batch, batch.size());
+            derivative(batch, &option::OptionParams::asset_price, out);
+        }
+
+        void NumericalEngineGreeks::gamma(std::span<const option::OptionParams> batch, std::span<double> out) const
+        {
+            YVAN_PROBE_TIME(gamma_batch, batch.size());
+            second_derivative(batch, &option::OptionParams::asset_price, out);
+        }
+
+        void NumericalEngineGreeks::delta_and_gamma(std::span<const option::OptionParams> batch,
+                                                    std::span<double> delta_out, std::span<double> gamma_out) const
+        {
+            check_sizes(batch.size(), delta_out.size());
+            check_sizes(batch.size(), gamma_out.size());
+            const double h = h_;
+            price_stencil<3>(pricer_, batch, three_point(&option::OptionParams::asset_price, h),
+                [&](std::size_t i, const double* v)
+                {
+                    delta_out[i] = (v[0] - v[2]) / (2.0 * h);
+                    gamma_out[i] = second_difference(v, h);
+                });
+        }
+
+        // --- Any Input ---
+        double NumericalEngineGreeks::derivative(const option::OptionParams& p, Field x, double h) const
+        {
+            auto v = price_points<2>(pricer_, p, central(x, h));
+            return first_difference(v.data(), h);
+        }
+
+        double NumericalEngineGreeks::second_derivative(const option::OptionParams& p, Field x, double h) const
+        {
+            auto v = price_points<3>(pricer_, p, three_point(x, h));
+            return second_difference(v.data(), h);
+        }
+
+        double NumericalEngineGreeks::cross_derivative(const option::OptionParams& p, Field x, Field y,
+                                                       double hx, double hy) const
+        {
+            // corners (+,+), (+,-), (-,+), (-,-)
+            auto v = price_points<4>(pricer_, p, [x, y, hx, hy](option::OptionParams& q, std::size_t k)
+            {
+                q.*x += (k < 2) ? hx : -hx;
+                q.*y += (k % 2 == 0) ? hy : -hy;
+            });
+            return (v[0] - v[1] - v[2] + v[3]) / (4.0 * hx * hy);
+        }
+
+        void NumericalEngineGreeks::derivative(std::span<const option::OptionParams> batch, Field x,
+                                               std::span<double> out) const
+        {
+            check_sizes(batch.size(), out.size());
+            const double h = h_;
+            price_stencil<2>(pricer_, batch, central(x, h),
+                [&](std::size_t i, const double* v) { out[i] = first_difference(v, h); });
+        }
+
+        void NumericalEngineGreeks::second_derivative(std::span<const option::OptionParams> batch, Field x,
+                                                      std::span<double> out) const
+        {
+            check_sizes(batch.size(), out.size());
+            const double h = h_;
+            price_stencil<3>(pricer_, batch, three_point(x, h),
+                [&](std::size_t i, const double* v) { out[i] = second_difference(v, h); });
         }
     }
-}
\ No newline at end of file
+}
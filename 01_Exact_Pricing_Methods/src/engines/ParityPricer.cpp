@@ -0,0 +1,205 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          ParityPricer           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the parity-based
+                            batch pricing decorator.
+*/
+
+#include "../../include/engines/ParityPricer.hpp"
+#include "../../include/util/parity.hpp"
+#include "../../include/util/pricing_cache.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace engine
+    {
+        namespace
+        {
+            constexpr std::size_t none = static_cast<std::size_t>(-1);
+            constexpr std::size_t lookahead = 16; // prefetch distance of the hash join (entries)
+
+            // prefetch(): hint the cache line of a table slot
+            inline void prefetch(const void* p)
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(p);
+#else
+                (void)p;
+#endif
+            }
+
+            // one entry of the table: the hash is kept inline so that most probes
+            // are resolved without touching the (randomly placed) batch entry
+            struct Slot
+            {
+                std::uint64_t hash;
+                std::size_t index; // none: empty slot
+            };
+
+            // per-thread buffers (reused across calls; taken out of the thread_local slot
+            // while in use, so a wrapped engine that is itself a ParityPricer gets its own)
+            struct Scratch
+            {
+                std::vector<std::uint64_t> hashes; // pairing key hash of every option left unpaired
+                std::vector<Slot> table;           // open addressing table of the calls
+                std::vector<std::size_t> partner;  // index of the other leg, none if unpaired
+                std::vector<std::size_t> priced;   // batch indices sent to the engine
+                std::vector<option::OptionParams> legs;
+                std::vector<double> values;
+            };
+
+            thread_local Scratch cache;
+
+            // as_call(): the pairing key of a put is its call twin
+            option::OptionParams as_call(option::OptionParams p)
+            {
+                p.option_type = option::OptionType::Call;
+                return p;
+            }
+
+            // twins(): a call and a put of the same config (bitwise, as the hash join)
+            bool twins(const option::OptionParams& a, const option::OptionParams& b)
+            {
+                return a.option_type != b.option_type && util::same_params(as_call(a), as_call(b));
+            }
+        }
+
+        std::vector<double> ParityPricer::price(const std::vector<option::OptionParams>& batch) const
+        {
+            std::vector<double> out(batch.size());
+            price(std::span<const option::OptionParams>(batch), std::span<double>(out));
+            return out;
+        }
+
+        void ParityPricer::price(std::span<const option::OptionParams> batch, std::span<double> out) const
+        {
+            if (out.size() != batch.size())
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            YVAN_PROBE_TIME(price_batch, batch.size());
+
+            const std::size_t n = batch.size();
+            Scratch s = std::move(cache);
+
+            // --- 1. chain order: the legs of a pair next to each other, no hashing ---
+            s.partner.assign(n, none);
+            std::size_t n_calls = 0, n_paired = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                n_calls += batch[i].option_type == option::OptionType::Call;
+                if (i + 1 < n && twins(batch[i], batch[i + 1]))
+                {
+                    s.partner[i] = i + 1;
+                    s.partner[i + 1] = i;
+                    n_calls += batch[i + 1].option_type == option::OptionType::Call;
+                    n_paired += 2;
+                    ++i;
+                }
+            }
+            const std::size_t left_calls = n_calls - n_paired / 2;
+            const std::size_t left_puts = n - n_paired - left_calls;
+
+            // --- 2. hash join of the options left, if both types are left ---
+            // a put is hashed as its call twin (bitwise, see util::hash_params). The table is
+            // far larger than the caches on big books, so the slot of the entry `lookahead`
+            // iterations ahead is prefetched to overlap the misses
+            if (left_calls != 0 && left_puts != 0)
+            {
+                s.hashes.resize(n);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    s.hashes[i] = s.partner[i] == none ? util::hash_params(as_call(batch[i])) : 0;
+                }
+
+                // table of the unpaired calls
+                const std::size_t capacity = std::bit_ceil(std::max<std::size_t>(2 * left_calls, 16));
+                const std::size_t mask = capacity - 1;
+                s.table.assign(capacity, Slot{ 0, none });
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    if (i + lookahead < n) prefetch(&s.table[s.hashes[i + lookahead] & mask]);
+                    if (s.partner[i] != none || batch[i].option_type != option::OptionType::Call) continue;
+                    std::size_t slot = s.hashes[i] & mask;
+                    while (s.table[slot].index != none) slot = (slot + 1) & mask; // duplicates get their own slot
+                    s.table[slot] = Slot{ s.hashes[i], i };
+                }
+
+                // every unpaired put takes the first free call with the same config
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    if (i + lookahead < n) prefetch(&s.table[s.hashes[i + lookahead] & mask]);
+                    if (s.partner[i] != none || batch[i].option_type != option::OptionType::Put) continue;
+                    const option::OptionParams key = as_call(batch[i]);
+                    const std::uint64_t h = s.hashes[i];
+                    for (std::size_t slot = h & mask; s.table[slot].index != none; slot = (slot + 1) & mask)
+                    {
+                        const std::size_t c = s.table[slot].index;
+                        if (s.table[slot].hash == h && s.partner[c] == none && util::same_params(batch[c], key))
+                        {
+                            s.partner[c] = i;
+                            s.partner[i] = c;
+                            break;
+                        }
+                    }
+                }
+            }
+            else if (n_paired == 0) // nothing to pair
+            {
+                cache = std::move(s);
+                pricer_.price(batch, out);
+                return;
+            }
+
+            // --- 3. one engine call for the unpaired options and the OTM leg of every pair ---
+            s.priced.clear();
+            s.legs.clear();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const option::OptionParams& p = batch[i];
+                const bool call_otm = p.strike_price >= p.asset_price;
+                const bool is_call = p.option_type == option::OptionType::Call;
+                if (s.partner[i] == none || call_otm == is_call)
+                {
+                    s.priced.push_back(i);
+                    s.legs.push_back(p);
+                }
+            }
+            s.values.resize(s.legs.size());
+            pricer_.price(std::span<const option::OptionParams>(s.legs), std::span<double>(s.values));
+            for (std::size_t j = 0; j < s.priced.size(); ++j) out[s.priced[j]] = s.values[j];
+
+            // --- 4. the other legs from the parity: C - P = S e^((b-r)T) - K e^(-rT) ---
+            // the discount factors only change with (r, b, T): in a chain they are
+            // computed once per maturity instead of two exps per pair
+            double r = std::numeric_limits<double>::quiet_NaN(), b = r, T = r; // NaN: no match
+            double df = 0.0, carry_df = 0.0;
+            for (std::size_t j = 0; j < s.priced.size(); ++j)
+            {
+                const std::size_t i = s.priced[j];
+                const std::size_t other = s.partner[i];
+                if (other == none) continue;
+                const option::OptionParams& p = batch[i];
+                if (p.r != r || p.cost_of_carry != b || p.exercise_time != T)
+                {
+                    r = p.r; b = p.cost_of_carry; T = p.exercise_time;
+                    df = std::exp(-r * T);
+                    carry_df = std::exp((b - r) * T);
+                }
+                const double c_minus_p = p.asset_price * carry_df - p.strike_price * df;
+                out[other] = (p.option_type == option::OptionType::Call) ? out[i] - c_minus_p
+                                                                         : out[i] + c_minus_p;
+            }
+            cache = std::move(s); // an exception of the engine only loses the buffers
+        }
+    }
+}
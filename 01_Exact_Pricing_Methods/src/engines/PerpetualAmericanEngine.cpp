@@ -10,53 +10,20 @@
 */
 
 #include "../../include/engines/PerpetualAmericanEngine.hpp"
-#include "../../include/options/Option.hpp"
-
-#include <cmath>
+#include "../../include/engines/Kernels.hpp"
 
 namespace yvan
 {
     namespace engine
     {
-        // --- Internal Helpers ---
-        // a1 and a2 calculations (roughly analogous to y1 and y2 but different)
-        // a1()
-        double PerpetualAmericanEngine::a1(const option::OptionParams& p) const
-        {
-            return 0.5 - (p.cost_of_carry / (p.volatility * p.volatility));
-        }
-
-        // a2()
-        double PerpetualAmericanEngine::a2(const option::OptionParams& p) const
-        {
-            double sigma_sq = (p.volatility * p.volatility);
-            double m1 = ((p.cost_of_carry / sigma_sq) - 0.5);
-            double m2 = 2.0 * p.r / sigma_sq;
-            return std::sqrt(m1 * m1 + m2);
-        }
-
-        // y1 = a1 + a2
-        // y2 = a1 - a2
-
         // --- Price ---
+        // the closed-form formula (with the a1, a2 helpers where
+        // y1 = a1 + a2 and y2 = a1 - a2) lives in Kernels.hpp
+        // (kernels::perpetual_american_price) so that the
+        // devirtualized batch path can inline it
         double PerpetualAmericanEngine::price(const option::OptionParams& p) const
         {
-            // retrieve the sign based on option type
-            int sign = static_cast<int>(p.option_type);
-
-            // compute the appropriate y (either y1 or y2)
-            double y = a1(p) + sign * a2(p);
-
-            // compute appropriate first member
-            double m1 = p.strike_price / (sign * (y - 1));
-
-            // compute second member
-            double m2 = std::pow(((y - 1) * p.asset_price) / (y * p.strike_price), y);
-
-            // return price
-            return m1 * m2;
+            return price_kernel(p);
         }
-
-
     }
-}
\ No newline at end of file
+}
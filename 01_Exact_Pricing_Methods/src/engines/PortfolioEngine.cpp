@@ -0,0 +1,154 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |         PortfolioEngine         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the aggregation
+                            of the value and Greeks of a Portfolio.
+*/
+
+#include "../../include/engines/PortfolioEngine.hpp"
+#include "../../include/engines/Kernels.hpp"
+#include "../../include/util/dual.hpp"
+#include "../../include/util/summation.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace engine
+    {
+        namespace
+        {
+            // compensated sums of value, delta and gamma
+            struct TotalsSum
+            {
+                util::NeumaierSum value, delta, gamma;
+
+                void add(const RiskTotals& x)
+                {
+                    value.add(x.value); delta.add(x.delta); gamma.add(x.gamma);
+                }
+                void add(const TotalsSum& other)
+                {
+                    value.add(other.value); delta.add(other.delta); gamma.add(other.gamma);
+                }
+                RiskTotals result() const { return RiskTotals{ value.value(), delta.value(), gamma.value() }; }
+            };
+
+            // reduction of one chunk
+            struct ChunkSum
+            {
+                TotalsSum total;
+                std::vector<TotalsSum> by_expiry;
+                std::vector<TotalsSum> by_strike;
+            };
+
+            void check_edges(std::span<const double> edges)
+            {
+                for (std::size_t k = 1; k < edges.size(); ++k)
+                {
+                    if (!(edges[k - 1] < edges[k]))
+                    {
+                        throw std::invalid_argument("Bucket edges must be strictly increasing.");
+                    }
+                }
+            }
+        }
+
+        // --- Constructor ---
+        PortfolioEngine::PortfolioEngine(std::size_t n_threads, std::size_t chunk_size) :
+            n_threads_(std::max<std::size_t>(1, n_threads)), chunk_size_(std::max<std::size_t>(1, chunk_size)) {}
+
+        // --- Helpers ---
+        RiskTotals PortfolioEngine::position_risk(const option::OptionParams& p, option::OptionStyle style)
+        {
+            if (style == option::OptionStyle::European)
+            {
+                return RiskTotals{ kernels::bs_price(p), kernels::bs_delta(p), kernels::bs_gamma(p) };
+            }
+
+            // perpetual American: no closed form Greeks, one pass on a dual of a dual in S
+            using D1 = util::Dual<double, 1>;
+            using D2 = util::Dual<D1, 1>;
+            option::BasicOptionParams<D2> q{ D2{ D1::variable(p.asset_price, 0), { D1{ 1.0 } } },
+                                             D2{ p.strike_price }, D2{ p.r }, D2{ p.cost_of_carry },
+                                             D2{ p.volatility }, D2{ p.exercise_time }, p.option_type };
+            D2 v = kernels::perpetual_american_price(q);
+            return RiskTotals{ v.v.v, v.v.d[0], v.d[0].d[0] };
+        }
+
+        std::size_t PortfolioEngine::bucket_of(std::span<const double> edges, double x)
+        {
+            return static_cast<std::size_t>(std::upper_bound(edges.begin(), edges.end(), x) - edges.begin());
+        }
+
+        // --- Aggregation ---
+        PortfolioRisk PortfolioEngine::aggregate(const option::Portfolio& book,
+                                                 std::span<const double> expiry_edges,
+                                                 std::span<const double> strike_edges) const
+        {
+            check_edges(expiry_edges);
+            check_edges(strike_edges);
+
+            const std::size_t n = book.size();
+            const std::size_t n_chunks = (n + chunk_size_ - 1) / chunk_size_;
+            std::vector<ChunkSum> partials(n_chunks);
+
+            const auto& S = book.asset_prices();
+            const auto& K = book.strike_prices();
+            const auto& r = book.rates();
+            const auto& b = book.costs_of_carry();
+            const auto& sigma = book.volatilities();
+            const auto& T = book.exercise_times();
+            const auto& type = book.option_types();
+            const auto& style = book.styles();
+            const auto& quantity = book.quantities();
+
+            // threads take blocks of chunks; a chunk always covers the same positions
+            util::parallel_for(n_chunks, n_threads_, [&](std::size_t c_begin, std::size_t c_end)
+            {
+                for (std::size_t c = c_begin; c < c_end; ++c)
+                {
+                    ChunkSum& part = partials[c];
+                    part.by_expiry.resize(expiry_edges.size() + 1);
+                    part.by_strike.resize(strike_edges.size() + 1);
+
+                    const std::size_t end = std::min(n, (c + 1) * chunk_size_);
+                    for (std::size_t i = c * chunk_size_; i < end; ++i)
+                    {
+                        const option::OptionParams p{ S[i], K[i], r[i], b[i], sigma[i], T[i], type[i] };
+                        RiskTotals x = position_risk(p, style[i]);
+                        x.value *= quantity[i];
+                        x.delta *= quantity[i];
+                        x.gamma *= quantity[i];
+
+                        part.total.add(x);
+                        part.by_expiry[bucket_of(expiry_edges, T[i])].add(x);
+                        part.by_strike[bucket_of(strike_edges, K[i])].add(x);
+                    }
+                }
+            });
+
+            // merge the chunks in order
+            TotalsSum total;
+            std::vector<TotalsSum> by_expiry(expiry_edges.size() + 1);
+            std::vector<TotalsSum> by_strike(strike_edges.size() + 1);
+            for (const ChunkSum& part : partials)
+            {
+                total.add(part.total);
+                for (std::size_t k = 0; k < by_expiry.size(); ++k) by_expiry[k].add(part.by_expiry[k]);
+                for (std::size_t k = 0; k < by_strike.size(); ++k) by_strike[k].add(part.by_strike[k]);
+            }
+
+            PortfolioRisk out;
+            out.total = total.result();
+            out.expiry_edges.assign(expiry_edges.begin(), expiry_edges.end());
+            out.strike_edges.assign(strike_edges.begin(), strike_edges.end());
+            for (const auto& s : by_expiry) out.by_expiry.push_back(s.result());
+            for (const auto& s : by_strike) out.by_strike.push_back(s.result());
+            return out;
+        }
+    }
+}
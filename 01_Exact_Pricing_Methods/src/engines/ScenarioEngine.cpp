@@ -0,0 +1,143 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          ScenarioEngine         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the scenario /
+                            stress engine.
+*/
+
+#include "../../include/engines/ScenarioEngine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace engine
+    {
+        // --- Scenarios ---
+        option::OptionParams apply_scenario(const option::OptionParams& p, const Scenario& s)
+        {
+            option::OptionParams q = p;
+            q.asset_price *= 1.0 + s.spot_shock;
+            q.volatility = std::max(p.volatility + s.vol_shift, ScenarioEngine::min_volatility);
+            q.r += s.rate_shift;
+            q.cost_of_carry += s.rate_shift;
+            return q;
+        }
+
+        double quantile(std::vector<double> sample, double prob)
+        {
+            if (sample.empty())
+            {
+                throw std::invalid_argument("Cannot take the quantile of an empty sample.");
+            }
+            if (!(prob >= 0.0 && prob <= 1.0))
+            {
+                throw std::invalid_argument("Quantile level must be in [0, 1].");
+            }
+
+            // position h in the sorted sample, only the two neighbours are selected (O(n))
+            const double h = prob * static_cast<double>(sample.size() - 1);
+            const std::size_t lo = static_cast<std::size_t>(std::floor(h));
+            std::nth_element(sample.begin(), sample.begin() + lo, sample.end());
+            const double x_lo = sample[lo];
+            if (lo + 1 == sample.size()) return x_lo;
+            const double x_hi = *std::min_element(sample.begin() + lo + 1, sample.end());
+            return x_lo + (h - static_cast<double>(lo)) * (x_hi - x_lo);
+        }
+
+        // --- Constructor ---
+        ScenarioEngine::ScenarioEngine(const IPricer& pricer, std::size_t n_threads,
+                                       std::size_t tile_positions, std::size_t tile_scenarios) :
+            pricer_(pricer), n_threads_(std::max<std::size_t>(1, n_threads)),
+            tile_positions_(std::max<std::size_t>(1, tile_positions)),
+            tile_scenarios_(std::max<std::size_t>(1, tile_scenarios)) {}
+
+        // --- Scenario P&L ---
+        std::vector<double> ScenarioEngine::pnl(std::span<const option::OptionParams> positions,
+                                                std::span<const double> quantities,
+                                                std::span<const Scenario> scenarios) const
+        {
+            double base_value = 0.0;
+            return evaluate(positions, quantities, scenarios, base_value);
+        }
+
+        ScenarioReport ScenarioEngine::run(std::span<const option::OptionParams> positions,
+                                           std::span<const double> quantities,
+                                           std::span<const Scenario> scenarios,
+                                           std::span<const double> probabilities) const
+        {
+            ScenarioReport report;
+            report.pnl = evaluate(positions, quantities, scenarios, report.base_value);
+            report.probabilities.assign(probabilities.begin(), probabilities.end());
+            report.quantiles.reserve(probabilities.size());
+            for (double prob : probabilities) report.quantiles.push_back(quantile(report.pnl, prob));
+            return report;
+        }
+
+        std::vector<double> ScenarioEngine::evaluate(std::span<const option::OptionParams> positions,
+                                                     std::span<const double> quantities,
+                                                     std::span<const Scenario> scenarios,
+                                                     double& base_value) const
+        {
+            // Validate inputs
+            if (positions.size() != quantities.size())
+            {
+                throw std::invalid_argument("Positions and quantities must have the same size.");
+            }
+
+            const std::size_t n_positions = positions.size();
+            std::vector<double> out(scenarios.size(), 0.0);
+
+            // unshocked prices, once for all the scenarios
+            std::vector<double> base(n_positions);
+            pricer_.price(positions, std::span<double>(base));
+            base_value = 0.0;
+            for (std::size_t i = 0; i < n_positions; ++i) base_value += quantities[i] * base[i];
+            if (n_positions == 0) return out;
+
+            // every thread owns a contiguous range of scenarios (and of out)
+            util::parallel_for(scenarios.size(), n_threads_, [&](std::size_t s_begin, std::size_t s_end)
+            {
+                std::vector<option::OptionParams> tile(tile_positions_ * tile_scenarios_);
+                std::vector<double> values(tile.size());
+
+                for (std::size_t s0 = s_begin; s0 < s_end; s0 += tile_scenarios_)
+                {
+                    const std::size_t ns = std::min(tile_scenarios_, s_end - s0);
+                    for (std::size_t p0 = 0; p0 < n_positions; p0 += tile_positions_)
+                    {
+                        const std::size_t np = std::min(tile_positions_, n_positions - p0);
+
+                        // generate the tile (row j: scenario s0 + j, col i: position p0 + i)
+                        for (std::size_t j = 0; j < ns; ++j)
+                        {
+                            for (std::size_t i = 0; i < np; ++i)
+                            {
+                                tile[j * np + i] = apply_scenario(positions[p0 + i], scenarios[s0 + j]);
+                            }
+                        }
+                        pricer_.price(std::span<const option::OptionParams>(tile.data(), ns * np),
+                                      std::span<double>(values.data(), ns * np));
+
+                        // positions are always summed in the same order (independent of the threads)
+                        for (std::size_t j = 0; j < ns; ++j)
+                        {
+                            double acc = 0.0;
+                            for (std::size_t i = 0; i < np; ++i)
+                            {
+                                acc += quantities[p0 + i] * (values[j * np + i] - base[p0 + i]);
+                            }
+                            out[s0 + j] += acc;
+                        }
+                    }
+                }
+            });
+
+            return out;
+        }
+    }
+}
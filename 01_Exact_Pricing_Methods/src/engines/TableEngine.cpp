@@ -0,0 +1,426 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |           TableEngine           |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This cpp file implements the interpolated
+                            price / Greek tables.
+*/
+
+#include "../../include/engines/TableEngine.hpp"
+#include "../../include/util/param_grid.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace yvan
+{
+    namespace engine
+    {
+        namespace
+        {
+            using Field = double option::OptionParams::*;
+
+            // factor between the fourth differences of the nodes and the bound used for
+            // the fourth derivative over a stencil (see build())
+            constexpr double derivative_safety = 2.0;
+
+            // Nodes of one axis and the Lagrange weights of its 4-point stencils
+            struct Axis
+            {
+                Field field{};
+                std::vector<double> nodes;                  // increasing (from util::mesh_vector)
+                double inv_step{};                          // 1 / (nodes[1] - nodes[0])
+                std::vector<std::array<double, 4>> inv_den; // 1 / prod_{m != k} (x_k - x_m) per stencil
+
+                Axis() = default;
+                Axis(Field f, std::vector<double> x) : field(f), nodes(std::move(x))
+                {
+                    inv_step = 1.0 / (nodes[1] - nodes[0]);
+                    inv_den.resize(nodes.size() - 3);
+                    for (std::size_t s = 0; s < inv_den.size(); ++s)
+                    {
+                        for (std::size_t k = 0; k < 4; ++k)
+                        {
+                            double den = 1.0;
+                            for (std::size_t m = 0; m < 4; ++m)
+                            {
+                                if (m != k) den *= nodes[s + k] - nodes[s + m];
+                            }
+                            inv_den[s][k] = 1.0 / den;
+                        }
+                    }
+                }
+
+                // stencil(): first node and weights of the 4 nodes around x
+                // false if x is outside the axis (or NaN)
+                bool stencil(double x, std::size_t& start, double w[4]) const
+                {
+                    const std::size_t n = nodes.size();
+                    if (!(x >= nodes.front() && x <= nodes.back())) return false;
+
+                    // cell [nodes[i], nodes[i + 1]] containing x (the mesh is uniform up to
+                    // rounding, except a possibly longer last step)
+                    std::size_t i = std::min(static_cast<std::size_t>((x - nodes.front()) * inv_step), n - 2);
+                    while (i > 0 && x < nodes[i]) --i;
+                    while (i < n - 2 && x > nodes[i + 1]) ++i;
+
+                    // centred stencil (i - 1 .. i + 2), shifted inwards at the edges
+                    start = std::min(std::max<std::size_t>(i, 1) - 1, n - 4);
+                    const double* x_k = &nodes[start];
+                    const std::array<double, 4>& c = inv_den[start];
+                    const double d0 = x - x_k[0], d1 = x - x_k[1], d2 = x - x_k[2], d3 = x - x_k[3];
+                    w[0] = d1 * d2 * d3 * c[0];
+                    w[1] = d0 * d2 * d3 * c[1];
+                    w[2] = d0 * d1 * d3 * c[2];
+                    w[3] = d0 * d1 * d2 * c[3];
+                    return true;
+                }
+            };
+
+            // Location of one query in the table
+            struct Stencil
+            {
+                std::size_t sx{}, sy{};
+                double wx[4]{}, wy[4]{};
+            };
+
+            // max_unimodal(): max of f over [a, b] when f has a single interior maximum
+            // (ternary search)
+            template<typename F>
+            double max_unimodal(F f, double a, double b)
+            {
+                for (int k = 0; k < 100; ++k)
+                {
+                    const double m1 = a + (b - a) / 3.0, m2 = b - (b - a) / 3.0;
+                    if (f(m1) < f(m2)) a = m1; else b = m2;
+                }
+                return f(0.5 * (a + b));
+            }
+
+            // Remainder factors of one cell of an axis, for x in the cell:
+            //   omega    = max |prod_k (x - x_k)| / 24 (x_k: the 4 nodes of its stencil),
+            //              the error of a cubic is at most omega * max |f''''|
+            //   lebesgue = max sum_k |w_k(x)|, the growth of an error on the nodes
+            // both functions have a single maximum inside the cell
+            struct CellFactors
+            {
+                std::size_t start{};
+                double omega{};
+                double lebesgue{};
+            };
+
+            std::vector<CellFactors> cell_factors(const Axis& axis)
+            {
+                std::vector<CellFactors> out(axis.nodes.size() - 1);
+                for (std::size_t i = 0; i < out.size(); ++i)
+                {
+                    const double a = axis.nodes[i], b = axis.nodes[i + 1];
+                    double w[4];
+                    axis.stencil(0.5 * (a + b), out[i].start, w);
+                    const double* x_k = &axis.nodes[out[i].start];
+                    out[i].omega = max_unimodal([&](double x)
+                    {
+                        return std::abs((x - x_k[0]) * (x - x_k[1]) * (x - x_k[2]) * (x - x_k[3]));
+                    }, a, b) / 24.0;
+                    out[i].lebesgue = std::max(1.0, max_unimodal([&](double x)
+                    {
+                        std::size_t s;
+                        double v[4];
+                        axis.stencil(x, s, v);
+                        return std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]) + std::abs(v[3]);
+                    }, a, b));
+                }
+                return out;
+            }
+
+            // fourth_derivative(): 24 f[x_0, ..., x_4], the fourth derivative of f at some
+            // point of [x_0, x_4] (stride: distance between the values in f)
+            double fourth_derivative(const double* x, const double* f, std::size_t stride)
+            {
+                double d[5];
+                for (std::size_t k = 0; k < 5; ++k) d[k] = f[k * stride];
+                for (std::size_t k = 1; k < 5; ++k)
+                {
+                    for (std::size_t m = 4; m >= k; --m) d[m] = (d[m] - d[m - 1]) / (x[m] - x[m - k]);
+                }
+                return 24.0 * d[4];
+            }
+
+            // error_bound(): max over the cells of the bicubic remainder
+            //   |f - P_x P_y f| <= omega_x * M_x + lebesgue_x * omega_y * M_y
+            // where M_x bounds |d^4 f / dx^4| over the x stencil, on the 4 lines of the
+            // y stencil (and the same for M_y). Each window of 5 nodes gives the fourth
+            // derivative at one point of it; its change to the next window, the change
+            // over one step. M is derivative_safety times the largest of |value| + |change|
+            // over the windows that contain the stencil
+            double error_bound(const util::Grid2D<double>& g, const Axis& x, const Axis& y,
+                               const std::vector<CellFactors>& cx, const std::vector<CellFactors>& cy)
+            {
+                const std::size_t nx = x.nodes.size(), ny = y.nodes.size();
+
+                // fourth derivatives of every window, then |value| + |change| in place
+                util::Grid2D<double> mx(nx - 4, ny), my(nx, ny - 4);
+                for (std::size_t w = 0; w + 4 < nx; ++w)
+                {
+                    for (std::size_t j = 0; j < ny; ++j) mx(w, j) = fourth_derivative(&x.nodes[w], &g(w, j), ny);
+                }
+                for (std::size_t i = 0; i < nx; ++i)
+                {
+                    for (std::size_t w = 0; w + 4 < ny; ++w) my(i, w) = fourth_derivative(&y.nodes[w], &g(i, w), 1);
+                }
+                auto local_bounds = [](double* d, std::size_t n, std::size_t stride)
+                {
+                    double previous = d[0];
+                    for (std::size_t w = 0; w < n; ++w)
+                    {
+                        const double value = d[w * stride];
+                        double change = std::abs(value - previous);
+                        if (w + 1 < n) change = std::max(change, std::abs(d[(w + 1) * stride] - value));
+                        previous = value;
+                        d[w * stride] = std::abs(value) + change;
+                    }
+                };
+                for (std::size_t j = 0; j < ny; ++j) local_bounds(&mx(0, j), nx - 4, ny);
+                for (std::size_t i = 0; i < nx; ++i) local_bounds(&my(i, 0), ny - 4, 1);
+
+                // windows of 5 nodes containing the 4 nodes of a stencil starting at s
+                auto windows = [](std::size_t s, std::size_t n, std::size_t& first, std::size_t& last)
+                {
+                    first = std::min(std::max<std::size_t>(s, 1) - 1, n - 5);
+                    last = std::min(s, n - 5);
+                };
+
+                double bound = 0.0;
+                for (std::size_t i = 0; i < cx.size(); ++i)
+                {
+                    std::size_t wx0, wx1;
+                    windows(cx[i].start, nx, wx0, wx1);
+                    for (std::size_t j = 0; j < cy.size(); ++j)
+                    {
+                        std::size_t wy0, wy1;
+                        windows(cy[j].start, ny, wy0, wy1);
+                        double m_x = 0.0, m_y = 0.0;
+                        for (std::size_t k = 0; k < 4; ++k)
+                        {
+                            for (std::size_t w = wx0; w <= wx1; ++w) m_x = std::max(m_x, mx(w, cy[j].start + k));
+                            for (std::size_t w = wy0; w <= wy1; ++w) m_y = std::max(m_y, my(cx[i].start + k, w));
+                        }
+                        const double e = cx[i].omega * derivative_safety * m_x
+                                       + cx[i].lebesgue * cy[j].omega * derivative_safety * m_y;
+                        bound = std::max(bound, e);
+                    }
+                }
+                return bound;
+            }
+
+            // interpolate(): tensor product of the 4 x 4 nodes of the stencil
+            double interpolate(const util::Grid2D<double>& g, const Stencil& st)
+            {
+                double v = 0.0;
+                for (std::size_t a = 0; a < 4; ++a)
+                {
+                    const double* row = &g.data[(st.sx + a) * g.ncols + st.sy];
+                    v += st.wx[a] * (st.wy[0] * row[0] + st.wy[1] * row[1] + st.wy[2] * row[2] + st.wy[3] * row[3]);
+                }
+                return v;
+            }
+        }
+
+        // --- Table ---
+        struct TableEngine::Table
+        {
+            TableSpec spec;
+            Axis x, y;
+            util::Grid2D<double> prices, deltas, gammas;
+            TableErrorBounds bounds;
+
+            // find(): true if p is on the table (same config off the axes, inside the axes)
+            bool find(const option::OptionParams& p, Stencil& st) const
+            {
+                option::OptionParams q = p;
+                q.*x.field = spec.base.*x.field;
+                q.*y.field = spec.base.*y.field;
+                const option::OptionParams& b = spec.base;
+                if (q.asset_price != b.asset_price || q.strike_price != b.strike_price || q.r != b.r
+                    || q.cost_of_carry != b.cost_of_carry || q.volatility != b.volatility
+                    || q.exercise_time != b.exercise_time || q.option_type != b.option_type)
+                {
+                    return false;
+                }
+                return x.stencil(p.*x.field, st.sx, st.wx) && y.stencil(p.*y.field, st.sy, st.wy);
+            }
+        };
+
+        // --- Constructor & Destructor ---
+        TableEngine::TableEngine(const IPricer& pricer, const IGreeks& greeks, const TableSpec& spec)
+            : pricer_(pricer), greeks_(greeks), table_(build(pricer, greeks, spec))
+        {
+        }
+
+        TableEngine::~TableEngine()
+        {
+            // the rebuilds in flight use this engine
+            std::lock_guard<std::mutex> lock(rebuilds_mutex_);
+            for (auto& r : rebuilds_) r.wait();
+        }
+
+        // --- Price ---
+        double TableEngine::price(const option::OptionParams& p) const
+        {
+            const std::shared_ptr<const Table> t = table_.load(std::memory_order_acquire);
+            Stencil st;
+            return t->find(p, st) ? interpolate(t->prices, st) : pricer_.price(p);
+        }
+
+        std::vector<double> TableEngine::price(const std::vector<option::OptionParams>& batch) const
+        {
+            std::vector<double> out(batch.size());
+            price(std::span<const option::OptionParams>(batch), std::span<double>(out));
+            return out;
+        }
+
+        void TableEngine::price(std::span<const option::OptionParams> batch, std::span<double> out) const
+        {
+            if (out.size() != batch.size())
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            YVAN_PROBE_TIME(price_batch, batch.size());
+            const std::shared_ptr<const Table> t = table_.load(std::memory_order_acquire);
+            Stencil st;
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                out[i] = t->find(batch[i], st) ? interpolate(t->prices, st) : pricer_.price(batch[i]);
+            }
+        }
+
+        // --- Greeks ---
+        double TableEngine::delta(const option::OptionParams& p) const
+        {
+            const std::shared_ptr<const Table> t = table_.load(std::memory_order_acquire);
+            Stencil st;
+            return t->find(p, st) ? interpolate(t->deltas, st) : greeks_.delta(p);
+        }
+
+        double TableEngine::gamma(const option::OptionParams& p) const
+        {
+            const std::shared_ptr<const Table> t = table_.load(std::memory_order_acquire);
+            Stencil st;
+            return t->find(p, st) ? interpolate(t->gammas, st) : greeks_.gamma(p);
+        }
+
+        TableQuote TableEngine::quote(const option::OptionParams& p) const
+        {
+            const std::shared_ptr<const Table> t = table_.load(std::memory_order_acquire);
+            Stencil st;
+            if (!t->find(p, st)) return TableQuote{ pricer_.price(p), greeks_.delta(p), greeks_.gamma(p) };
+            return TableQuote{ interpolate(t->prices, st), interpolate(t->deltas, st), interpolate(t->gammas, st) };
+        }
+
+        // --- Table ---
+        bool TableEngine::covers(const option::OptionParams& p) const
+        {
+            Stencil st;
+            return table_.load(std::memory_order_acquire)->find(p, st);
+        }
+
+        TableErrorBounds TableEngine::error_bounds() const
+        {
+            return table_.load(std::memory_order_acquire)->bounds;
+        }
+
+        TableSpec TableEngine::spec() const
+        {
+            return table_.load(std::memory_order_acquire)->spec;
+        }
+
+        void TableEngine::rebuild(const TableSpec& spec)
+        {
+            // built aside: lookups keep using the current table until the swap
+            table_.store(build(pricer_, greeks_, spec), std::memory_order_release);
+        }
+
+        std::future<void> TableEngine::rebuild_async(const TableSpec& spec)
+        {
+            // the caller's future is fed by a promise; the engine keeps the task's own
+            // future to wait for it on destruction
+            auto done = std::make_shared<std::promise<void>>();
+            std::future<void> out = done->get_future();
+            std::lock_guard<std::mutex> lock(rebuilds_mutex_);
+            std::erase_if(rebuilds_, [](const std::future<void>& r)
+            {
+                return r.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+            rebuilds_.push_back(std::async(std::launch::async, [this, spec, done]
+            {
+                try
+                {
+                    rebuild(spec);
+                    done->set_value();
+                }
+                catch (...)
+                {
+                    done->set_exception(std::current_exception());
+                }
+            }));
+            return out;
+        }
+
+        // --- Build ---
+        std::shared_ptr<const TableEngine::Table>
+        TableEngine::build(const IPricer& pricer, const IGreeks& greeks, const TableSpec& spec)
+        {
+            // Validate inputs
+            if (spec.field_x == nullptr || spec.field_y == nullptr || spec.field_x == spec.field_y)
+            {
+                throw std::invalid_argument("Table axes must be two different fields.");
+            }
+            if (spec.tolerance < 0.0)
+            {
+                throw std::invalid_argument("Table tolerance must be non-negative.");
+            }
+
+            const util::Grid2D<option::OptionParams> grid =
+                util::sweep_2d(spec.base, spec.field_x, spec.start_x, spec.end_x, spec.step_x,
+                               spec.field_y, spec.start_y, spec.end_y, spec.step_y);
+            if (grid.nrows < 5 || grid.ncols < 5)
+            {
+                throw std::invalid_argument("A table needs at least 5 nodes on each axis.");
+            }
+
+            auto t = std::make_shared<TableEngine::Table>();
+            t->spec = spec;
+
+            std::vector<double> x_nodes(grid.nrows), y_nodes(grid.ncols);
+            for (std::size_t i = 0; i < grid.nrows; ++i) x_nodes[i] = grid(i, 0).*spec.field_x;
+            for (std::size_t j = 0; j < grid.ncols; ++j) y_nodes[j] = grid(0, j).*spec.field_y;
+            t->x = Axis(spec.field_x, std::move(x_nodes));
+            t->y = Axis(spec.field_y, std::move(y_nodes));
+
+            // --- nodes ---
+            t->prices = util::Grid2D<double>(grid.nrows, grid.ncols);
+            t->deltas = util::Grid2D<double>(grid.nrows, grid.ncols);
+            t->gammas = util::Grid2D<double>(grid.nrows, grid.ncols);
+            pricer.price(grid, t->prices);
+            greeks.delta(grid, t->deltas);
+            greeks.gamma(grid, t->gammas);
+
+            // --- error bounds ---
+            const std::vector<CellFactors> cx = cell_factors(t->x), cy = cell_factors(t->y);
+            t->bounds.price = error_bound(t->prices, t->x, t->y, cx, cy);
+            t->bounds.delta = error_bound(t->deltas, t->x, t->y, cx, cy);
+            t->bounds.gamma = error_bound(t->gammas, t->x, t->y, cx, cy);
+            if (spec.tolerance > 0.0 && !(t->bounds.price <= spec.tolerance))
+            {
+                throw std::invalid_argument("Table price error bound exceeds the tolerance (refine the axes).");
+            }
+            return t;
+        }
+    }
+}
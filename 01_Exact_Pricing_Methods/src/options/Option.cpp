@@ -6,12 +6,22 @@
 */
 
 #include "../../include/options/Option.hpp"
+#include "../../include/util/validation.hpp"
 #include <stdexcept>
 
 namespace yvan
 {
     namespace option
     {
+        // --- Validation ---
+        // params_error(): the first check that fails, nullptr if none
+        // (the rules and messages of util::params_faults / util::fault_message;
+        // NaN and infinite fields are left to the batch checks)
+        const char* params_error(const OptionParams& params) noexcept
+        {
+            return util::fault_message(util::params_faults(params) & ~util::fault::not_finite);
+        }
+
         // --- Constructors ---
         // --- default
         Option::Option()
@@ -25,26 +35,9 @@ namespace yvan
         // throws std::invalid_argument if invalid params
         void Option::validate_params() const
         {
-            if (params_.asset_price < 0.0)
-            {
-                throw std::invalid_argument("Asset price must be non-negative.");
-            }
-            if (params_.strike_price < 0.0)
-            {
-                throw std::invalid_argument("Strike price must be non-negative.");
-            }
-            if (params_.volatility < 0.0)
-            {
-                throw std::invalid_argument("Volatility must be non-negative.");
-            }
-            if (params_.exercise_time < 0.0)
-            {
-                throw std::invalid_argument("Exercise time cannot be negative.");
-            }
-            if (params_.option_type != OptionType::Call &&
-                params_.option_type != OptionType::Put)
+            if (const char* error = params_error(params_))
             {
-                throw std::invalid_argument("Invalid option type.");
+                throw std::invalid_argument(error);
             }
         }
 
@@ -0,0 +1,66 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |         Portfolio Class         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+*/
+
+#include "../../include/options/Portfolio.hpp"
+
+namespace yvan
+{
+    namespace option
+    {
+        // --- Positions ---
+        void Portfolio::add(const OptionParams& params, double quantity, OptionStyle style)
+        {
+            asset_price_.push_back(params.asset_price);
+            strike_price_.push_back(params.strike_price);
+            r_.push_back(params.r);
+            cost_of_carry_.push_back(params.cost_of_carry);
+            volatility_.push_back(params.volatility);
+            exercise_time_.push_back(params.exercise_time);
+            option_type_.push_back(params.option_type);
+            style_.push_back(style);
+            quantity_.push_back(quantity);
+        }
+
+        void Portfolio::add(const Option& option, double quantity)
+        {
+            add(option.get_params(), quantity, option.style());
+        }
+
+        void Portfolio::reserve(std::size_t n)
+        {
+            asset_price_.reserve(n);
+            strike_price_.reserve(n);
+            r_.reserve(n);
+            cost_of_carry_.reserve(n);
+            volatility_.reserve(n);
+            exercise_time_.reserve(n);
+            option_type_.reserve(n);
+            style_.reserve(n);
+            quantity_.reserve(n);
+        }
+
+        void Portfolio::clear() noexcept
+        {
+            asset_price_.clear();
+            strike_price_.clear();
+            r_.clear();
+            cost_of_carry_.clear();
+            volatility_.clear();
+            exercise_time_.clear();
+            option_type_.clear();
+            style_.clear();
+            quantity_.clear();
+        }
+
+        // --- Getters ---
+        OptionParams Portfolio::params(std::size_t i) const
+        {
+            return OptionParams{ asset_price_[i], strike_price_[i], r_[i], cost_of_carry_[i],
+                                 volatility_[i], exercise_time_[i], option_type_[i] };
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |             aad.cpp             |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the
+                            arena-allocated tape used by the
+                            reverse-mode automatic differentiation.
+*/
+
+#include "../../include/util/aad.hpp"
+
+namespace yvan
+{
+    namespace util
+    {
+        // --- Destructor ---
+        Tape::~Tape() = default;
+
+        // --- Internal Helpers ---
+        // grow(): add one block to the arena (existing nodes never move)
+        void Tape::grow()
+        {
+            blocks_.push_back(std::make_unique<Node[]>(block_size));
+        }
+
+        // --- Adjoints ---
+        void Tape::propagate(std::size_t from, Mark to)
+        {
+            // nodes are recorded in evaluation order, so walking backwards
+            // visits every node after all the nodes that depend on it
+            for (std::size_t i = from + 1; i-- > to; )
+            {
+                const Node& n = node(i);
+                if (n.adjoint == 0.0) continue; // nothing to push (also skips the inputs)
+                for (unsigned k = 0; k < n.n_args; ++k)
+                {
+                    node(n.arg[k]).adjoint += n.weight[k] * n.adjoint;
+                }
+            }
+        }
+
+        void Tape::reset_adjoints(Mark m)
+        {
+            for (std::size_t i = m; i < size_; ++i) node(i).adjoint = 0.0;
+        }
+    }
+}
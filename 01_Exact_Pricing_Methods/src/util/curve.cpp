@@ -0,0 +1,87 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |            curve.cpp            |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the
+                            discount curves.
+*/
+
+#include "../../include/util/curve.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace util
+    {
+        // --- Constructor ---
+        DiscountCurve::DiscountCurve(const std::vector<double>& times, const std::vector<double>& discount_factors)
+        {
+            if (times.empty() || times.size() != discount_factors.size())
+            {
+                throw std::invalid_argument("Curve needs as many discount factors as pillar times (at least one).");
+            }
+            for (std::size_t i = 0; i < times.size(); ++i)
+            {
+                if (!(times[i] > 0.0) || (i > 0 && !(times[i] > times[i - 1])))
+                {
+                    throw std::invalid_argument("Curve pillar times must be positive and increasing.");
+                }
+                if (!(discount_factors[i] > 0.0))
+                {
+                    throw std::invalid_argument("Discount factors must be positive.");
+                }
+            }
+
+            times_ = times;
+            log_df_.reserve(discount_factors.size());
+            for (double df : discount_factors) log_df_.push_back(std::log(df));
+        }
+
+        // --- Factories ---
+        DiscountCurve DiscountCurve::flat(double rate)
+        {
+            // one pillar: the flat forward extrapolation covers every maturity
+            return DiscountCurve({ 1.0 }, { std::exp(-rate) });
+        }
+
+        DiscountCurve DiscountCurve::from_zero_rates(const std::vector<double>& times, const std::vector<double>& zero_rates)
+        {
+            if (times.size() != zero_rates.size())
+            {
+                throw std::invalid_argument("Curve needs as many zero rates as pillar times.");
+            }
+            std::vector<double> dfs(times.size());
+            for (std::size_t i = 0; i < times.size(); ++i) dfs[i] = std::exp(-zero_rates[i] * times[i]);
+            return DiscountCurve(times, dfs);
+        }
+
+        // --- Lookups ---
+        double DiscountCurve::log_discount(double T) const
+        {
+            if (T <= 0.0) return 0.0;
+
+            // first pillar after T ((0, 0) is the implicit node before the first pillar)
+            std::size_t hi = static_cast<std::size_t>(std::upper_bound(times_.begin(), times_.end(), T) - times_.begin());
+            if (hi == 0 || times_.size() == 1) return log_df_[0] * (T / times_[0]);
+            // at or after the last pillar: extend the last segment (flat forward)
+            if (hi == times_.size()) hi = times_.size() - 1;
+
+            const double t0 = times_[hi - 1];
+            const double l0 = log_df_[hi - 1];
+            return l0 + (log_df_[hi] - l0) * (T - t0) / (times_[hi] - t0);
+        }
+
+        double DiscountCurve::zero_rate(double T) const
+        {
+            if (T <= 0.0)
+            {
+                // limit T -> 0: the first forward rate
+                return -log_df_[0] / times_[0];
+            }
+            return -log_discount(T) / T;
+        }
+    }
+}
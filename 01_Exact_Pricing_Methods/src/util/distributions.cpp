@@ -19,6 +19,7 @@ namespace yvan
         // Standard normal cumulative distribution function
         double N(double x)
         {
+            YVAN_PROBE_COUNT(cdf, 1);
             static boost::math::normal_distribution<double> normal_dist(0.0, 1.0);
             return boost::math::cdf(normal_dist, x);
         }
@@ -26,6 +27,7 @@ namespace yvan
         // Standard normal probability density function
         double n(double x)
         {
+            YVAN_PROBE_COUNT(pdf, 1);
             static boost::math::normal_distribution<double> normal_dist(0.0, 1.0);
             return boost::math::pdf(normal_dist, x);
         }
@@ -18,6 +18,7 @@
 
 #include "../../include/util/param_grid.hpp"
 #include "../../include/util/mesh.hpp"
+#include "../../include/util/instrumentation.hpp"
 #include <stdexcept>
 
 
@@ -41,6 +42,7 @@ namespace yvan
                 throw std::invalid_argument("End value must be greater than or equal to start value.");
             }
 
+            YVAN_PROBE_TIMER(timer, sweep_1d, 0);
             std::vector<OptionParams> grid;
             for (double val = start; val <= end; val += step)
             {
@@ -57,6 +59,7 @@ namespace yvan
                 grid.push_back(params);
             }
 
+            YVAN_PROBE_ITEMS(timer, grid.size());
             return grid;
         }
 
@@ -81,6 +84,8 @@ namespace yvan
             {
                 throw std::invalid_argument("End y value must be greater than or equal to start y value.");
             }
+            YVAN_PROBE_TIMER(timer, sweep_2d, 0);
+
             // Generate mesh vectors for both dimensions
             std::vector<double> mesh_x = util::mesh_vector(start_x, end_x, step_x);
             std::vector<double> mesh_y = util::mesh_vector(start_y, end_y, step_y);
@@ -102,6 +107,7 @@ namespace yvan
                 }
             }
 
+            YVAN_PROBE_ITEMS(timer, grid.data.size());
             return grid; // easy access via our accessors
         }
     }
@@ -0,0 +1,525 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          params_io.cpp          |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the book
+                            loaders (CSV and binary).
+*/
+
+#include "../../include/util/params_io.hpp"
+#include "../../include/util/parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define YVAN_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define YVAN_HAS_MMAP 0
+#endif
+
+namespace yvan
+{
+    namespace util
+    {
+        namespace
+        {
+            using option::OptionParams;
+            using option::OptionType;
+
+            // smallest CSV chunk worth a thread of its own
+            constexpr std::size_t min_chunk_bytes = std::size_t{ 1 } << 16;
+            // smallest binary chunk (records) worth a thread of its own
+            constexpr std::size_t min_chunk_records = std::size_t{ 1 } << 14;
+
+            // --- Fields ---
+            // order of the fields in the binary columns and in the CSV mapping
+            enum Field : int { AssetPrice, StrikePrice, Rate, CostOfCarry, Volatility, ExerciseTime, Quantity, Type, n_fields };
+
+            constexpr double OptionParams::* double_fields[6] = {
+                &OptionParams::asset_price, &OptionParams::strike_price, &OptionParams::r,
+                &OptionParams::cost_of_carry, &OptionParams::volatility, &OptionParams::exercise_time };
+
+            constexpr const char* field_names[n_fields] = {
+                "asset_price", "strike_price", "r", "cost_of_carry", "volatility", "exercise_time", "quantity", "option_type" };
+
+            // Whole file in memory: mapped where the platform allows it, read otherwise
+            class MappedFile
+            {
+            private:
+                const char* data_ = nullptr;
+                std::size_t size_ = 0;
+#if YVAN_HAS_MMAP
+                void* map_ = nullptr;
+#else
+                std::vector<char> bytes_;
+#endif
+
+            public:
+                // throws std::invalid_argument if the file cannot be read
+                explicit MappedFile(const std::string& path)
+                {
+#if YVAN_HAS_MMAP
+                    const int fd = ::open(path.c_str(), O_RDONLY);
+                    struct stat st {};
+                    if (fd < 0 || ::fstat(fd, &st) != 0)
+                    {
+                        if (fd >= 0) ::close(fd);
+                        throw std::invalid_argument("Cannot open the file " + path + ".");
+                    }
+                    size_ = static_cast<std::size_t>(st.st_size);
+                    if (size_ > 0)
+                    {
+                        map_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (map_ == MAP_FAILED)
+                        {
+                            ::close(fd);
+                            throw std::invalid_argument("Cannot map the file " + path + ".");
+                        }
+                        ::posix_madvise(map_, size_, POSIX_MADV_SEQUENTIAL); // a hint: failure is harmless
+                        data_ = static_cast<const char*>(map_);
+                    }
+                    ::close(fd); // the mapping stays valid
+#else
+                    std::FILE* file = std::fopen(path.c_str(), "rb");
+                    if (file == nullptr) throw std::invalid_argument("Cannot open the file " + path + ".");
+                    char block[1 << 16];
+                    for (std::size_t n; (n = std::fread(block, 1, sizeof(block), file)) > 0; )
+                    {
+                        bytes_.insert(bytes_.end(), block, block + n);
+                    }
+                    std::fclose(file);
+                    data_ = bytes_.data();
+                    size_ = bytes_.size();
+#endif
+                }
+
+                ~MappedFile()
+                {
+#if YVAN_HAS_MMAP
+                    if (map_ != nullptr) ::munmap(map_, size_);
+#endif
+                }
+
+                MappedFile(const MappedFile&) = delete;
+                MappedFile& operator=(const MappedFile&) = delete;
+
+                std::string_view view() const noexcept { return std::string_view(data_, size_); }
+            };
+
+            // --- Parsing ---
+            std::string_view trim(std::string_view s)
+            {
+                while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+                while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+                return s;
+            }
+
+            // parse_double(): false unless the whole cell is a finite number
+            bool parse_double(std::string_view cell, double& value)
+            {
+                cell = trim(cell);
+                const char* end = cell.data() + cell.size();
+                const auto [ptr, ec] = std::from_chars(cell.data(), end, value);
+                return ec == std::errc{} && ptr == end && std::isfinite(value);
+            }
+
+            bool parse_type(std::string_view cell, OptionType& type)
+            {
+                cell = trim(cell);
+                auto is = [cell](std::string_view word)
+                {
+                    return cell.size() == word.size()
+                        && std::equal(cell.begin(), cell.end(), word.begin(),
+                                      [](char a, char b) { return (a | 0x20) == b; }); // ASCII lower case
+                };
+                if (is("call") || is("c")) { type = OptionType::Call; return true; }
+                if (is("put") || is("p")) { type = OptionType::Put; return true; }
+                return false;
+            }
+
+            // Positions of the fields in a CSV row
+            struct CsvLayout
+            {
+                std::vector<int> field_of_column; // field read from each column (-1: ignored)
+                char separator = ',';
+            };
+
+            // layout(): the columns of the header line
+            // throws std::invalid_argument if a required column is missing
+            CsvLayout layout(std::string_view header, const ParamsCsv& format)
+            {
+                const std::string* names[n_fields] = {
+                    &format.asset_price, &format.strike_price, &format.r, &format.cost_of_carry,
+                    &format.volatility, &format.exercise_time, &format.quantity, &format.option_type };
+
+                CsvLayout out;
+                out.separator = format.separator;
+                bool found[n_fields] = {};
+                std::size_t begin = 0;
+                while (true)
+                {
+                    const std::size_t end = std::min(header.find(format.separator, begin), header.size());
+                    const std::string_view cell = trim(header.substr(begin, end - begin));
+                    int field = -1;
+                    for (int f = 0; f < n_fields; ++f)
+                    {
+                        if (!found[f] && cell == *names[f]) { field = f; found[f] = true; break; }
+                    }
+                    out.field_of_column.push_back(field);
+                    if (end == header.size()) break;
+                    begin = end + 1;
+                }
+                for (int f = 0; f < n_fields; ++f)
+                {
+                    if (!found[f] && f != Quantity)
+                    {
+                        throw std::invalid_argument("Missing column " + *names[f] + " in the CSV header.");
+                    }
+                }
+                return out;
+            }
+
+            // parse_row(): nullptr if the row is loaded, else the reason
+            // (message holds the reasons that need formatting)
+            const char* parse_row(std::string_view line, const CsvLayout& layout,
+                                  OptionParams& p, double& quantity, std::string& message)
+            {
+                const std::size_t n_columns = layout.field_of_column.size();
+                quantity = 1.0;
+                const char* error = nullptr; // first bad cell (a wrong number of fields is reported first)
+                std::size_t column = 0, begin = 0;
+                while (true)
+                {
+                    const std::size_t end = std::min(line.find(layout.separator, begin), line.size());
+                    const int field = column < n_columns ? layout.field_of_column[column] : -1;
+                    if (field >= 0 && error == nullptr)
+                    {
+                        const std::string_view cell = line.substr(begin, end - begin);
+                        if (field == Type ? !parse_type(cell, p.option_type)
+                                          : !parse_double(cell, field == Quantity ? quantity : p.*double_fields[field]))
+                        {
+                            message = (field == Type ? "Invalid option type '" : "Invalid number '")
+                                      + std::string(trim(cell)) + "' in column " + field_names[field] + ".";
+                            error = message.c_str();
+                        }
+                    }
+                    ++column;
+                    if (end == line.size()) break;
+                    begin = end + 1;
+                }
+                if (column != n_columns)
+                {
+                    message = "Expected " + std::to_string(n_columns) + " fields, found " + std::to_string(column) + ".";
+                    return message.c_str();
+                }
+                return error != nullptr ? error : option::params_error(p);
+            }
+
+            // Rows of one chunk, with rows numbered from the start of the chunk
+            struct Chunk
+            {
+                ParamsLoad load;
+                std::size_t lines = 0; // lines of the chunk (CSV)
+            };
+
+            void parse_chunk(std::string_view text, const CsvLayout& layout, Chunk& chunk)
+            {
+                std::string message;
+                std::size_t begin = 0;
+                while (begin < text.size())
+                {
+                    const std::size_t end = std::min(text.find('\n', begin), text.size());
+                    const std::string_view line = trim(text.substr(begin, end - begin));
+                    const std::size_t row = chunk.lines++;
+                    begin = end + 1;
+                    if (line.empty()) continue;
+
+                    OptionParams p{};
+                    double quantity{};
+                    if (const char* error = parse_row(line, layout, p, quantity, message))
+                    {
+                        chunk.load.errors.push_back(ParamsRowError{ row, error });
+                        continue;
+                    }
+                    chunk.load.params.push_back(p);
+                    chunk.load.quantities.push_back(quantity);
+                    chunk.load.rows.push_back(row);
+                }
+            }
+
+            // merge(): the chunks in order, their rows shifted by first_row + the rows before them
+            ParamsLoad merge(std::vector<Chunk>& chunks, std::size_t first_row)
+            {
+                ParamsLoad out;
+                std::size_t n_params = 0, n_errors = 0;
+                for (const Chunk& c : chunks)
+                {
+                    n_params += c.load.params.size();
+                    n_errors += c.load.errors.size();
+                }
+                out.params.reserve(n_params);
+                out.quantities.reserve(n_params);
+                out.rows.reserve(n_params);
+                out.errors.reserve(n_errors);
+
+                std::size_t offset = first_row;
+                for (Chunk& c : chunks)
+                {
+                    out.params.insert(out.params.end(), c.load.params.begin(), c.load.params.end());
+                    out.quantities.insert(out.quantities.end(), c.load.quantities.begin(), c.load.quantities.end());
+                    for (std::size_t row : c.load.rows) out.rows.push_back(row + offset);
+                    for (ParamsRowError& e : c.load.errors)
+                    {
+                        out.errors.push_back(ParamsRowError{ e.row + offset, std::move(e.message) });
+                    }
+                    offset += c.lines;
+                    c.load = ParamsLoad{}; // release the chunk as soon as it is copied
+                }
+                return out;
+            }
+
+            // --- Binary Layout ---
+            constexpr char params_magic[8] = { 'Y', 'P', 'A', 'R', 'A', 'M', 'S', '\0' };
+
+            std::uint64_t aligned(std::uint64_t offset)
+            {
+                constexpr std::uint64_t alignment = 64;
+                return (offset + alignment - 1) / alignment * alignment;
+            }
+
+            ParamsHeader make_header(std::uint64_t count)
+            {
+                ParamsHeader h{};
+                std::memcpy(h.magic, params_magic, sizeof(h.magic));
+                h.version = params_format_version;
+                h.header_size = sizeof(ParamsHeader);
+                h.count = count;
+                std::uint64_t offset = sizeof(ParamsHeader);
+                for (int f = 0; f < n_fields; ++f)
+                {
+                    h.offsets[f] = aligned(offset);
+                    offset = h.offsets[f] + count * (f == Type ? 1 : sizeof(double));
+                }
+                return h;
+            }
+
+            // pad_to(): zero-fill the file up to offset
+            void pad_to(std::FILE* file, std::uint64_t& pos, std::uint64_t offset)
+            {
+                static constexpr char zeros[64] = {};
+                if (std::fwrite(zeros, 1, offset - pos, file) != offset - pos)
+                {
+                    throw std::runtime_error("Failed to write the binary book.");
+                }
+                pos = offset;
+            }
+        }
+
+        // --- CSV ---
+        ParamsLoad parse_params_csv(std::string_view text, const ParamsCsv& format, std::size_t n_threads)
+        {
+            const std::size_t header_end = std::min(text.find('\n'), text.size());
+            const CsvLayout columns = layout(trim(text.substr(0, header_end)), format);
+            const std::string_view body = text.substr(std::min(header_end + 1, text.size()));
+
+            // chunks of about the same size, each ending on a line boundary
+            const std::size_t n_chunks = std::clamp<std::size_t>(body.size() / min_chunk_bytes, 1, std::max<std::size_t>(n_threads, 1));
+            std::vector<std::size_t> bounds{ 0 };
+            for (std::size_t k = 1; k < n_chunks; ++k)
+            {
+                const std::size_t cut = std::max(bounds.back(), k * body.size() / n_chunks);
+                bounds.push_back(std::min(body.find('\n', cut), body.size() - 1) + 1);
+            }
+            bounds.push_back(body.size());
+
+            std::vector<Chunk> chunks(n_chunks);
+            parallel_for(n_chunks, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t k = begin; k < end; ++k)
+                {
+                    parse_chunk(body.substr(bounds[k], bounds[k + 1] - bounds[k]), columns, chunks[k]);
+                }
+            });
+            return merge(chunks, 2); // line 1 is the header
+        }
+
+        ParamsLoad load_params_csv(const std::string& path, const ParamsCsv& format, std::size_t n_threads)
+        {
+            const MappedFile file(path);
+            return parse_params_csv(file.view(), format, n_threads);
+        }
+
+        // --- Binary ---
+        void write_params_binary(const std::string& path,
+                                 std::span<const OptionParams> params,
+                                 std::span<const double> quantities)
+        {
+            if constexpr (std::endian::native != std::endian::little)
+            {
+                throw std::invalid_argument("Binary books are little-endian only.");
+            }
+            if (!quantities.empty() && quantities.size() != params.size())
+            {
+                throw std::invalid_argument("There must be one quantity per position.");
+            }
+            std::FILE* file = std::fopen(path.c_str(), "wb");
+            if (file == nullptr)
+            {
+                throw std::invalid_argument("Cannot open the file " + path + " for writing.");
+            }
+            try
+            {
+                const ParamsHeader header = make_header(params.size());
+                std::uint64_t pos = 0;
+                if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+                {
+                    throw std::runtime_error("Failed to write the binary book.");
+                }
+                pos = sizeof(header);
+
+                // each column is gathered from the params block by block
+                constexpr std::size_t block = 8192;
+                std::array<double, block> values;
+                std::array<std::uint8_t, block> types;
+                for (int f = 0; f < n_fields; ++f)
+                {
+                    pad_to(file, pos, header.offsets[f]);
+                    for (std::size_t i = 0; i < params.size(); i += block)
+                    {
+                        const std::size_t n = std::min(block, params.size() - i);
+                        std::size_t written;
+                        if (f == Type)
+                        {
+                            for (std::size_t k = 0; k < n; ++k) types[k] = params[i + k].option_type == OptionType::Put;
+                            written = std::fwrite(types.data(), 1, n, file);
+                        }
+                        else
+                        {
+                            for (std::size_t k = 0; k < n; ++k)
+                            {
+                                values[k] = f == Quantity ? (quantities.empty() ? 1.0 : quantities[i + k])
+                                                          : params[i + k].*double_fields[f];
+                            }
+                            written = std::fwrite(values.data(), sizeof(double), n, file);
+                        }
+                        if (written != n) throw std::runtime_error("Failed to write the binary book.");
+                        pos += n * (f == Type ? 1 : sizeof(double));
+                    }
+                }
+            }
+            catch (...)
+            {
+                std::fclose(file);
+                throw;
+            }
+            if (std::fclose(file) != 0)
+            {
+                throw std::runtime_error("Failed to write the binary book.");
+            }
+        }
+
+        ParamsLoad load_params_binary(const std::string& path, std::size_t n_threads)
+        {
+            if constexpr (std::endian::native != std::endian::little)
+            {
+                throw std::invalid_argument("Binary books are little-endian only.");
+            }
+            const MappedFile file(path);
+            const std::string_view bytes = file.view();
+
+            // --- header ---
+            ParamsHeader header;
+            if (bytes.size() < sizeof(header))
+            {
+                throw std::invalid_argument("The file " + path + " is not a binary book.");
+            }
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            if (std::memcmp(header.magic, params_magic, sizeof(params_magic)) != 0
+                || header.header_size != sizeof(ParamsHeader))
+            {
+                throw std::invalid_argument("The file " + path + " is not a binary book.");
+            }
+            if (header.version != params_format_version)
+            {
+                throw std::invalid_argument("Unsupported binary book version in " + path + ".");
+            }
+            const std::uint64_t count = header.count;
+            for (int f = 0; f < n_fields; ++f)
+            {
+                const std::uint64_t width = f == Type ? 1 : sizeof(double);
+                if (count > bytes.size() / width || header.offsets[f] > bytes.size() - count * width)
+                {
+                    throw std::invalid_argument("Truncated binary book " + path + ".");
+                }
+            }
+            const char* column[n_fields];
+            for (int f = 0; f < n_fields; ++f) column[f] = bytes.data() + header.offsets[f];
+
+            // --- records, in chunks ---
+            const std::size_t n_chunks = std::clamp<std::size_t>(count / min_chunk_records, 1, std::max<std::size_t>(n_threads, 1));
+            std::vector<Chunk> chunks(n_chunks);
+            parallel_for(n_chunks, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t k = begin; k < end; ++k)
+                {
+                    const std::size_t first = k * count / n_chunks, last = (k + 1) * count / n_chunks;
+                    Chunk& chunk = chunks[k];
+                    chunk.lines = last - first;
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        OptionParams p{};
+                        double values[Quantity + 1];
+                        for (int f = 0; f <= Quantity; ++f)
+                        {
+                            std::memcpy(&values[f], column[f] + i * sizeof(double), sizeof(double));
+                        }
+                        for (int f = 0; f < Quantity; ++f) p.*double_fields[f] = values[f];
+                        const std::uint8_t type = static_cast<std::uint8_t>(column[Type][i]);
+                        p.option_type = type == 1 ? OptionType::Put : OptionType::Call;
+
+                        const char* error = nullptr;
+                        for (int f = 0; f <= Quantity && error == nullptr; ++f)
+                        {
+                            if (!std::isfinite(values[f])) error = "Non-finite value.";
+                        }
+                        if (error == nullptr && type > 1) error = "Invalid option type.";
+                        if (error == nullptr) error = option::params_error(p);
+                        if (error != nullptr)
+                        {
+                            chunk.load.errors.push_back(ParamsRowError{ i - first, error });
+                            continue;
+                        }
+                        chunk.load.params.push_back(p);
+                        chunk.load.quantities.push_back(values[Quantity]);
+                        chunk.load.rows.push_back(i - first);
+                    }
+                }
+            });
+            return merge(chunks, 0);
+        }
+
+        // --- Portfolio ---
+        option::Portfolio to_portfolio(const ParamsLoad& load)
+        {
+            option::Portfolio book;
+            book.reserve(load.params.size());
+            for (std::size_t k = 0; k < load.params.size(); ++k)
+            {
+                book.add(load.params[k], load.quantities[k]);
+            }
+            return book;
+        }
+    }
+}
@@ -10,13 +10,24 @@
 
 
 #include "../../include/util/parity.hpp"
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <stdexcept>
 
 namespace yvan
 {
     namespace util
     {
+        // call_minus_put(): C - P = S * e^((b-r)T) - K * e^(-rT)
+        double call_minus_put(const option::OptionParams& params)
+        {
+            double df_r = std::exp(-params.r * params.exercise_time);
+            double fwd_factor = std::exp((params.cost_of_carry - params.r) * params.exercise_time);
+            return params.asset_price * fwd_factor - params.strike_price * df_r;
+        }
+
         // put_from_call(): compute the put price from the call price using put-call parity
         double put_from_call(double C, const option::OptionParams& params)
         {
@@ -26,9 +37,8 @@ namespace yvan
                 throw std::invalid_argument("OptionParams must correspond to a Call option.");
             }
 
-            // Put-Call Parity: C + K * e^(-rT) = P + S
-            double df_r = std::exp(-params.r * params.exercise_time);
-            double P = C + params.strike_price * df_r - params.asset_price;
+            // Put-Call Parity: C + K * e^(-rT) = P + S * e^((b-r)T)
+            double P = C - call_minus_put(params);
             return P;
         }
         double put_from_call(double C, const option::EuropeanOption& option)
@@ -49,9 +59,8 @@ namespace yvan
                 throw std::invalid_argument("OptionParams must correspond to a Put option.");
             }
 
-            // Put-Call Parity: C + K * e^(-rT) = P + S
-            double df_r = std::exp(-params.r * params.exercise_time);
-            double C = P + params.asset_price - params.strike_price * df_r;
+            // Put-Call Parity: C + K * e^(-rT) = P + S * e^((b-r)T)
+            double C = P + call_minus_put(params);
             return C;
         }
         double call_from_put(double P, const option::EuropeanOption& option)
@@ -66,10 +75,7 @@ namespace yvan
         // check_parity(): check if put-call parity holds for given call and put prices
         bool check_parity(double C, double P, const option::OptionParams& params, double tol)
         {
-            double df_r = std::exp(-params.r * params.exercise_time);
-            double lhs = C + params.strike_price * df_r;
-            double rhs = P + params.asset_price;
-            return std::fabs(lhs - rhs) < tol;
+            return std::fabs(C - P - call_minus_put(params)) < tol;
         }
         bool check_parity(double C, double P, const option::EuropeanOption& option, double tol)
         {
@@ -79,5 +85,121 @@ namespace yvan
             // return
             return check_parity(C, P, params, tol);
         }
+
+        // --- Batch Parity Scanner ---
+        namespace
+        {
+            // pairing key: the market data shared by the two legs of a parity
+            struct ParityKey
+            {
+                double S, K, T, r, b;
+
+                bool operator==(const ParityKey&) const = default;
+            };
+
+            ParityKey parity_key(const option::OptionParams& q)
+            {
+                return ParityKey{ q.asset_price, q.strike_price, q.exercise_time, q.r, q.cost_of_carry };
+            }
+
+            // hash of the pairing key
+            std::uint64_t key_hash(const ParityKey& k)
+            {
+                std::uint64_t h = 0;
+                for (double x : { k.S, k.K, k.T, k.r, k.b })
+                {
+                    h ^= std::bit_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ULL + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+                }
+                h ^= h >> 33;
+                h *= 0xFF51AFD7ED558CCDULL;
+                h ^= h >> 33;
+                return h;
+            }
+        }
+
+        ParityScan scan_parity(std::span<const option::OptionParams> quotes,
+                               std::span<const double> prices, double tol)
+        {
+            if (quotes.size() != prices.size())
+            {
+                throw std::invalid_argument("Quotes and prices must have the same size.");
+            }
+
+            // build: open addressing table of the keys (load factor <= 1/2), holding the
+            // last call and the last put of each key; a slot stores the hash of its key,
+            // the key itself is only compared (in the quotes) when the hashes match
+            struct Slot { std::uint64_t hash; std::size_t call; std::size_t put; };
+            constexpr std::size_t empty = static_cast<std::size_t>(-1);
+            const std::size_t capacity = std::bit_ceil(std::max<std::size_t>(2 * quotes.size(), 16));
+            const std::size_t mask = capacity - 1;
+            std::vector<Slot> table(capacity, Slot{ 0, empty, empty });
+
+            ParityScan scan;
+            std::size_t n_calls = 0;
+            for (std::size_t i = 0; i < quotes.size(); ++i)
+            {
+                const option::OptionParams& q = quotes[i];
+                const ParityKey key = parity_key(q);
+                const std::uint64_t hash = key_hash(key);
+                std::size_t slot = hash & mask;
+                while (table[slot].call != empty || table[slot].put != empty)
+                {
+                    const Slot& t = table[slot];
+                    if (t.hash == hash && parity_key(quotes[t.call != empty ? t.call : t.put]) == key) break;
+                    slot = (slot + 1) & mask;
+                }
+                table[slot].hash = hash;
+                std::size_t& leg = q.option_type == option::OptionType::Call ? table[slot].call : table[slot].put;
+                if (leg != empty) scan.duplicates.push_back(leg); // a newer quote replaces the older one
+                leg = i;
+                if (q.option_type == option::OptionType::Call) ++n_calls;
+            }
+
+            // matched pairs (in slot order)
+            std::vector<std::size_t> pair_calls, pair_puts;
+            pair_calls.reserve(std::min(n_calls, quotes.size() - n_calls));
+            pair_puts.reserve(pair_calls.capacity());
+            for (std::size_t slot = 0; slot < capacity; ++slot)
+            {
+                if (table[slot].call == empty || table[slot].put == empty) continue;
+                pair_calls.push_back(table[slot].call);
+                pair_puts.push_back(table[slot].put);
+            }
+
+            // residuals in one pass over the pairs (gathered into columns first)
+            const std::size_t n_pairs = pair_calls.size();
+            std::vector<double> C(n_pairs), P(n_pairs), S(n_pairs), K(n_pairs), r(n_pairs), b(n_pairs), T(n_pairs);
+            for (std::size_t j = 0; j < n_pairs; ++j)
+            {
+                const option::OptionParams& q = quotes[pair_calls[j]];
+                C[j] = prices[pair_calls[j]];
+                P[j] = prices[pair_puts[j]];
+                S[j] = q.asset_price; K[j] = q.strike_price;
+                r[j] = q.r; b[j] = q.cost_of_carry; T[j] = q.exercise_time;
+            }
+            std::vector<double> residual(n_pairs);
+            for (std::size_t j = 0; j < n_pairs; ++j)
+            {
+                // C - P = S e^((b-r)T) - K e^(-rT)
+                residual[j] = C[j] - P[j] - (S[j] * std::exp((b[j] - r[j]) * T[j]) - K[j] * std::exp(-r[j] * T[j]));
+            }
+
+            // violations, largest first (both legs share the market data of the key)
+            std::vector<ParityViolation>& out = scan.violations;
+            for (std::size_t j = 0; j < n_pairs; ++j)
+            {
+                if (std::fabs(residual[j]) > tol)
+                {
+                    out.push_back(ParityViolation{ pair_calls[j], pair_puts[j], residual[j] });
+                }
+            }
+            std::sort(out.begin(), out.end(), [](const ParityViolation& x, const ParityViolation& y)
+            {
+                if (std::fabs(x.residual) != std::fabs(y.residual)) return std::fabs(x.residual) > std::fabs(y.residual);
+                return x.call_index < y.call_index;
+            });
+            std::sort(scan.duplicates.begin(), scan.duplicates.end());
+            return scan;
+        }
     }
-}
\ No newline at end of file
+}
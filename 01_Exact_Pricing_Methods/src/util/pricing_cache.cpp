@@ -0,0 +1,210 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |        pricing_cache.cpp        |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the
+                            sharded, open addressing memoization
+                            cache keyed on OptionParams.
+*/
+
+#include "../../include/util/pricing_cache.hpp"
+#include <bit>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace util
+    {
+        namespace
+        {
+            // round up to the next power of two (n > 0)
+            std::size_t next_pow2(std::size_t n)
+            {
+                std::size_t p = 1;
+                while (p < n) p <<= 1;
+                return p;
+            }
+
+            // 64-bit mixer (splitmix64 finalizer)
+            std::uint64_t mix(std::uint64_t x) noexcept
+            {
+                x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+                x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+                x ^= x >> 31;
+                return x;
+            }
+        }
+
+        // hash_params(): hash the bit pattern of every field
+        std::uint64_t hash_params(const option::OptionParams& p) noexcept
+        {
+            // we hash field by field rather than the raw struct bytes
+            // because the padding after option_type is indeterminate
+            std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+            h = mix(h ^ std::bit_cast<std::uint64_t>(p.asset_price));
+            h = mix(h ^ std::bit_cast<std::uint64_t>(p.strike_price));
+            h = mix(h ^ std::bit_cast<std::uint64_t>(p.r));
+            h = mix(h ^ std::bit_cast<std::uint64_t>(p.cost_of_carry));
+            h = mix(h ^ std::bit_cast<std::uint64_t>(p.volatility));
+            h = mix(h ^ std::bit_cast<std::uint64_t>(p.exercise_time));
+            h = mix(h ^ static_cast<std::uint64_t>(static_cast<int>(p.option_type)));
+            return h;
+        }
+
+        // same_params(): bitwise equality (consistent with hash_params)
+        bool same_params(const option::OptionParams& a, const option::OptionParams& b) noexcept
+        {
+            auto bits = [](double x) { return std::bit_cast<std::uint64_t>(x); };
+            return bits(a.asset_price) == bits(b.asset_price)
+                && bits(a.strike_price) == bits(b.strike_price)
+                && bits(a.r) == bits(b.r)
+                && bits(a.cost_of_carry) == bits(b.cost_of_carry)
+                && bits(a.volatility) == bits(b.volatility)
+                && bits(a.exercise_time) == bits(b.exercise_time)
+                && a.option_type == b.option_type;
+        }
+
+        // --- Constructor ---
+        PricingCache::PricingCache(std::size_t capacity, std::size_t n_shards)
+        {
+            // Validate inputs
+            if (capacity == 0 || n_shards == 0)
+            {
+                throw std::invalid_argument("Cache capacity and number of shards must be positive.");
+            }
+
+            n_shards_ = next_pow2(n_shards);
+            // every shard must at least hold one full probe window
+            std::size_t per_shard = (capacity + n_shards_ - 1) / n_shards_;
+            slots_per_shard_ = next_pow2(per_shard < probe_window ? probe_window : per_shard);
+
+            shards_ = std::make_unique<Shard[]>(n_shards_);
+            for (std::size_t s = 0; s < n_shards_; ++s)
+            {
+                shards_[s].slots.resize(slots_per_shard_);
+            }
+        }
+
+        // --- Internal Helpers ---
+        // shard_for(): the high bits of the hash pick the shard, the low bits pick the slot
+        PricingCache::Shard& PricingCache::shard_for(std::uint64_t h) const noexcept
+        {
+            return shards_[(h >> 48) & (n_shards_ - 1)];
+        }
+
+        // --- Lookup & Insertion ---
+        bool PricingCache::find(const option::OptionParams& p, double& value) const
+        {
+            const std::uint64_t h = hash_params(p);
+            Shard& shard = shard_for(h);
+            const std::size_t mask = slots_per_shard_ - 1;
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (std::size_t k = 0; k < probe_window; ++k)
+            {
+                Slot& slot = shard.slots[(h + k) & mask];
+
+                // slots are never emptied individually (eviction overwrites in place),
+                // so the first empty slot ends the probe sequence
+                if (!slot.occupied) break;
+
+                if (slot.hash == h && same_params(slot.key, p))
+                {
+                    slot.referenced = true;
+                    value = slot.value;
+                    ++shard.hits;
+                    return true;
+                }
+            }
+
+            ++shard.misses;
+            return false;
+        }
+
+        void PricingCache::insert(const option::OptionParams& p, double value)
+        {
+            const std::uint64_t h = hash_params(p);
+            Shard& shard = shard_for(h);
+            const std::size_t mask = slots_per_shard_ - 1;
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            // first pass: existing key or first free slot in the window
+            for (std::size_t k = 0; k < probe_window; ++k)
+            {
+                Slot& slot = shard.slots[(h + k) & mask];
+                if (!slot.occupied || (slot.hash == h && same_params(slot.key, p)))
+                {
+                    slot = Slot{ p, value, h, true, false };
+                    return;
+                }
+            }
+
+            // window is full: CLOCK sweep over the window starting at the shard's hand,
+            // clearing reference bits until an unreferenced victim is found
+            // (terminates after at most two turns of the window)
+            for (std::size_t turn = 0; turn < 2 * probe_window; ++turn)
+            {
+                std::size_t offset = shard.hand;
+                shard.hand = (shard.hand + 1) % probe_window;
+
+                Slot& slot = shard.slots[(h + offset) & mask];
+                if (slot.referenced)
+                {
+                    slot.referenced = false; // second chance
+                    continue;
+                }
+                slot = Slot{ p, value, h, true, false };
+                return;
+            }
+        }
+
+        void PricingCache::clear()
+        {
+            for (std::size_t s = 0; s < n_shards_; ++s)
+            {
+                std::lock_guard<std::mutex> lock(shards_[s].mutex);
+                for (auto& slot : shards_[s].slots) slot = Slot{};
+                shards_[s].hand = 0;
+                shards_[s].hits = 0;
+                shards_[s].misses = 0;
+            }
+        }
+
+        // --- Statistics ---
+        std::uint64_t PricingCache::hits() const
+        {
+            std::uint64_t total = 0;
+            for (std::size_t s = 0; s < n_shards_; ++s)
+            {
+                std::lock_guard<std::mutex> lock(shards_[s].mutex);
+                total += shards_[s].hits;
+            }
+            return total;
+        }
+
+        std::uint64_t PricingCache::misses() const
+        {
+            std::uint64_t total = 0;
+            for (std::size_t s = 0; s < n_shards_; ++s)
+            {
+                std::lock_guard<std::mutex> lock(shards_[s].mutex);
+                total += shards_[s].misses;
+            }
+            return total;
+        }
+
+        std::size_t PricingCache::size() const
+        {
+            std::size_t total = 0;
+            for (std::size_t s = 0; s < n_shards_; ++s)
+            {
+                std::lock_guard<std::mutex> lock(shards_[s].mutex);
+                for (const auto& slot : shards_[s].slots) total += slot.occupied ? 1 : 0;
+            }
+            return total;
+        }
+    }
+}
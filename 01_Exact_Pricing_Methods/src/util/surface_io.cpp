@@ -0,0 +1,463 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          surface_io.cpp         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the
+                            buffered surface exporters (CSV and
+                            binary).
+*/
+
+#include "../../include/util/surface_io.hpp"
+#include "../../include/util/parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace yvan
+{
+    namespace util
+    {
+        namespace
+        {
+            // rows per chunk formatted by one thread
+            constexpr std::size_t chunk_rows = 16384;
+
+            // field_bound(): max chars of one field in fixed notation
+            // (sign, 309 integer digits of DBL_MAX, point, precision digits, separator)
+            std::size_t field_bound(int precision)
+            {
+                return 312 + static_cast<std::size_t>(precision);
+            }
+
+            void check_precision(int precision)
+            {
+                if (precision < 0 || precision > max_csv_precision)
+                {
+                    throw std::invalid_argument("CSV precision must be between 0 and max_csv_precision.");
+                }
+            }
+
+            // format_row(): the row at out (room for fields.size() * field_bound chars), returns its end
+            char* format_row(char* out, std::span<const double> fields, int precision)
+            {
+                for (std::size_t k = 0; k < fields.size(); ++k)
+                {
+                    if (k > 0) *out++ = ',';
+                    // cannot fail: the room covers the longest fixed-notation double
+                    out = std::to_chars(out, out + field_bound(precision), fields[k],
+                                        std::chars_format::fixed, precision).ptr;
+                }
+                *out++ = '\n';
+                return out;
+            }
+
+            // Growable buffer of formatted rows (reused across chunks)
+            struct RowBuffer
+            {
+                std::vector<char> bytes;
+                std::size_t used = 0;
+
+                char* room(std::size_t n)
+                {
+                    if (bytes.size() - used < n) bytes.resize(std::max(2 * bytes.size(), used + n));
+                    return bytes.data() + used;
+                }
+            };
+
+            constexpr char surface_magic[8] = { 'Y', 'S', 'U', 'R', 'F', '\0', '\0', '\0' };
+
+            // aligned(): next multiple of surface_alignment
+            std::uint64_t aligned(std::uint64_t offset)
+            {
+                return (offset + surface_alignment - 1) / surface_alignment * surface_alignment;
+            }
+
+            void copy_name(char (&out)[24], const std::string& name)
+            {
+                if (name.size() >= sizeof(out))
+                {
+                    throw std::invalid_argument("Surface names must have at most 23 characters.");
+                }
+                std::memset(out, 0, sizeof(out));
+                std::memcpy(out, name.data(), name.size());
+            }
+
+            // pad_to(): zero-fill the file up to offset (at most one alignment gap)
+            void pad_to(std::FILE* file, std::uint64_t offset, const std::string& path)
+            {
+                static constexpr char zeros[surface_alignment] = {};
+                const long pos = std::ftell(file);
+                if (pos < 0 || static_cast<std::uint64_t>(pos) > offset || offset - pos > sizeof(zeros)
+                    || std::fwrite(zeros, 1, offset - pos, file) != offset - pos)
+                {
+                    throw std::runtime_error("Failed to write the surface file " + path + ".");
+                }
+            }
+
+            // write_at(): bytes at a given offset of the file (the gap before it is zero-filled)
+            void write_at(std::FILE* file, std::uint64_t offset, const void* data, std::size_t n, const std::string& path)
+            {
+                pad_to(file, offset, path);
+                if (std::fwrite(data, 1, n, file) != n)
+                {
+                    throw std::runtime_error("Failed to write the surface file " + path + ".");
+                }
+            }
+
+            // Binary file opened for reading
+            class BinaryReader
+            {
+                std::FILE* file_;
+                std::string path_;
+            public:
+                explicit BinaryReader(const std::string& path) : file_(std::fopen(path.c_str(), "rb")), path_(path)
+                {
+                    if (file_ == nullptr) throw std::invalid_argument("Cannot open the file " + path + ".");
+                }
+                ~BinaryReader() { std::fclose(file_); }
+                BinaryReader(const BinaryReader&) = delete;
+                BinaryReader& operator=(const BinaryReader&) = delete;
+
+                void read_at(std::uint64_t offset, void* data, std::size_t n)
+                {
+                    if (std::fseek(file_, static_cast<long>(offset), SEEK_SET) != 0
+                        || std::fread(data, 1, n, file_) != n)
+                    {
+                        throw std::invalid_argument("Truncated surface file " + path_ + ".");
+                    }
+                }
+            };
+        }
+
+        // --- Constructor & Destructor ---
+        CsvWriter::CsvWriter(const std::string& path, std::size_t buffer_size)
+            : buffer_(std::max<std::size_t>(buffer_size, 4096))
+        {
+            file_ = std::fopen(path.c_str(), "wb");
+            if (file_ == nullptr)
+            {
+                throw std::invalid_argument("Cannot open the file " + path + " for writing.");
+            }
+            std::setvbuf(file_, nullptr, _IONBF, 0); // our buffer is the only one
+        }
+
+        CsvWriter::~CsvWriter()
+        {
+            try { close(); }
+            catch (...) {} // destructors must not throw
+        }
+
+        // --- Writing ---
+        void CsvWriter::write(std::string_view text)
+        {
+            write_block(std::span<const char>(text.data(), text.size()));
+        }
+
+        void CsvWriter::write_row(std::span<const double> fields, int precision)
+        {
+            check_precision(precision);
+            const std::size_t bound = fields.size() * field_bound(precision) + 1;
+            if (buffer_.size() - used_ < bound)
+            {
+                flush();
+                if (buffer_.size() < bound) buffer_.resize(bound);
+            }
+            used_ = format_row(buffer_.data() + used_, fields, precision) - buffer_.data();
+        }
+
+        void CsvWriter::write_block(std::span<const char> bytes)
+        {
+            if (buffer_.size() - used_ >= bytes.size())
+            {
+                std::memcpy(buffer_.data() + used_, bytes.data(), bytes.size());
+                used_ += bytes.size();
+                return;
+            }
+            // too large for the room left: straight to the file (no copy)
+            flush();
+            if (std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size())
+            {
+                throw std::runtime_error("Failed to write the CSV file.");
+            }
+        }
+
+        void CsvWriter::flush()
+        {
+            if (used_ == 0 || file_ == nullptr) return;
+            const std::size_t n = used_;
+            used_ = 0;
+            if (std::fwrite(buffer_.data(), 1, n, file_) != n)
+            {
+                throw std::runtime_error("Failed to write the CSV file.");
+            }
+        }
+
+        void CsvWriter::close()
+        {
+            if (file_ == nullptr) return;
+            std::FILE* f = file_;
+            try { flush(); }
+            catch (...) { std::fclose(f); file_ = nullptr; throw; }
+            file_ = nullptr;
+            if (std::fclose(f) != 0)
+            {
+                throw std::runtime_error("Failed to close the CSV file.");
+            }
+        }
+
+        // --- Surfaces ---
+        void write_surface_csv(const std::string& path,
+                               const Grid2D<option::OptionParams>& grid,
+                               double option::OptionParams::* field_x,
+                               double option::OptionParams::* field_y,
+                               const Grid2D<double>& values,
+                               const SurfaceCsv& format,
+                               std::size_t n_threads)
+        {
+            // Validate inputs
+            if (values.nrows != grid.nrows || values.ncols != grid.ncols || values.data.size() != grid.data.size())
+            {
+                throw std::invalid_argument("Values must have the dimensions of the parameter grid.");
+            }
+            check_precision(format.precision);
+
+            CsvWriter out(path);
+            out.write(format.x_name + "," + format.y_name + "," + format.value_name + "\n");
+
+            // row k of the file is node k of the (row-major) grid
+            auto row = [&](std::size_t k) {
+                return std::array<double, 3>{ grid.data[k].*field_x, grid.data[k].*field_y, values.data[k] };
+            };
+
+            const std::size_t n_rows = grid.data.size();
+            n_threads = std::max<std::size_t>(n_threads, 1);
+            if (n_threads == 1 || n_rows <= chunk_rows)
+            {
+                for (std::size_t k = 0; k < n_rows; ++k) out.write_row(row(k), format.precision);
+                out.close();
+                return;
+            }
+
+            // waves of n_threads chunks: formatted in parallel, written in order
+            const std::size_t bound = 3 * field_bound(format.precision) + 1;
+            std::vector<RowBuffer> chunks(n_threads);
+            for (std::size_t wave = 0; wave < n_rows; wave += n_threads * chunk_rows)
+            {
+                const std::size_t wave_end = std::min(n_rows, wave + n_threads * chunk_rows);
+                const std::size_t n_chunks = (wave_end - wave + chunk_rows - 1) / chunk_rows;
+                parallel_for(n_chunks, n_threads, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t c = begin; c < end; ++c)
+                    {
+                        RowBuffer& buf = chunks[c];
+                        buf.used = 0;
+                        const std::size_t first = wave + c * chunk_rows;
+                        const std::size_t last = std::min(wave_end, first + chunk_rows);
+                        for (std::size_t k = first; k < last; ++k)
+                        {
+                            char* at = buf.room(bound);
+                            buf.used = format_row(at, row(k), format.precision) - buf.bytes.data();
+                        }
+                    }
+                });
+                for (std::size_t c = 0; c < n_chunks; ++c)
+                {
+                    out.write_block(std::span<const char>(chunks[c].bytes.data(), chunks[c].used));
+                }
+            }
+            out.close();
+        }
+
+        // --- Binary Surfaces ---
+        void write_surface_binary(const std::string& path,
+                                  std::span<const double> x,
+                                  std::span<const double> y,
+                                  const Grid2D<double>& values,
+                                  const SurfaceNames& names)
+        {
+            // Validate inputs
+            if (values.nrows != x.size() || values.ncols != y.size() || values.data.size() != x.size() * y.size())
+            {
+                throw std::invalid_argument("Values must be x.size() x y.size().");
+            }
+            BinarySurfaceSink sink(path, names);
+            sink.begin(x, y);
+            for (std::size_t i = 0; i < x.size(); ++i)
+            {
+                sink.write_row(i, std::span<const double>(values.data).subspan(i * y.size(), y.size()));
+            }
+            sink.end();
+        }
+
+        void write_surface_binary(const std::string& path,
+                                  const Grid2D<option::OptionParams>& grid,
+                                  double option::OptionParams::* field_x,
+                                  double option::OptionParams::* field_y,
+                                  const Grid2D<double>& values,
+                                  const SurfaceNames& names)
+        {
+            std::vector<double> x(grid.nrows), y(grid.ncols);
+            for (std::size_t i = 0; i < grid.nrows; ++i) x[i] = grid(i, 0).*field_x;
+            for (std::size_t j = 0; j < grid.ncols; ++j) y[j] = grid(0, j).*field_y;
+            write_surface_binary(path, x, y, values, names);
+        }
+
+        SurfaceFile read_surface_binary(const std::string& path)
+        {
+            BinaryReader file(path);
+            const std::uint64_t file_size = std::filesystem::file_size(path);
+
+            SurfaceHeader header{};
+            file.read_at(0, &header, sizeof(header));
+            if (std::memcmp(header.magic, surface_magic, sizeof(header.magic)) != 0
+                || header.version != surface_format_version || header.header_size != sizeof(SurfaceHeader))
+            {
+                throw std::invalid_argument("Not a binary surface file: " + path + ".");
+            }
+            // every array must lie inside the file (written so that nothing can wrap)
+            auto inside = [file_size](std::uint64_t offset, std::uint64_t count)
+            {
+                return count <= file_size / sizeof(double) && offset <= file_size - count * sizeof(double);
+            };
+            const std::uint64_t n_data = header.nrows * header.ncols;
+            if ((header.ncols != 0 && n_data / header.ncols != header.nrows)
+                || !inside(header.x_offset, header.nrows)
+                || !inside(header.y_offset, header.ncols)
+                || !inside(header.data_offset, n_data))
+            {
+                throw std::invalid_argument("Truncated surface file " + path + ".");
+            }
+
+            SurfaceFile out;
+            header.x_name[23] = header.y_name[23] = header.value_name[23] = '\0';
+            out.names = SurfaceNames{ header.x_name, header.y_name, header.value_name };
+            out.x.resize(header.nrows);
+            out.y.resize(header.ncols);
+            out.values = Grid2D<double>(header.nrows, header.ncols);
+            file.read_at(header.x_offset, out.x.data(), out.x.size() * sizeof(double));
+            file.read_at(header.y_offset, out.y.data(), out.y.size() * sizeof(double));
+            file.read_at(header.data_offset, out.values.data.data(), out.values.data.size() * sizeof(double));
+            return out;
+        }
+
+        // --- Sinks ---
+        CsvSurfaceSink::CsvSurfaceSink(const std::string& path, SurfaceCsv format)
+            : path_(path), writer_(path), format_(std::move(format))
+        {
+            check_precision(format_.precision);
+        }
+
+        void CsvSurfaceSink::begin(std::span<const double> x, std::span<const double> y)
+        {
+            x_.assign(x.begin(), x.end());
+            y_.assign(y.begin(), y.end());
+            writer_.write(format_.x_name + "," + format_.y_name + "," + format_.value_name + "\n");
+            rows_written_ = 0;
+        }
+
+        void CsvSurfaceSink::write_row(std::size_t i, std::span<const double> values)
+        {
+            if (i != rows_written_ || i >= x_.size() || values.size() != y_.size())
+            {
+                throw std::invalid_argument("Surface rows must arrive in order with one value per column.");
+            }
+            for (std::size_t j = 0; j < values.size(); ++j)
+            {
+                const double fields[3] = { x_[i], y_[j], values[j] };
+                writer_.write_row(fields, format_.precision);
+            }
+            ++rows_written_;
+        }
+
+        void CsvSurfaceSink::end()
+        {
+            if (rows_written_ != x_.size())
+            {
+                throw std::runtime_error("Surface file " + path_ + " is missing rows.");
+            }
+            writer_.close();
+        }
+
+        BinarySurfaceSink::BinarySurfaceSink(const std::string& path, SurfaceNames names)
+            : path_(path), names_(std::move(names))
+        {
+            if constexpr (std::endian::native != std::endian::little)
+            {
+                throw std::invalid_argument("Binary surfaces are little-endian only.");
+            }
+            SurfaceHeader header{};
+            copy_name(header.x_name, names_.x); // validate the names before creating the file
+            copy_name(header.y_name, names_.y);
+            copy_name(header.value_name, names_.value);
+
+            file_ = std::fopen(path.c_str(), "wb");
+            if (file_ == nullptr)
+            {
+                throw std::invalid_argument("Cannot open the file " + path + " for writing.");
+            }
+        }
+
+        BinarySurfaceSink::~BinarySurfaceSink()
+        {
+            if (file_ != nullptr) std::fclose(file_);
+        }
+
+        void BinarySurfaceSink::begin(std::span<const double> x, std::span<const double> y)
+        {
+            SurfaceHeader header{};
+            std::memcpy(header.magic, surface_magic, sizeof(header.magic));
+            header.version = surface_format_version;
+            header.header_size = sizeof(SurfaceHeader);
+            header.nrows = x.size();
+            header.ncols = y.size();
+            header.x_offset = aligned(sizeof(SurfaceHeader));
+            header.y_offset = aligned(header.x_offset + x.size_bytes());
+            header.data_offset = aligned(header.y_offset + y.size_bytes());
+            copy_name(header.x_name, names_.x);
+            copy_name(header.y_name, names_.y);
+            copy_name(header.value_name, names_.value);
+
+            write_at(file_, 0, &header, sizeof(header), path_);
+            write_at(file_, header.x_offset, x.data(), x.size_bytes(), path_);
+            write_at(file_, header.y_offset, y.data(), y.size_bytes(), path_);
+            // the rows follow contiguously from data_offset
+            pad_to(file_, header.data_offset, path_);
+            nrows_ = x.size();
+            ncols_ = y.size();
+            rows_written_ = 0;
+        }
+
+        void BinarySurfaceSink::write_row(std::size_t i, std::span<const double> values)
+        {
+            if (i != rows_written_ || i >= nrows_ || values.size() != ncols_)
+            {
+                throw std::invalid_argument("Surface rows must arrive in order with one value per column.");
+            }
+            if (std::fwrite(values.data(), sizeof(double), values.size(), file_) != values.size())
+            {
+                throw std::runtime_error("Failed to write the surface file " + path_ + ".");
+            }
+            ++rows_written_;
+        }
+
+        void BinarySurfaceSink::end()
+        {
+            if (rows_written_ != nrows_)
+            {
+                throw std::runtime_error("Surface file " + path_ + " is missing rows.");
+            }
+            std::FILE* f = file_;
+            file_ = nullptr;
+            if (std::fclose(f) != 0)
+            {
+                throw std::runtime_error("Failed to close the surface file " + path_ + ".");
+            }
+        }
+    }
+}
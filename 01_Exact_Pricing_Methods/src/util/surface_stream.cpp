@@ -0,0 +1,144 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |       surface_stream.cpp        |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the
+                            streaming surface generator.
+*/
+
+#include "../../include/util/surface_stream.hpp"
+#include "../../include/util/bounded_queue.hpp"
+#include "../../include/util/mesh.hpp"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace yvan
+{
+    namespace util
+    {
+        namespace
+        {
+            // values per evaluator call when rows_per_batch is not given
+            constexpr std::size_t default_batch_values = 4096;
+
+            // Rows [first_row, first_row + n_rows) of the surface
+            struct Block
+            {
+                std::size_t first_row = 0;
+                std::size_t n_rows = 0;
+                std::vector<double> values; // n_rows x ncols (row-major)
+            };
+        }
+
+        void stream_surface(const option::OptionParams& base,
+                            double option::OptionParams::* field_x,
+                            double start_x, double end_x, double step_x,
+                            double option::OptionParams::* field_y,
+                            double start_y, double end_y, double step_y,
+                            const RowEvaluator& evaluate,
+                            const std::vector<SurfaceSink*>& sinks,
+                            const SurfaceStreamOptions& options)
+        {
+            // Validate inputs
+            if (!evaluate)
+            {
+                throw std::invalid_argument("A surface needs an evaluator.");
+            }
+            if (sinks.empty() || std::find(sinks.begin(), sinks.end(), nullptr) != sinks.end())
+            {
+                throw std::invalid_argument("A surface needs at least one (non-null) sink.");
+            }
+            if (options.queue_capacity == 0)
+            {
+                throw std::invalid_argument("Queue capacity must be positive.");
+            }
+
+            // same axes as sweep_2d
+            const std::vector<double> x = mesh_vector(start_x, end_x, step_x);
+            const std::vector<double> y = mesh_vector(start_y, end_y, step_y);
+            const std::size_t ncols = y.size();
+            const std::size_t rows_per_batch = options.rows_per_batch > 0
+                ? options.rows_per_batch
+                : std::max<std::size_t>(1, default_batch_values / ncols);
+
+            // --- recycled buffers: free -> (evaluated) -> full -> (written) -> free ---
+            const std::size_t n_blocks = options.queue_capacity + 2;
+            BoundedQueue<Block> free_blocks(n_blocks);
+            BoundedQueue<Block> full_blocks(options.queue_capacity);
+            for (std::size_t k = 0; k < n_blocks; ++k)
+            {
+                free_blocks.push(Block{ 0, 0, std::vector<double>(rows_per_batch * ncols) });
+            }
+
+            for (SurfaceSink* sink : sinks) sink->begin(x, y);
+
+            // --- writer thread ---
+            std::exception_ptr writer_error;
+            std::thread writer([&]
+            {
+                try
+                {
+                    Block block;
+                    while (full_blocks.pop(block))
+                    {
+                        for (std::size_t r = 0; r < block.n_rows; ++r)
+                        {
+                            const std::span<const double> row(block.values.data() + r * ncols, ncols);
+                            for (SurfaceSink* sink : sinks) sink->write_row(block.first_row + r, row);
+                        }
+                        free_blocks.push(std::move(block));
+                    }
+                }
+                catch (...)
+                {
+                    writer_error = std::current_exception();
+                    free_blocks.close(); // unblocks the producer
+                    full_blocks.close();
+                }
+            });
+
+            // --- producer (calling thread) ---
+            std::exception_ptr producer_error;
+            try
+            {
+                // the y field of the parameters never changes: set it once
+                std::vector<option::OptionParams> params(rows_per_batch * ncols, base);
+                for (std::size_t r = 0; r < rows_per_batch; ++r)
+                {
+                    for (std::size_t j = 0; j < ncols; ++j) params[r * ncols + j].*field_y = y[j];
+                }
+
+                for (std::size_t first = 0; first < x.size(); first += rows_per_batch)
+                {
+                    Block block;
+                    if (!free_blocks.pop(block)) break; // the writer failed
+                    block.first_row = first;
+                    block.n_rows = std::min(rows_per_batch, x.size() - first);
+                    const std::size_t n = block.n_rows * ncols;
+                    for (std::size_t r = 0; r < block.n_rows; ++r)
+                    {
+                        for (std::size_t j = 0; j < ncols; ++j) params[r * ncols + j].*field_x = x[first + r];
+                    }
+                    evaluate(std::span<const option::OptionParams>(params.data(), n),
+                             std::span<double>(block.values.data(), n));
+                    if (!full_blocks.push(std::move(block))) break; // the writer failed
+                }
+            }
+            catch (...)
+            {
+                producer_error = std::current_exception();
+            }
+            full_blocks.close(); // the writer drains what is left and stops
+            writer.join();
+
+            if (producer_error) std::rethrow_exception(producer_error);
+            if (writer_error) std::rethrow_exception(writer_error);
+            for (SurfaceSink* sink : sinks) sink->end();
+        }
+    }
+}
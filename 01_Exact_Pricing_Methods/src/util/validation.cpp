@@ -0,0 +1,146 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |          validation.cpp         |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is the implementation of the batch
+                            validation of OptionParams.
+*/
+
+#include "../../include/util/validation.hpp"
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace yvan
+{
+    namespace util
+    {
+        namespace
+        {
+            // Buffers of evaluate_valid (taken out of the thread_local slot while in use,
+            // so an evaluator that calls evaluate_valid again gets its own)
+            struct Scratch
+            {
+                std::vector<std::uint8_t> faults;
+                std::vector<option::OptionParams> valid;
+                std::vector<double> values;
+            };
+        }
+
+        // --- Validation ---
+        std::size_t validate_batch(std::span<const option::OptionParams> batch, std::span<std::uint8_t> faults)
+        {
+            if (faults.size() != batch.size())
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            std::size_t n_invalid = 0;
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                faults[i] = params_faults(batch[i]);
+                n_invalid += faults[i] != 0;
+            }
+            return n_invalid;
+        }
+
+        std::size_t validate_batch(const option::Portfolio& book, std::span<std::uint8_t> faults)
+        {
+            if (faults.size() != book.size())
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            const double* s = book.asset_prices().data();
+            const double* k = book.strike_prices().data();
+            const double* r = book.rates().data();
+            const double* b = book.costs_of_carry().data();
+            const double* v = book.volatilities().data();
+            const double* t = book.exercise_times().data();
+            const option::OptionType* type = book.option_types().data();
+
+            // one column at a time: simple loops over contiguous doubles
+            for (std::size_t i = 0; i < faults.size(); ++i)
+            {
+                faults[i] = static_cast<std::uint8_t>((s[i] < 0.0) * fault::negative_asset_price
+                                                     | (k[i] < 0.0) * fault::negative_strike_price
+                                                     | (v[i] < 0.0) * fault::negative_volatility
+                                                     | (t[i] < 0.0) * fault::negative_exercise_time);
+            }
+            for (const double* column : { s, k, r, b, v, t })
+            {
+                for (std::size_t i = 0; i < faults.size(); ++i)
+                {
+                    // x - x is 0 for finite x, NaN otherwise
+                    faults[i] |= !(column[i] - column[i] == 0.0) * fault::not_finite;
+                }
+            }
+            std::size_t n_invalid = 0;
+            for (std::size_t i = 0; i < faults.size(); ++i)
+            {
+                const bool known_type = (type[i] == option::OptionType::Call) | (type[i] == option::OptionType::Put);
+                faults[i] |= !known_type * fault::invalid_type;
+                n_invalid += faults[i] != 0;
+            }
+            return n_invalid;
+        }
+
+        const char* fault_message(std::uint8_t faults) noexcept
+        {
+            if (faults & fault::negative_asset_price) return "Asset price must be non-negative.";
+            if (faults & fault::negative_strike_price) return "Strike price must be non-negative.";
+            if (faults & fault::negative_volatility) return "Volatility must be non-negative.";
+            if (faults & fault::negative_exercise_time) return "Exercise time cannot be negative.";
+            if (faults & fault::invalid_type) return "Invalid option type.";
+            if (faults & fault::not_finite) return "Parameters must be finite.";
+            return nullptr;
+        }
+
+        // --- Batches With Invalid Rows ---
+        std::size_t evaluate_valid(std::span<const option::OptionParams> batch, std::span<double> out,
+                                   InvalidRows policy, std::span<std::uint8_t> faults,
+                                   const BatchEvaluator& evaluate)
+        {
+            if (out.size() != batch.size() || (!faults.empty() && faults.size() != batch.size()))
+            {
+                throw std::invalid_argument("Output buffer size must match the batch size.");
+            }
+            thread_local Scratch cache;
+            Scratch s = std::move(cache);
+
+            if (faults.empty())
+            {
+                s.faults.resize(batch.size());
+                faults = s.faults;
+            }
+            const std::size_t n_invalid = validate_batch(batch, faults);
+            if (n_invalid == 0)
+            {
+                // usual case: no copy
+                evaluate(batch, out);
+            }
+            else
+            {
+                s.valid.clear();
+                for (std::size_t i = 0; i < batch.size(); ++i)
+                {
+                    if (faults[i] == 0) s.valid.push_back(batch[i]);
+                }
+                s.values.resize(s.valid.size());
+                if (!s.valid.empty())
+                {
+                    evaluate(std::span<const option::OptionParams>(s.valid), std::span<double>(s.values));
+                }
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                for (std::size_t i = 0, k = 0; i < batch.size(); ++i)
+                {
+                    if (faults[i] == 0) out[i] = s.values[k++];
+                    else if (policy == InvalidRows::NaN) out[i] = nan;
+                }
+            }
+            cache = std::move(s); // an exception of evaluate only loses the buffers
+            return n_invalid;
+        }
+    }
+}
@@ -5,11 +5,29 @@ Copyright © 2025 Yvan Richard
 This is the main test file for the Exact Pricing Methods module.
 It attempts to cover a broad range of tests to ensure the correctness
 and robustness of the implemented classes and functions.
+
+    ./main [--jobs <n>] [--filter <pattern>]
+
+--jobs runs the tests on n threads (0: one per hardware thread, default 1)
+and --filter runs the tests whose name matches the pattern ('*' and '?'
+wildcards, or any part of the name).
 */
 
+#include <iostream>
+#include <stdexcept>
 #include "support/unit_tests_framework.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
-    return yvan::test::run_all_tests() ? 0 : 1; // return 0 if all tests passed, 1 otherwise
-}
\ No newline at end of file
+    yvan::test::RunOptions options;
+    try
+    {
+        options = yvan::test::parse_run_options(argc, argv);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cerr << e.what() << "\nUsage: " << argv[0] << " [--jobs <n>] [--filter <pattern>]\n";
+        return 2;
+    }
+    return yvan::test::run_all_tests(options) ? 0 : 1; // return 0 if all tests passed, 1 otherwise
+}
@@ -0,0 +1,377 @@
+/*
+                            +–––––––––––––––––––––––––––––––––+
+                            |       Benchmark Framework       |
+                            |  Copyright © 2025 Yvan Richard  |
+                            +–––––––––––––––––––––––––––––––––+
+
+                            This is a lightweight header only
+                            micro-benchmark framework, the companion
+                            of the unit tests framework: benchmarks
+                            are registered with BENCHMARK_CASE(name)
+                            and run by run_all_benchmarks().
+
+                            Each benchmark is calibrated (the number
+                            of calls per sample grows until a sample
+                            lasts min_time), then timed over several
+                            samples. The median and the median
+                            absolute deviation (MAD) of the samples
+                            are reported in ns per operation, with
+                            the throughput, and the heap bytes and
+                            allocations per operation when the binary
+                            counts them (YB_COUNT_ALLOCATIONS()). The
+                            results can also be written as JSON to
+                            track them across commits.
+*/
+
+#ifndef benchmark_framework_hpp
+#define benchmark_framework_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace yvan
+{
+    namespace bench
+    {
+        // --- Statistics ---
+        // median(): middle value (mean of the two middle values for an even count)
+        inline double median(std::vector<double> values)
+        {
+            if (values.empty()) return 0.0;
+            const std::size_t mid = values.size() / 2;
+            std::nth_element(values.begin(), values.begin() + mid, values.end());
+            double m = values[mid];
+            if (values.size() % 2 == 0)
+            {
+                m = 0.5 * (m + *std::max_element(values.begin(), values.begin() + mid));
+            }
+            return m;
+        }
+
+        // mad(): median absolute deviation from the median (robust spread)
+        inline double mad(const std::vector<double>& values)
+        {
+            const double m = median(values);
+            std::vector<double> deviations;
+            deviations.reserve(values.size());
+            for (double v : values) deviations.push_back(std::fabs(v - m));
+            return median(std::move(deviations));
+        }
+
+        // --- Optimization Barriers ---
+        // do_not_optimize(): the compiler must assume value is read (the computation stays)
+        template<typename T>
+        inline void do_not_optimize(const T& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            static volatile const void* sink;
+            sink = &value;
+#endif
+        }
+
+        // clobber_memory(): the compiler must assume memory is read and written
+        inline void clobber_memory()
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : : "memory");
+#else
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+        }
+
+        // --- Allocation Counter ---
+        struct AllocationCounter
+        {
+            std::atomic<std::size_t> bytes{ 0 };
+            std::atomic<std::size_t> count{ 0 };
+            bool enabled = false; // set by YB_COUNT_ALLOCATIONS()
+        };
+
+        inline AllocationCounter& allocations()
+        {
+            static AllocationCounter counter;
+            return counter;
+        }
+
+        // --- Options & Results ---
+        struct Options
+        {
+            std::string filter;          // run the benchmarks whose name contains it
+            std::string json;            // JSON output file (empty: none)
+            std::string label;           // free text copied to the JSON context (e.g. a commit)
+            double min_time = 0.01;      // seconds per sample
+            int samples = 15;
+        };
+
+        struct Result
+        {
+            std::string name;
+            std::size_t ops_per_call = 1;   // operations done by one call of the body
+            std::size_t calls = 0;          // calls per sample
+            int samples = 0;
+            double ns_per_op = 0.0;         // median over the samples
+            double mad_ns = 0.0;            // MAD of the samples
+            double min_ns = 0.0;            // fastest sample
+            double ops_per_s = 0.0;
+            double bytes_per_op = -1.0;     // heap bytes allocated (-1: not counted)
+            double allocs_per_op = -1.0;
+            std::string failure;            // why the benchmark failed (empty if it ran)
+        };
+
+        // State of the benchmark being run (received by the body of BENCHMARK_CASE)
+        class State
+        {
+        private:
+            const Options& options_;
+            Result& result_;
+            bool done_ = false;
+
+            template<typename F>
+            static double time_calls(std::size_t calls, F& body)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                for (std::size_t c = 0; c < calls; ++c) body();
+                clobber_memory();
+                const auto t1 = std::chrono::steady_clock::now();
+                return std::chrono::duration<double>(t1 - t0).count();
+            }
+
+        public:
+            State(const Options& options, Result& result) : options_(options), result_(result) {}
+
+            // run(): time body (ops_per_call operations per call); once per benchmark
+            // throws std::logic_error if called twice
+            template<typename F>
+            void run(std::size_t ops_per_call, F&& body)
+            {
+                if (done_) throw std::logic_error("State::run() must be called once per benchmark.");
+                done_ = true;
+                result_.ops_per_call = std::max<std::size_t>(ops_per_call, 1);
+
+                // --- calibration (also the warm-up) ---
+                std::size_t calls = 1;
+                for (double sec = time_calls(calls, body); sec < options_.min_time && calls < (std::size_t{ 1 } << 40); )
+                {
+                    const double grow = sec > 0.0 ? std::min(10.0, 1.2 * options_.min_time / sec) : 10.0;
+                    calls = std::max(calls + 1, static_cast<std::size_t>(static_cast<double>(calls) * grow));
+                    sec = time_calls(calls, body);
+                }
+
+                // --- samples ---
+                AllocationCounter& counter = allocations();
+                const std::size_t bytes0 = counter.bytes.load(), count0 = counter.count.load();
+                std::vector<double> ns(std::max(options_.samples, 1));
+                const double ops = static_cast<double>(calls) * static_cast<double>(result_.ops_per_call);
+                for (double& s : ns) s = time_calls(calls, body) * 1e9 / ops;
+
+                result_.calls = calls;
+                result_.samples = static_cast<int>(ns.size());
+                result_.ns_per_op = median(ns);
+                result_.mad_ns = mad(ns);
+                result_.min_ns = *std::min_element(ns.begin(), ns.end());
+                result_.ops_per_s = result_.ns_per_op > 0.0 ? 1e9 / result_.ns_per_op : 0.0;
+                if (counter.enabled)
+                {
+                    const double total_ops = ops * static_cast<double>(ns.size());
+                    result_.bytes_per_op = static_cast<double>(counter.bytes.load() - bytes0) / total_ops;
+                    result_.allocs_per_op = static_cast<double>(counter.count.load() - count0) / total_ops;
+                }
+            }
+        };
+
+        // --- Registry ---
+        struct Benchmark
+        {
+            std::string name;
+            std::function<void(State&)> func;
+        };
+
+        inline std::vector<Benchmark>& registry()
+        {
+            static std::vector<Benchmark> benchmarks;
+            return benchmarks;
+        }
+
+        inline void register_benchmark(const std::string& name, std::function<void(State&)> func)
+        {
+            registry().push_back({ name, func });
+        }
+
+        // BENCHMARK_CASE(name): defines and registers void name(yvan::bench::State& state)
+        // (set up the data, then time the hot part with state.run(ops_per_call, body))
+        #define BENCHMARK_CASE(name) \
+        void name(yvan::bench::State& state); \
+        struct name##_bench_registrar \
+        { \
+            name##_bench_registrar() { yvan::bench::register_benchmark(#name, name); } \
+        }; \
+        static name##_bench_registrar global_##name##_bench_registrar; \
+        void name([[maybe_unused]] yvan::bench::State& state)
+
+        // YB_COUNT_ALLOCATIONS(): replaces the global operator new / delete of the
+        // binary to count heap allocations (use once, at global scope, in one file)
+        #define YB_COUNT_ALLOCATIONS() \
+        static const bool yb_allocations_enabled = (yvan::bench::allocations().enabled = true); \
+        void* operator new(std::size_t size) \
+        { \
+            yvan::bench::allocations().bytes.fetch_add(size, std::memory_order_relaxed); \
+            yvan::bench::allocations().count.fetch_add(1, std::memory_order_relaxed); \
+            if (void* ptr = std::malloc(size ? size : 1)) return ptr; \
+            throw std::bad_alloc{}; \
+        } \
+        void* operator new[](std::size_t size) { return operator new(size); } \
+        YB_IGNORE_MISMATCHED_NEW_DELETE_BEGIN \
+        void operator delete(void* ptr) noexcept { std::free(ptr); } \
+        void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); } \
+        void operator delete[](void* ptr) noexcept { std::free(ptr); } \
+        void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); } \
+        YB_IGNORE_MISMATCHED_NEW_DELETE_END
+
+        // (GCC cannot see that new and delete are replaced together and warns when inlining)
+        #if defined(__GNUC__) && !defined(__clang__)
+        #define YB_IGNORE_MISMATCHED_NEW_DELETE_BEGIN \
+            _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wmismatched-new-delete\"")
+        #define YB_IGNORE_MISMATCHED_NEW_DELETE_END _Pragma("GCC diagnostic pop")
+        #else
+        #define YB_IGNORE_MISMATCHED_NEW_DELETE_BEGIN
+        #define YB_IGNORE_MISMATCHED_NEW_DELETE_END
+        #endif
+
+        // --- Output ---
+        inline std::string json_string(const std::string& s)
+        {
+            std::string out = "\"";
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\') out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) out += c;
+            }
+            return out + "\"";
+        }
+
+        // write_json(): {"context": {...}, "benchmarks": [{...}, ...]}
+        // throws std::runtime_error if the file cannot be written
+        inline void write_json(const std::string& path, const Options& options, const std::vector<Result>& results)
+        {
+            std::FILE* file = std::fopen(path.c_str(), "w");
+            if (file == nullptr) throw std::runtime_error("Cannot open the file " + path + " for writing.");
+
+            char date[32] = "";
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+#if defined(__VERSION__)
+            const std::string compiler = __VERSION__;
+#else
+            const std::string compiler = "unknown";
+#endif
+            std::fprintf(file, "{\n  \"context\": {\"date\": \"%s\", \"compiler\": %s, \"label\": %s, "
+                               "\"samples\": %d, \"min_time_s\": %g},\n  \"benchmarks\": [\n",
+                         date, json_string(compiler).c_str(), json_string(options.label).c_str(),
+                         options.samples, options.min_time);
+            for (std::size_t k = 0; k < results.size(); ++k)
+            {
+                const Result& r = results[k];
+                std::fprintf(file, "    {\"name\": %s, \"ns_per_op\": %.6g, \"mad_ns\": %.6g, \"min_ns\": %.6g, "
+                                   "\"ops_per_s\": %.6g, \"bytes_per_op\": %.6g, \"allocs_per_op\": %.6g, "
+                                   "\"ops_per_call\": %zu, \"calls\": %zu, \"samples\": %d, \"failure\": %s}%s\n",
+                             json_string(r.name).c_str(), r.ns_per_op, r.mad_ns, r.min_ns, r.ops_per_s,
+                             r.bytes_per_op, r.allocs_per_op, r.ops_per_call, r.calls, r.samples,
+                             r.failure.empty() ? "null" : json_string(r.failure).c_str(),
+                             k + 1 < results.size() ? "," : "");
+            }
+            std::fprintf(file, "  ]\n}\n");
+            if (std::fclose(file) != 0) throw std::runtime_error("Failed to write the file " + path + ".");
+        }
+
+        // --- Runner ---
+        // parse_options(): --filter <text> --json <file> --label <text> --min-time <s> --samples <n>
+        // throws std::invalid_argument on an unknown or incomplete option
+        inline Options parse_options(int argc, char* argv[])
+        {
+            Options options;
+            for (int k = 1; k < argc; ++k)
+            {
+                const std::string arg = argv[k];
+                if (k + 1 >= argc) throw std::invalid_argument("Missing value for " + arg + ".");
+                const char* value = argv[++k];
+                if (arg == "--filter") options.filter = value;
+                else if (arg == "--json") options.json = value;
+                else if (arg == "--label") options.label = value;
+                else if (arg == "--min-time") options.min_time = std::atof(value);
+                else if (arg == "--samples") options.samples = std::atoi(value);
+                else throw std::invalid_argument("Unknown option " + arg + ".");
+            }
+            if (!(options.min_time > 0.0) || options.samples < 1)
+            {
+                throw std::invalid_argument("--min-time and --samples must be positive.");
+            }
+            return options;
+        }
+
+        // run_all_benchmarks(): run the registered benchmarks matching the filter, print a
+        // table and write the JSON file if asked; returns the results, including the
+        // failed benchmarks (a body that throws or never calls state.run()) with their failure
+        inline std::vector<Result> run_all_benchmarks(const Options& options)
+        {
+            std::vector<Result> results;
+            std::printf("%-44s %12s %10s %14s %12s %10s\n", "benchmark", "ns/op", "+/- MAD", "ops/s", "bytes/op", "allocs/op");
+            for (const Benchmark& b : registry())
+            {
+                if (!options.filter.empty() && b.name.find(options.filter) == std::string::npos) continue;
+                Result r;
+                r.name = b.name;
+                try
+                {
+                    State state(options, r);
+                    b.func(state);
+                }
+                catch (const std::exception& e)
+                {
+                    r.failure = e.what();
+                }
+                if (r.failure.empty() && r.samples == 0) r.failure = "state.run() was not called";
+                if (!r.failure.empty())
+                {
+                    std::printf("%-44s failed: %s\n", b.name.c_str(), r.failure.c_str());
+                    std::fflush(stdout);
+                    results.push_back(r);
+                    continue;
+                }
+                char bytes[32] = "-", allocs[32] = "-";
+                if (r.bytes_per_op >= 0.0)
+                {
+                    std::snprintf(bytes, sizeof(bytes), "%.1f", r.bytes_per_op);
+                    std::snprintf(allocs, sizeof(allocs), "%.3f", r.allocs_per_op);
+                }
+                std::printf("%-44s %12.2f %10.2f %14.4g %12s %10s\n",
+                            r.name.c_str(), r.ns_per_op, r.mad_ns, r.ops_per_s, bytes, allocs);
+                std::fflush(stdout);
+                results.push_back(r);
+            }
+            if (!options.json.empty()) write_json(options.json, options, results);
+            return results;
+        }
+
+        // failures(): number of failed benchmarks (a main returns non-zero if any)
+        inline std::size_t failures(const std::vector<Result>& results)
+        {
+            return static_cast<std::size_t>(std::count_if(results.begin(), results.end(),
+                [](const Result& r) { return !r.failure.empty(); }));
+        }
+    }
+}
+
+#endif // benchmark_framework_hpp
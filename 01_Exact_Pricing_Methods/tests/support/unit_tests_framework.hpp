@@ -7,17 +7,40 @@
                             This is a lightweight header only
                             unit tests framework for creating
                             and running unit tests in C++20.
+
+                            Performance cases (PERF_CASE) are
+                            timed with the benchmark framework and
+                            compared with a baseline file, so the
+                            same runner catches throughput drops.
+
+                            The runner can run the tests on several
+                            threads (the output of each test is
+                            buffered and printed in registry order),
+                            reports the wall time of every test and
+                            filters the tests by name.
 */
 
 #ifndef unit_tests_framework_hpp
 #define unit_tests_framework_hpp
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <cmath>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "benchmark_framework.hpp"
 
 
 namespace yvan
@@ -30,6 +53,7 @@ namespace yvan
         {
             std::string name;
             std::function<bool()> func; // function returning bool (pass/fail)
+            bool serial = false;        // never run concurrently with other tests (e.g. timed cases)
         };
 
         
@@ -41,17 +65,33 @@ namespace yvan
         }
 
         // Register a Test Case
-        inline void register_test(const std::string& name, std::function<bool()> func)
+        inline void register_test(const std::string& name, std::function<bool()> func, bool serial = false)
         {
             // registry() calls the static vector and we push back the new test case
-            registry().push_back({ name, func });
+            registry().push_back({ name, func, serial });
+        }
+
+        // Test Output
+        // The stream of the test running on this thread: nullptr writes straight to
+        // std::cout / std::cerr, the parallel runner points it to a buffer per test
+        inline std::ostream*& captured_output()
+        {
+            thread_local std::ostream* output = nullptr;
+            return output;
+        }
+
+        // test_output(): where the running test writes its messages
+        inline std::ostream& test_output(std::ostream& fallback)
+        {
+            std::ostream* output = captured_output();
+            return output ? *output : fallback;
         }
 
         // Failure Handling
         struct AssertFailure { std::string message; };
         inline void faile_assert(const char *file, int line, const std::string& msg, bool fatal)
         {
-            std::cerr << "Assertion failed at " << file << ":" << line << " - " << msg <<
+            test_output(std::cerr) << "Assertion failed at " << file << ":" << line << " - " << msg <<
             (fatal ? "[FATAL]" : "[NON-FATAL]") << "\n";
             if (fatal) throw AssertFailure{ msg };
         }
@@ -162,47 +202,317 @@ namespace yvan
         bool name() /* actual definition of the test case function */
 
 
+        // Performance Cases
+        // ----------------------------
+        /*
+        Note:
+
+        PERF_CASE(name) defines a test case whose body is timed like a benchmark
+        (set up the data, then state.run(ops_per_call, body)). The median ns per
+        operation is compared with the baseline of the case: the test fails when
+        it is slower by more than the threshold and by more than 3 MADs of the
+        samples (noise alone should not fail it). A slow measurement is repeated
+        once before failing. A case without a baseline passes on its measurement.
+
+        Timing is opt-in: by default the performance cases pass without being
+        timed, so a plain test run neither depends on the load of the machine
+        nor writes any file. The baseline file has one line per case:
+        name ns_per_op mad_ns. It only makes sense for one machine and one
+        build, so it is not versioned, and it is only written on request.
+        The settings come from the environment:
+            YT_PERF=1          time the performance cases
+            YT_PERF_BASELINE   path of the baseline file (perf_baseline.txt)
+            YT_PERF_THRESHOLD  allowed slowdown, as a fraction (0.25)
+            YT_PERF_UPDATE=1   time the cases and write their measurements as the baselines
+        */
+        struct PerfConfig
+        {
+            std::string baseline_path = "perf_baseline.txt";
+            double threshold = 0.25;
+            bool enabled = false;
+            bool update = false;
+            bench::Options timing;  // min_time and samples of a measurement
+        };
+
+        inline PerfConfig& perf_config()
+        {
+            static PerfConfig config = []
+            {
+                PerfConfig c;
+                if (const char* v = std::getenv("YT_PERF_BASELINE")) c.baseline_path = v;
+                if (const char* v = std::getenv("YT_PERF_THRESHOLD")) c.threshold = std::atof(v);
+                if (const char* v = std::getenv("YT_PERF")) c.enabled = std::string(v) == "1";
+                if (const char* v = std::getenv("YT_PERF_UPDATE")) c.update = std::string(v) == "1";
+                c.enabled = c.enabled || c.update;
+                return c;
+            }();
+            return config;
+        }
+
+        struct PerfBaseline
+        {
+            double ns_per_op = 0.0;
+            double mad_ns = 0.0;
+        };
+
+        // load_perf_baselines(): baselines by case name (none if the file does not exist)
+        inline std::map<std::string, PerfBaseline> load_perf_baselines(const std::string& path)
+        {
+            std::map<std::string, PerfBaseline> baselines;
+            std::ifstream file(path);
+            std::string line;
+            while (std::getline(file, line))
+            {
+                if (line.empty() || line[0] == '#') continue;
+                std::istringstream fields(line);
+                std::string name;
+                PerfBaseline b;
+                if (fields >> name >> b.ns_per_op >> b.mad_ns) baselines[name] = b;
+            }
+            return baselines;
+        }
+
+        // save_perf_baselines(): throws std::runtime_error if the file cannot be written
+        inline void save_perf_baselines(const std::string& path, const std::map<std::string, PerfBaseline>& baselines)
+        {
+            std::ofstream file(path);
+            file << "# name ns_per_op mad_ns\n";
+            file.precision(6);
+            for (const auto& [name, b] : baselines) file << name << ' ' << b.ns_per_op << ' ' << b.mad_ns << '\n';
+            if (!file) throw std::runtime_error("Failed to write the file " + path + ".");
+        }
+
+        // perf_regression(): is the measurement slower than the baseline beyond the threshold and the noise?
+        inline bool perf_regression(const bench::Result& measured, const PerfBaseline& baseline, double threshold)
+        {
+            const double slowdown = measured.ns_per_op - baseline.ns_per_op;
+            return slowdown > threshold * baseline.ns_per_op
+                && slowdown > 3.0 * std::max(measured.mad_ns, baseline.mad_ns);
+        }
+
+        // measure_perf(): times body with the settings of perf_config()
+        // throws std::logic_error if body does not call state.run()
+        inline bench::Result measure_perf(const std::string& name, const std::function<void(bench::State&)>& body)
+        {
+            bench::Result result;
+            result.name = name;
+            bench::State state(perf_config().timing, result);
+            body(state);
+            if (result.samples == 0) throw std::logic_error("PERF_CASE " + name + " does not call state.run().");
+            return result;
+        }
+
+        // run_perf_case(): the test of a PERF_CASE (measure, then compare with or record the baseline)
+        inline bool run_perf_case(const std::string& name, const std::function<void(bench::State&)>& body)
+        {
+            const PerfConfig& config = perf_config();
+            if (!config.enabled)
+            {
+                test_output(std::cout) << "[perf not timed, YT_PERF=1 to time] ";
+                return true;
+            }
+
+            auto baselines = load_perf_baselines(config.baseline_path);
+            bench::Result result = measure_perf(name, body);
+            const auto it = baselines.find(name);
+            char line[128];
+            if (config.update)
+            {
+                baselines[name] = { result.ns_per_op, result.mad_ns };
+                save_perf_baselines(config.baseline_path, baselines);
+                std::snprintf(line, sizeof(line), "[%.2f ns/op, baseline recorded] ", result.ns_per_op);
+                test_output(std::cout) << line;
+                return true;
+            }
+            if (it == baselines.end())
+            {
+                std::snprintf(line, sizeof(line), "[%.2f ns/op, no baseline] ", result.ns_per_op);
+                test_output(std::cout) << line;
+                return true;
+            }
+
+            const PerfBaseline& baseline = it->second;
+            if (perf_regression(result, baseline, config.threshold))
+            {
+                bench::Result retry = measure_perf(name, body);
+                if (retry.ns_per_op < result.ns_per_op) result = retry;
+            }
+            std::snprintf(line, sizeof(line), "[%.2f ns/op, baseline %.2f, %+.1f%%] ", result.ns_per_op,
+                          baseline.ns_per_op, 100.0 * (result.ns_per_op / baseline.ns_per_op - 1.0));
+            test_output(std::cout) << line;
+            return !perf_regression(result, baseline, config.threshold);
+        }
+
+        // PERF_CASE(name): defines and registers a performance test case; the body
+        // receives yvan::bench::State& state (as a BENCHMARK_CASE). It is a serial
+        // test: the parallel runner times it alone, after the other tests
+        #define PERF_CASE(name) \
+        void name##_perf(yvan::bench::State& state); \
+        struct name##_registrar \
+        { \
+            name##_registrar() \
+            { \
+                yvan::test::register_test(YT_STRINGIFY(name), \
+                    [] { return yvan::test::run_perf_case(YT_STRINGIFY(name), name##_perf); }, true); \
+            } \
+        }; \
+        static name##_registrar global_##name##_registrar; \
+        void name##_perf([[maybe_unused]] yvan::bench::State& state)
+
+
         // Test Runner
         // ----------------------------
-        inline bool run_all_tests()
+        struct RunOptions
         {
-            const auto& tests = registry();
-            int passed = 0;
-            int failed = 0;
-            for (const auto& test : tests)
+            std::size_t n_threads = 1;  // > 1: tests run concurrently (0: one per hardware thread)
+            std::string filter;         // name pattern (empty: every test)
+        };
+
+        // match_pattern(): '*' matches any text and '?' any character; a pattern
+        // without wildcards matches the names that contain it
+        inline bool match_pattern(const std::string& pattern, const std::string& name)
+        {
+            if (pattern.find_first_of("*?") == std::string::npos) return name.find(pattern) != std::string::npos;
+            std::size_t p = 0, n = 0, star = std::string::npos, mark = 0;
+            while (n < name.size())
+            {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) { ++p; ++n; }
+                else if (p < pattern.size() && pattern[p] == '*') { star = p++; mark = n; }
+                else if (star != std::string::npos) { p = star + 1; n = ++mark; } // '*' takes one more character
+                else return false;
+            }
+            while (p < pattern.size() && pattern[p] == '*') ++p;
+            return p == pattern.size();
+        }
+
+        // parse_run_options(): --jobs <n> (-j <n>) and --filter <pattern>
+        // throws std::invalid_argument on an unknown or incomplete option
+        inline RunOptions parse_run_options(int argc, char* argv[])
+        {
+            RunOptions options;
+            for (int k = 1; k < argc; ++k)
             {
-                std::cout << "Running test: " << test.name << " ... ";
-                try
+                const std::string arg = argv[k];
+                if (k + 1 >= argc) throw std::invalid_argument("Missing value for " + arg + ".");
+                const std::string value = argv[++k];
+                if (arg == "--jobs" || arg == "-j")
                 {
-                    if (test.func())
+                    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
                     {
-                        std::cout << "PASSED\n";
-                        ++passed;
-                    }
-                    else
-                    {
-                        std::cout << "FAILED\n";
-                        ++failed;
+                        throw std::invalid_argument("--jobs expects a number of threads.");
                     }
+                    options.n_threads = std::stoul(value);
                 }
-                catch (const AssertFailure& e)
+                else if (arg == "--filter") options.filter = value;
+                else throw std::invalid_argument("Unknown option " + arg + ".");
+            }
+            return options;
+        }
+
+        // run_test(): runs one test and writes its verdict and wall time to out
+        inline bool run_test(const TestCase& test, std::ostream& out)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            bool passed = false;
+            std::string verdict;
+            try
+            {
+                passed = test.func();
+                verdict = passed ? "PASSED" : "FAILED";
+            }
+            catch (const AssertFailure& e)
+            {
+                verdict = "\033[31mFAILED with exception: " + e.message;
+            }
+            catch (const std::exception& e)
+            {
+                verdict = "\033[31mFAILED with unexpected exception: " + std::string(e.what());
+            }
+            catch (...)
+            {
+                verdict = "\033[31mFAILED with unknown exception.";
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            char time[32];
+            std::snprintf(time, sizeof(time), " (%.1f ms)", ms);
+            out << verdict << time << (verdict[0] == '\033' ? "\n\033[0m" : "\n");
+            return passed;
+        }
+
+        inline bool run_all_tests(const RunOptions& options = {})
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const std::size_t n_threads = options.n_threads ? options.n_threads
+                                                            : std::max(std::thread::hardware_concurrency(), 1u);
+            std::vector<const TestCase*> concurrent, serial;
+            for (const auto& test : registry())
+            {
+                if (!options.filter.empty() && !match_pattern(options.filter, test.name)) continue;
+                (test.serial || n_threads == 1 ? serial : concurrent).push_back(&test);
+            }
+            if (concurrent.empty() && serial.empty())
+            {
+                std::cout << "\033[31mNo test matches the filter " << options.filter << ".\n\033[0m";
+                return false;
+            }
+            int passed = 0;
+            int failed = 0;
+
+            // concurrent tests: buffered output, printed in registry order as soon as a test is done
+            if (!concurrent.empty())
+            {
+                struct Outcome
                 {
-                    std::cout << "\033[31mFAILED with exception: " << e.message << "\n\033[0m";
-                    ++failed;
-                }
-                catch (const std::exception& e)
+                    std::string output;
+                    bool passed = false;
+                    bool done = false;
+                };
+                std::vector<Outcome> outcomes(concurrent.size());
+                std::atomic<std::size_t> next{ 0 };
+                std::mutex mutex;
+                std::condition_variable finished;
+                auto worker = [&]
                 {
-                    std::cout << "\033[31mFAILED with unexpected exception: " << e.what() << "\n\033[0m";
-                    ++failed;
-                }
-                catch (...)
+                    for (std::size_t i = next++; i < concurrent.size(); i = next++)
+                    {
+                        std::ostringstream buffer;
+                        buffer << "Running test: " << concurrent[i]->name << " ... ";
+                        captured_output() = &buffer;
+                        const bool ok = run_test(*concurrent[i], buffer);
+                        captured_output() = nullptr;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            outcomes[i].output = buffer.str();
+                            outcomes[i].passed = ok;
+                            outcomes[i].done = true;
+                        }
+                        finished.notify_one();
+                    }
+                };
+                std::vector<std::thread> pool;
+                for (std::size_t t = 0; t < std::min(n_threads, concurrent.size()); ++t) pool.emplace_back(worker);
+                for (auto& outcome : outcomes)
                 {
-                    std::cout << "\033[31mFAILED with unknown exception.\n\033[0m";
-                    ++failed;
+                    std::unique_lock<std::mutex> lock(mutex);
+                    finished.wait(lock, [&] { return outcome.done; });
+                    std::cout << outcome.output << std::flush;
+                    ++(outcome.passed ? passed : failed);
                 }
+                for (auto& thread : pool) thread.join();
+            }
+
+            // serial tests: one at a time, output as it comes
+            for (const TestCase* test : serial)
+            {
+                std::cout << "Running test: " << test->name << " ... " << std::flush;
+                ++(run_test(*test, std::cout) ? passed : failed);
             }
             std::cout << "-----------------------------------\n";
 
+            char wall[64];
+            std::snprintf(wall, sizeof(wall), "Wall time: %.2f s\n",
+                          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            std::cout << wall;
             if (!failed)
             {
                 std::cout << "\033[32mAll test(s) PASSED (" << passed << " tests).\n\033[0m";
@@ -214,16 +524,7 @@ namespace yvan
             }
             return false;
         }
-
-
-
-
-        
-
-
-
-
-    } 
+    }
 }
 
 
@@ -12,6 +12,7 @@ functionality of the implemented classes and functions.
 #include "../include/options/Option.hpp"
 #include "../include/options/EuropeanOption.hpp"
 #include "../include/options/PerpetualAmericanOption.hpp"
+#include "../include/options/Portfolio.hpp"
 #include "../include/engines/IPricer.hpp"
 #include "../include/engines/BSEngine.hpp"
 #include "../include/engines/PerpetualAmericanEngine.hpp"
@@ -23,7 +24,43 @@ functionality of the implemented classes and functions.
 #include "../include/util/param_grid.hpp"
 #include "../include/util/mesh.hpp"
 #include "../include/util/distributions.hpp"
+#include "../include/util/pricing_cache.hpp"
+#include "../include/engines/CachedPricer.hpp"
+#include "../include/engines/CachedGreeks.hpp"
+#include "../include/engines/EngineConcepts.hpp"
+#include "../include/engines/ADEngineGreeks.hpp"
+#include "../include/engines/AdjointPortfolioPricer.hpp"
+#include "../include/engines/ScenarioEngine.hpp"
+#include "../include/engines/PortfolioEngine.hpp"
+#include "../include/engines/CurveBSEngine.hpp"
+#include "../include/engines/ChainPricer.hpp"
+#include "../include/engines/ParityPricer.hpp"
+#include "../include/engines/TableEngine.hpp"
+#include "../include/util/curve.hpp"
+#include "../include/util/summation.hpp"
+#include "../include/util/surface_io.hpp"
+#include "../include/util/surface_stream.hpp"
+#include "../include/util/vol_surface.hpp"
+#include "../include/util/parallel.hpp"
+#include "../include/util/params_io.hpp"
+#include "../include/util/validation.hpp"
+#include "../include/util/instrumentation.hpp"
+#include "../include/util/aad.hpp"
 #include "support/unit_tests_framework.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <new>
+#include <numeric>
+#include <span>
+#include <thread>
 
 // Using the unit test framework
 namespace yt = yvan::test;
@@ -33,6 +70,29 @@ namespace yo = yvan::option;
 namespace ye = yvan::engine;
 namespace yu = yvan::util;
 
+// --- Counting Allocator ---
+// Replacement of the global operator new/delete that counts the heap
+// allocations of each thread (used to check that the output-parameter
+// overloads of the engines never allocate, while other tests may run
+// concurrently)
+namespace { thread_local std::size_t g_allocations = 0; }
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc{};
+}
+// (GCC cannot see that new and delete are replaced together and warns when inlining)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 // --- EuropeanOption Tests ---
 
 // Test Case 001: Test EuropeanOption Constructors, Getters and Setters
@@ -869,4 +929,1960 @@ TEST_CASE(PerpetualAmericanEngine_Price_2D_Parameter_Grid)
     ASSERT_NEAR(price_surface(1, 2), expected_price, 1e-5);
 
     return true;
-}
\ No newline at end of file
+}
+
+// --- CachedPricer / CachedGreeks Tests ---
+// Test Case 022: CachedPricer returns the wrapped prices and counts hits/misses
+TEST_CASE(CachedPricer_Hits_Misses)
+{
+    // wrap a Black-Scholes engine
+    ye::BSEngine bs_engine;
+    ye::CachedPricer cached{bs_engine};
+
+    // batch with duplicates: 5 distinct configs, each repeated 4 times
+    yo::OptionParams base{};
+    auto distinct = yu::sweep_1d(base, &yo::OptionParams::strike_price, 55.0, 75.0, 5.0);
+    std::vector<yo::OptionParams> batch;
+    for (int rep = 0; rep < 4; ++rep)
+    {
+        batch.insert(batch.end(), distinct.begin(), distinct.end());
+    }
+
+    // cached prices must be identical to the direct prices
+    std::vector<double> direct = bs_engine.price(batch);
+    std::vector<double> prices = cached.price(batch);
+    ASSERT_EQ(prices.size(), direct.size());
+    for (std::size_t i = 0; i < prices.size(); ++i)
+    {
+        ASSERT_EQ(prices[i], direct[i]);
+    }
+
+    // only the first occurrence of each config is a miss
+    ASSERT_EQ(cached.misses(), 5u);
+    ASSERT_EQ(cached.hits(), 15u);
+
+    // a put with the same fields is a different key
+    yo::OptionParams put = base;
+    put.option_type = yo::OptionType::Put;
+    EXPECT_NEAR(cached.price(put), 5.84628, 1e-5);
+    ASSERT_EQ(cached.misses(), 6u);
+
+    // the greeks decorator behaves the same way
+    ye::BSEngineGreeks bs_greeks;
+    ye::CachedGreeks cached_greeks{bs_greeks};
+    ASSERT_EQ(cached_greeks.delta(base), bs_greeks.delta(base));
+    ASSERT_EQ(cached_greeks.delta(base), bs_greeks.delta(base));
+    ASSERT_EQ(cached_greeks.gamma(base), bs_greeks.gamma(base));
+    ASSERT_EQ(cached_greeks.hits(), 1u);
+    ASSERT_EQ(cached_greeks.misses(), 2u);
+
+    return true;
+}
+
+// Test Case 023: PricingCache eviction and concurrent access
+TEST_CASE(PricingCache_Eviction_and_Concurrency)
+{
+    // tiny cache: 1 shard of 8 slots, we insert many more keys
+    yu::PricingCache cache{8, 1};
+    ASSERT_EQ(cache.capacity(), 8u);
+
+    yo::OptionParams p{};
+    for (int i = 0; i < 100; ++i)
+    {
+        p.strike_price = 50.0 + i;
+        cache.insert(p, static_cast<double>(i));
+    }
+
+    // capacity is never exceeded and the last key is always retrievable
+    ASSERT_TRUE(cache.size() <= cache.capacity());
+    double value = -1.0;
+    ASSERT_TRUE(cache.find(p, value));
+    ASSERT_EQ(value, 99.0);
+
+    // several threads pricing the same duplicated batch through one decorator
+    ye::BSEngine bs_engine;
+    ye::CachedPricer cached{bs_engine, 1024, 16};
+    auto batch = yu::sweep_1d(yo::OptionParams{}, &yo::OptionParams::asset_price, 40.0, 80.0, 1.0);
+    std::vector<double> expected = bs_engine.price(batch);
+
+    const int n_threads = 4;
+    const int n_rounds = 50;
+    std::vector<int> ok(n_threads, 1);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < n_threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+        {
+            for (int round = 0; round < n_rounds; ++round)
+            {
+                std::vector<double> prices = cached.price(batch);
+                if (prices != expected) ok[t] = 0;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    for (int t = 0; t < n_threads; ++t) ASSERT_EQ(ok[t], 1);
+    ASSERT_EQ(cached.hits() + cached.misses(), static_cast<std::uint64_t>(n_threads * n_rounds * batch.size()));
+    ASSERT_TRUE(cached.misses() >= batch.size());
+
+    return true;
+}
+
+
+// --- Devirtualized Engine Path Tests ---
+// Test Case 024: price_batch / greeks_batch agree with the virtual interface
+TEST_CASE(Devirtualized_Batch_Algorithms)
+{
+    // the concrete engines satisfy the compile-time concepts
+    static_assert(ye::PricingKernel<ye::BSEngine>);
+    static_assert(ye::PricingKernel<ye::PerpetualAmericanEngine>);
+    static_assert(ye::GreeksKernel<ye::BSEngineGreeks>);
+
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    ye::PerpetualAmericanEngine pa_engine;
+
+    // 2D grid of configs (S x sigma)
+    yo::OptionParams base{};
+    auto grid = yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 40.0, 80.0, 5.0,
+        &yo::OptionParams::volatility, 0.1, 0.5, 0.1);
+
+    // generic algorithm vs the type-erased interface (one virtual call per element)
+    const ye::IPricer& pricer = bs_engine;
+    auto surface = ye::price_batch(bs_engine, grid);
+    auto surface_virtual = pricer.price(grid);
+    ASSERT_EQ(surface.nrows, grid.nrows);
+    ASSERT_EQ(surface.ncols, grid.ncols);
+    for (std::size_t i = 0; i < grid.nrows; ++i)
+    {
+        for (std::size_t j = 0; j < grid.ncols; ++j)
+        {
+            ASSERT_EQ(surface(i, j), pricer.price(grid(i, j)));
+            ASSERT_EQ(surface(i, j), surface_virtual(i, j));
+        }
+    }
+
+    // single pass delta + gamma over a 1D batch
+    auto line = yu::sweep_1d(base, &yo::OptionParams::asset_price, 40.0, 80.0, 1.0);
+    ye::GreeksBatch greeks = ye::greeks_batch(bs_greeks, line);
+    ASSERT_EQ(greeks.delta.size(), line.size());
+    for (std::size_t i = 0; i < line.size(); ++i)
+    {
+        ASSERT_EQ(greeks.delta[i], bs_greeks.delta(line[i]));
+        ASSERT_EQ(greeks.gamma[i], bs_greeks.gamma(line[i]));
+    }
+
+    // perpetual American kernel (batch 01 data of the perpetual tests)
+    yo::OptionParams pa{};
+    pa.strike_price = 100.0; pa.volatility = 0.1; pa.r = 0.1; pa.cost_of_carry = 0.02; pa.asset_price = 110.0;
+    std::vector<double> pa_prices = ye::price_batch(pa_engine, std::vector<yo::OptionParams>{pa});
+    ASSERT_NEAR(pa_prices[0], 18.5035, 1e-5);
+
+    return true;
+}
+
+
+// --- Output-Parameter Overloads Tests ---
+// Test Case 025: batch overloads writing into caller buffers do not allocate
+TEST_CASE(Output_Parameter_Overloads_No_Allocation)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    ye::PerpetualAmericanEngine pa_engine;
+    ye::NumericalEngineGreeks num_greeks{bs_engine};
+    const ye::IPricer& pricer = bs_engine;
+    const ye::IGreeks& greeks = bs_greeks;
+
+    // inputs and pre-sized outputs are allocated up front
+    yo::OptionParams base{};
+    auto line = yu::sweep_1d(base, &yo::OptionParams::asset_price, 40.0, 80.0, 0.5);
+    auto grid = yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 40.0, 80.0, 2.0,
+        &yo::OptionParams::exercise_time, 0.1, 1.0, 0.1);
+    std::vector<double> out_line(line.size());
+    yu::Grid2D<double> out_grid(grid.nrows, grid.ncols);
+    yu::Grid2D<double> out_delta(grid.nrows, grid.ncols);
+    yu::Grid2D<double> out_gamma(grid.nrows, grid.ncols);
+    std::vector<double> out_num(line.size());
+    std::vector<double> out_pa(line.size());
+
+    // hot path: every overload below must run without a single heap allocation
+    std::size_t before = g_allocations;
+    pricer.price(line, out_line);
+    pricer.price(grid, out_grid);
+    greeks.delta(grid, out_delta);
+    greeks.gamma(grid, out_gamma);
+    num_greeks.IGreeks::delta(std::span<const yo::OptionParams>(line), std::span<double>(out_num));
+    ye::price_batch(pa_engine, std::span<const yo::OptionParams>(line), std::span<double>(out_pa));
+    std::size_t after = g_allocations;
+    ASSERT_EQ(after - before, 0u);
+
+    // same values as the allocating overloads
+    ASSERT_TRUE(out_line == bs_engine.price(line));
+    ASSERT_TRUE(out_grid.data == bs_engine.price(grid).data);
+    ASSERT_TRUE(out_delta.data == bs_greeks.delta(grid).data);
+    ASSERT_TRUE(out_gamma.data == bs_greeks.gamma(grid).data);
+    ASSERT_NEAR(out_num[10], bs_greeks.delta(line[10]), 1e-4);
+
+    // a wrongly sized buffer is rejected
+    bool thrown = false;
+    try
+    {
+        yu::Grid2D<double> wrong(grid.nrows + 1, grid.ncols);
+        pricer.price(grid, wrong);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- Single / Mixed Precision Tests ---
+// Test Case 026: float kernels stay within the documented error bound vs double
+TEST_CASE(Float_and_Mixed_Precision_Error_Bound)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+
+    // batch 01 data in single precision (defaults are converted to float)
+    yo::OptionParamsF batch_01_f{};
+    ASSERT_NEAR(bs_engine.price_kernel(batch_01_f), 2.13337f, 1e-4);
+
+    // surface over the ranges of the test batches (S and sigma), calls and puts
+    yo::OptionParams base{};
+    base.strike_price = 100.0;
+    for (double T : {0.25, 1.0, 30.0})
+    {
+        base.exercise_time = T;
+        for (auto type : {yo::OptionType::Call, yo::OptionType::Put})
+        {
+            base.option_type = type;
+            auto grid = yu::sweep_2d(base,
+                &yo::OptionParams::asset_price, 50.0, 150.0, 5.0,
+                &yo::OptionParams::volatility, 0.1, 0.5, 0.1);
+
+            // same grid in float
+            yu::Grid2D<yo::OptionParamsF> grid_f(grid.nrows, grid.ncols);
+            for (std::size_t k = 0; k < grid.data.size(); ++k) grid_f.data[k] = yo::params_cast<float>(grid.data[k]);
+
+            auto prices = ye::price_batch(bs_engine, grid);
+            auto prices_f = ye::price_batch(bs_engine, grid_f);
+            auto deltas = ye::delta_batch(bs_greeks, grid);
+            auto deltas_f = ye::delta_batch(bs_greeks, grid_f);
+            auto gammas = ye::gamma_batch(bs_greeks, grid);
+            auto gammas_f = ye::gamma_batch(bs_greeks, grid_f);
+
+            std::vector<double> prices_mixed(grid.data.size());
+            ye::price_batch_mixed(bs_engine, std::span<const yo::OptionParams>(grid.data), std::span<double>(prices_mixed));
+
+            for (std::size_t k = 0; k < grid.data.size(); ++k)
+            {
+                ASSERT_NEAR(prices_f.data[k], prices.data[k], 5e-7 * base.strike_price);
+                ASSERT_NEAR(prices_mixed[k], prices.data[k], 5e-7 * base.strike_price);
+                ASSERT_NEAR(deltas_f.data[k], deltas.data[k], 1e-6);
+                ASSERT_NEAR(gammas_f.data[k], gammas.data[k], 1e-5 / base.strike_price);
+                if (gammas.data[k] > 1e-4 / base.strike_price)
+                {
+                    ASSERT_NEAR(gammas_f.data[k], gammas.data[k], 1e-5 * gammas.data[k]);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// --- ADEngineGreeks Tests ---
+// Test Case 027: forward-mode AD greeks are exact for Black-Scholes
+TEST_CASE(ADEngineGreeks_vs_Closed_Form)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    ye::ADEngineGreeks<ye::BSEngine> ad_greeks{bs_engine};
+
+    // batch_01 data of the greeks tests
+    yo::OptionParams params{};
+    params.asset_price = 105.0;
+    params.strike_price = 100.0;
+    params.exercise_time = 0.5;
+    params.r = 0.1;
+    params.cost_of_carry = 0.0;
+    params.volatility = 0.36;
+
+    for (auto type : {yo::OptionType::Call, yo::OptionType::Put})
+    {
+        params.option_type = type;
+
+        // delta and gamma match the closed form to machine precision
+        ASSERT_NEAR(ad_greeks.delta(params), bs_greeks.delta(params), 1e-12);
+        ASSERT_NEAR(ad_greeks.gamma(params), bs_greeks.gamma(params), 1e-12);
+
+        // single pass: price + all first-order sensitivities
+        ye::Sensitivities s = ad_greeks.sensitivities(params);
+        ASSERT_NEAR(s.price, bs_engine.price(params), 1e-12);
+        ASSERT_NEAR(s.delta, bs_greeks.delta(params), 1e-12);
+
+        // vega = S e^((b-r)T) n(d1) sqrt(T) (same for calls and puts)
+        double sqrt_T = std::sqrt(params.exercise_time);
+        double d1 = (std::log(params.asset_price / params.strike_price)
+                    + (params.cost_of_carry + 0.5 * params.volatility * params.volatility) * params.exercise_time)
+                    / (params.volatility * sqrt_T);
+        double vega = params.asset_price * std::exp((params.cost_of_carry - params.r) * params.exercise_time)
+                    * yu::n(d1) * sqrt_T;
+        ASSERT_NEAR(s.vega, vega, 1e-10);
+
+        // the remaining sensitivities agree with central differences
+        auto bumped = [&](double yo::OptionParams::* field, double h)
+        {
+            yo::OptionParams up = params; up.*field += h;
+            yo::OptionParams dn = params; dn.*field -= h;
+            return (bs_engine.price(up) - bs_engine.price(dn)) / (2.0 * h);
+        };
+        EXPECT_NEAR(s.dstrike, bumped(&yo::OptionParams::strike_price, 1e-4), 1e-6);
+        EXPECT_NEAR(s.rho, bumped(&yo::OptionParams::r, 1e-6), 1e-5);
+        EXPECT_NEAR(s.carry, bumped(&yo::OptionParams::cost_of_carry, 1e-6), 1e-5);
+        EXPECT_NEAR(s.theta, -bumped(&yo::OptionParams::exercise_time, 1e-6), 1e-5);
+    }
+
+    // any engine with a scalar-generic kernel works: perpetual American
+    ye::PerpetualAmericanEngine pa_engine;
+    ye::ADEngineGreeks<ye::PerpetualAmericanEngine> pa_greeks{pa_engine};
+    yo::OptionParams pa{};
+    pa.strike_price = 100.0; pa.volatility = 0.1; pa.r = 0.1; pa.cost_of_carry = 0.02; pa.asset_price = 110.0;
+    ASSERT_NEAR(pa_greeks.sensitivities(pa).price, 18.5035, 1e-4);
+    yo::OptionParams up = pa; up.asset_price += 1e-4;
+    yo::OptionParams dn = pa; dn.asset_price -= 1e-4;
+    double fd_delta = (pa_engine.price(up) - pa_engine.price(dn)) / 2e-4;
+    ASSERT_NEAR(pa_greeks.delta(pa), fd_delta, 1e-6);
+
+    return true;
+}
+
+// --- AdjointPortfolioPricer Tests ---
+// Test Case 028: adjoint gradient of a portfolio vs forward AD and bumps
+TEST_CASE(AdjointPortfolioPricer_Gradient)
+{
+    ye::BSEngine bs_engine;
+    ye::ADEngineGreeks<ye::BSEngine> ad_greeks{bs_engine};
+
+    // small book: calls and puts over a range of strikes / expiries
+    std::vector<yo::OptionParams> book;
+    std::vector<double> quantities;
+    for (int i = 0; i < 12; ++i)
+    {
+        yo::OptionParams p{};
+        p.asset_price = 100.0;
+        p.strike_price = 80.0 + 4.0 * i;
+        p.exercise_time = 0.25 + 0.2 * (i % 4);
+        p.volatility = 0.2 + 0.01 * i;
+        p.option_type = (i % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+        book.push_back(p);
+        quantities.push_back((i % 3) - 1.5);
+    }
+
+    // checkpointed and single-sweep versions agree, and both match forward AD
+    ye::AdjointPortfolioPricer aad{true};
+    ye::AdjointPortfolioPricer aad_single_sweep{false};
+    ye::AdjointRisk risk = aad.risk(book, quantities);
+    ye::AdjointRisk risk_single = aad_single_sweep.risk(book, quantities);
+
+    double value = 0.0;
+    double rate = 0.0;
+    for (std::size_t i = 0; i < book.size(); ++i)
+    {
+        ye::Sensitivities s = ad_greeks.sensitivities(book[i]);
+        value += quantities[i] * s.price;
+        rate += quantities[i] * s.rho;
+
+        const ye::PositionGradient& g = risk.positions[i];
+        ASSERT_NEAR(g.dS, quantities[i] * s.delta, 1e-10);
+        ASSERT_NEAR(g.dK, quantities[i] * s.dstrike, 1e-10);
+        ASSERT_NEAR(g.dr, quantities[i] * s.rho, 1e-10);
+        ASSERT_NEAR(g.db, quantities[i] * s.carry, 1e-10);
+        ASSERT_NEAR(g.dsigma, quantities[i] * s.vega, 1e-10);
+        ASSERT_NEAR(g.dT, -quantities[i] * s.theta, 1e-10);
+        ASSERT_NEAR(risk_single.positions[i].dsigma, g.dsigma, 1e-12);
+    }
+    ASSERT_NEAR(risk.value, value, 1e-10);
+    ASSERT_NEAR(risk.rate, rate, 1e-10);
+
+    // vol surface as a shared market input: gradient w.r.t. every node vs a bump of the node
+    yu::VolSurface surface;
+    surface.strikes = {80.0, 100.0, 120.0};
+    surface.expiries = {0.25, 0.5, 1.0};
+    surface.vols = yu::Grid2D<double>(3, 3);
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+            surface.vols(i, j) = 0.25 - 0.02 * i + 0.01 * j;
+
+    ye::AdjointRisk surface_risk = aad.risk(book, quantities, &surface);
+    ASSERT_EQ(surface_risk.vol_surface.nrows, 3u);
+
+    auto book_value = [&](const yu::VolSurface& surf)
+    {
+        double v = 0.0;
+        for (std::size_t i = 0; i < book.size(); ++i)
+        {
+            yo::OptionParams p = book[i];
+            p.volatility = surf.vol(p.strike_price, p.exercise_time);
+            v += quantities[i] * bs_engine.price(p);
+        }
+        return v;
+    };
+    ASSERT_NEAR(surface_risk.value, book_value(surface), 1e-10);
+    const double h = 1e-6;
+    for (std::size_t k = 0; k < surface.vols.data.size(); ++k)
+    {
+        yu::VolSurface up = surface; up.vols.data[k] += h;
+        yu::VolSurface dn = surface; dn.vols.data[k] -= h;
+        double fd = (book_value(up) - book_value(dn)) / (2.0 * h);
+        EXPECT_NEAR(surface_risk.vol_surface.data[k], fd, 1e-5);
+    }
+
+    // position gradients under the surface vs a bump and reprice of the position
+    // (dsigma w.r.t. the interpolated vol, dK and dT through the kernel and the surface);
+    // the strikes and expiries on a node line are skipped (kinks of the bilinear interpolation)
+    auto on_node = [](const std::vector<double>& axis, double x)
+    {
+        return std::find(axis.begin(), axis.end(), x) != axis.end();
+    };
+    std::size_t n_checked = 0;
+    for (std::size_t i = 0; i < book.size(); ++i)
+    {
+        if (on_node(surface.strikes, book[i].strike_price) || on_node(surface.expiries, book[i].exercise_time)) continue;
+        auto position_value = [&](double dvol, double dK, double dT)
+        {
+            yo::OptionParams p = book[i];
+            p.strike_price += dK;
+            p.exercise_time += dT;
+            p.volatility = surface.vol(p.strike_price, p.exercise_time) + dvol;
+            return quantities[i] * bs_engine.price(p);
+        };
+        const ye::PositionGradient& g = surface_risk.positions[i];
+        const double h_vol = 1e-6, h_K = 1e-4, h_T = 1e-6;
+        ASSERT_NEAR(g.dsigma, (position_value(h_vol, 0, 0) - position_value(-h_vol, 0, 0)) / (2.0 * h_vol), 1e-5);
+        ASSERT_NEAR(g.dK, (position_value(0, h_K, 0) - position_value(0, -h_K, 0)) / (2.0 * h_K), 1e-6);
+        ASSERT_NEAR(g.dT, (position_value(0, 0, h_T) - position_value(0, 0, -h_T)) / (2.0 * h_T), 1e-5);
+        ASSERT_TRUE(g.dsigma != 0.0);
+        ++n_checked;
+    }
+    ASSERT_TRUE(n_checked >= 6);
+    ye::AdjointRisk surface_risk_single = aad_single_sweep.risk(book, quantities, &surface);
+    for (std::size_t i = 0; i < book.size(); ++i)
+    {
+        ASSERT_NEAR(surface_risk_single.positions[i].dsigma, surface_risk.positions[i].dsigma, 1e-12);
+        ASSERT_NEAR(surface_risk_single.positions[i].dK, surface_risk.positions[i].dK, 1e-12);
+    }
+
+    return true;
+}
+
+// --- Generic NumericalEngineGreeks Tests ---
+// Test Case 029: finite differences on any pricer / any input, shared and batched bumps
+TEST_CASE(NumericalEngineGreeks_Any_Pricer_Any_Input)
+{
+    ye::BSEngine bs_engine;
+    ye::PerpetualAmericanEngine pa_engine;
+    ye::ADEngineGreeks<ye::BSEngine> ad_bs{bs_engine};
+    ye::ADEngineGreeks<ye::PerpetualAmericanEngine> ad_pa{pa_engine};
+    ye::NumericalEngineGreeks num_bs{bs_engine, 1e-4};
+    ye::NumericalEngineGreeks num_pa{pa_engine, 1e-4};
+
+    yo::OptionParams p{};
+    p.asset_price = 95.0;
+    p.strike_price = 100.0;
+    p.r = 0.05;
+    p.cost_of_carry = 0.02;
+    p.volatility = 0.25;
+    p.exercise_time = 0.75;
+
+    // same formulas as before the generalization: delta / gamma in asset_price
+    yo::OptionParams up = p; up.asset_price += 1e-4;
+    yo::OptionParams dn = p; dn.asset_price -= 1e-4;
+    ASSERT_EQ(num_bs.delta(p), (bs_engine.price(up) - bs_engine.price(dn)) / (2.0 * 1e-4));
+    ASSERT_EQ(num_bs.gamma(p), (bs_engine.price(up) - 2.0 * bs_engine.price(p) + bs_engine.price(dn)) / (1e-4 * 1e-4));
+
+    // delta and gamma from 3 shared evaluations
+    ye::DeltaGamma dg = num_bs.delta_and_gamma(p);
+    ASSERT_NEAR(dg.delta, num_bs.delta(p), 1e-12);
+    ASSERT_EQ(dg.gamma, num_bs.gamma(p));
+
+    // any field, any pricer (reference: forward-mode AD)
+    ye::Sensitivities s = ad_bs.sensitivities(p);
+    ASSERT_NEAR(num_bs.derivative(p, &yo::OptionParams::volatility), s.vega, 1e-6);
+    ASSERT_NEAR(num_bs.derivative(p, &yo::OptionParams::r), s.rho, 1e-6);
+    ASSERT_NEAR(num_bs.derivative(p, &yo::OptionParams::cost_of_carry), s.carry, 1e-6);
+    ASSERT_NEAR(-num_bs.derivative(p, &yo::OptionParams::exercise_time), s.theta, 1e-6);
+    ye::Sensitivities s_pa = ad_pa.sensitivities(p);
+    ASSERT_NEAR(num_pa.derivative(p, &yo::OptionParams::volatility), s_pa.vega, 1e-6);
+    ASSERT_NEAR(num_pa.delta(p), ad_pa.delta(p), 1e-6);
+
+    // cross derivative: vanna = d(delta)/d(sigma); d2V/dS2 through the cross formula = gamma
+    yo::OptionParams vol_up = p; vol_up.volatility += 1e-4;
+    yo::OptionParams vol_dn = p; vol_dn.volatility -= 1e-4;
+    double vanna = (ad_bs.delta(vol_up) - ad_bs.delta(vol_dn)) / (2.0 * 1e-4);
+    ASSERT_NEAR(num_bs.cross_derivative(p, &yo::OptionParams::asset_price, &yo::OptionParams::volatility), vanna, 1e-5);
+    ASSERT_NEAR(num_bs.cross_derivative(p, &yo::OptionParams::asset_price, &yo::OptionParams::asset_price, 1e-3, 1e-3),
+                ad_bs.gamma(p), 1e-5);
+
+    // batches (larger than one chunk): one pricer call per chunk, same values as the single config calls
+    yo::OptionParams base = p;
+    auto line = yu::sweep_1d(base, &yo::OptionParams::asset_price, 50.0, 150.0, 0.04);
+    ASSERT_TRUE(line.size() > ye::NumericalEngineGreeks::chunk_size);
+    std::vector<double> deltas = num_bs.delta(line);
+    std::vector<double> gammas = num_bs.gamma(line);
+    std::vector<double> vegas(line.size()), d_out(line.size()), g_out(line.size());
+    num_bs.derivative(line, &yo::OptionParams::volatility, vegas);
+    num_bs.delta_and_gamma(line, d_out, g_out);
+    for (std::size_t i = 0; i < line.size(); i += 97)
+    {
+        ASSERT_EQ(deltas[i], num_bs.delta(line[i]));
+        ASSERT_EQ(gammas[i], num_bs.gamma(line[i]));
+        ASSERT_EQ(vegas[i], num_bs.derivative(line[i], &yo::OptionParams::volatility));
+        ASSERT_EQ(g_out[i], gammas[i]);
+        ASSERT_NEAR(d_out[i], deltas[i], 1e-12);
+    }
+
+    // nested: a pricer whose batch calls a NumericalEngineGreeks batch (each call has its own buffers)
+    struct DeltaPricer : public ye::IPricer
+    {
+        const ye::NumericalEngineGreeks& greeks;
+        explicit DeltaPricer(const ye::NumericalEngineGreeks& g) : greeks(g) {}
+        using ye::IPricer::price;
+        double price(const yo::OptionParams& q) const override { return greeks.delta(q); }
+        void price(std::span<const yo::OptionParams> batch, std::span<double> out) const override { greeks.delta(batch, out); }
+    };
+    DeltaPricer delta_pricer{num_bs};
+    ye::NumericalEngineGreeks num_delta{delta_pricer, 1e-2};
+    std::vector<double> vannas(line.size());
+    num_delta.derivative(line, &yo::OptionParams::volatility, vannas);
+    for (std::size_t i = 0; i < line.size(); i += 97)
+    {
+        ASSERT_EQ(vannas[i], num_delta.derivative(line[i], &yo::OptionParams::volatility));
+    }
+
+    // warmed-up batch calls reuse the scratch buffers (no heap allocation)
+    std::size_t before = g_allocations;
+    num_bs.delta_and_gamma(line, d_out, g_out);
+    std::size_t after = g_allocations;
+    ASSERT_EQ(after - before, 0u);
+
+    // wrongly sized outputs are rejected
+    bool thrown = false;
+    try
+    {
+        std::vector<double> wrong(line.size() - 1);
+        num_bs.delta_and_gamma(line, d_out, wrong);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- ScenarioEngine Tests ---
+// Test Case 030: scenario P&L vs naive repricing, thread independence and quantiles
+TEST_CASE(ScenarioEngine_PnL_And_Quantiles)
+{
+    ye::BSEngine bs_engine;
+
+    // book of 50 positions
+    std::vector<yo::OptionParams> book;
+    std::vector<double> quantities;
+    for (int i = 0; i < 50; ++i)
+    {
+        yo::OptionParams p{};
+        p.asset_price = 100.0;
+        p.strike_price = 70.0 + 1.2 * i;
+        p.exercise_time = 0.1 + 0.05 * (i % 10);
+        p.volatility = 0.15 + 0.005 * i;
+        p.option_type = (i % 3 == 0) ? yo::OptionType::Put : yo::OptionType::Call;
+        book.push_back(p);
+        quantities.push_back((i % 4) - 1.0);
+    }
+
+    // 500 scenarios: spot -20%..+20%, vol -5..+5 pts, rates -1%..+1%
+    std::vector<ye::Scenario> scenarios;
+    for (int k = 0; k < 500; ++k)
+    {
+        scenarios.push_back(ye::Scenario{ -0.2 + 0.4 * (k % 25) / 24.0,
+                                          -0.05 + 0.1 * ((k / 25) % 5) / 4.0,
+                                          -0.01 + 0.02 * (k / 125) / 3.0 });
+    }
+
+    // naive reference: reprice every (position, scenario)
+    std::vector<double> expected(scenarios.size(), 0.0);
+    for (std::size_t s = 0; s < scenarios.size(); ++s)
+    {
+        for (std::size_t i = 0; i < book.size(); ++i)
+        {
+            yo::OptionParams shocked = ye::apply_scenario(book[i], scenarios[s]);
+            expected[s] += quantities[i] * (bs_engine.price(shocked) - bs_engine.price(book[i]));
+        }
+    }
+
+    // small tiles so that several tiles and threads are exercised
+    ye::ScenarioEngine single{bs_engine, 1, 16, 8};
+    ye::ScenarioEngine multi{bs_engine, 4, 16, 8};
+    std::vector<double> pnl_single = single.pnl(book, quantities, scenarios);
+    std::vector<double> pnl_multi = multi.pnl(book, quantities, scenarios);
+    ASSERT_EQ(pnl_single.size(), scenarios.size());
+    ASSERT_TRUE(pnl_single == pnl_multi); // same summation order whatever the number of threads
+    for (std::size_t s = 0; s < scenarios.size(); ++s) ASSERT_NEAR(pnl_single[s], expected[s], 1e-9);
+
+    // the zero scenario gives zero P&L; vol floor keeps the shocked params valid
+    ye::Scenario none{};
+    ASSERT_NEAR(single.pnl(book, quantities, std::span<const ye::Scenario>(&none, 1))[0], 0.0, 1e-12);
+    yo::OptionParams low_vol = book[0];
+    low_vol.volatility = 0.02;
+    ASSERT_EQ(ye::apply_scenario(low_vol, ye::Scenario{0.0, -0.05, 0.0}).volatility, ye::ScenarioEngine::min_volatility);
+
+    // any pricer: through the memoizing decorator (shared by the threads)
+    ye::CachedPricer cached{bs_engine, 1 << 16};
+    ye::ScenarioEngine cached_engine{cached, 4, 16, 8};
+    std::vector<double> pnl_cached = cached_engine.pnl(book, quantities, scenarios);
+    ASSERT_TRUE(pnl_cached == pnl_single);
+
+    // report: base value and quantiles
+    std::vector<double> levels{0.01, 0.5, 0.99};
+    ye::ScenarioReport report = multi.run(book, quantities, scenarios, levels);
+    double base_value = 0.0;
+    for (std::size_t i = 0; i < book.size(); ++i) base_value += quantities[i] * bs_engine.price(book[i]);
+    ASSERT_NEAR(report.base_value, base_value, 1e-9);
+    ASSERT_EQ(report.quantiles.size(), 3u);
+    ASSERT_TRUE(report.quantiles[0] <= report.quantiles[1] && report.quantiles[1] <= report.quantiles[2]);
+
+    // quantile(): linear interpolation between order statistics
+    ASSERT_NEAR(ye::quantile({4.0, 1.0, 3.0, 2.0}, 0.5), 2.5, 1e-15);
+    ASSERT_NEAR(ye::quantile({4.0, 1.0, 3.0, 2.0}, 0.0), 1.0, 1e-15);
+    ASSERT_NEAR(ye::quantile({4.0, 1.0, 3.0, 2.0}, 1.0), 4.0, 1e-15);
+    std::vector<double> sorted = pnl_single;
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_NEAR(report.quantiles[1], 0.5 * (sorted[249] + sorted[250]), 1e-12);
+
+    bool thrown = false;
+    try { ye::quantile({1.0}, 1.5); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- Portfolio Tests ---
+// Test Case 031: SoA portfolio, aggregated / bucketed Greeks, deterministic reduction
+TEST_CASE(Portfolio_Aggregated_Greeks)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    ye::PerpetualAmericanEngine pa_engine;
+    ye::ADEngineGreeks<ye::PerpetualAmericanEngine> pa_greeks{pa_engine};
+
+    // mixed book: European calls / puts and perpetual American options
+    yo::Portfolio book;
+    book.reserve(5000);
+    for (int i = 0; i < 5000; ++i)
+    {
+        yo::OptionParams p{};
+        p.asset_price = 100.0;
+        p.strike_price = 60.0 + (i % 81);
+        p.exercise_time = 0.05 + 0.01 * (i % 200);
+        p.volatility = 0.1 + 0.001 * (i % 300);
+        p.r = 0.05;
+        p.cost_of_carry = 0.02;
+        p.option_type = (i % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+        yo::OptionStyle style = (i % 7 == 0) ? yo::OptionStyle::PerpetualAmerican : yo::OptionStyle::European;
+        book.add(p, (i % 2) ? 3.0 : -2.0, style);
+    }
+    yo::EuropeanOption european{};
+    book.add(european, 10.0);
+    ASSERT_EQ(book.size(), 5001u);
+    ASSERT_TRUE(book.style(5000) == yo::OptionStyle::European);
+    ASSERT_EQ(book.params(5000).strike_price, european.strike_price());
+
+    // reference: position by position through the engines
+    double value = 0.0, delta = 0.0, gamma = 0.0, value_short_expiry = 0.0;
+    for (std::size_t i = 0; i < book.size(); ++i)
+    {
+        yo::OptionParams p = book.params(i);
+        double q = book.quantity(i);
+        double v, d, g;
+        if (book.style(i) == yo::OptionStyle::European)
+        {
+            v = bs_engine.price(p); d = bs_greeks.delta(p); g = bs_greeks.gamma(p);
+        }
+        else
+        {
+            v = pa_engine.price(p); d = pa_greeks.delta(p); g = pa_greeks.gamma(p);
+        }
+        value += q * v; delta += q * d; gamma += q * g;
+        if (p.exercise_time < 0.5) value_short_expiry += q * v;
+    }
+
+    std::vector<double> expiry_edges{0.5, 1.0, 1.5};
+    std::vector<double> strike_edges{80.0, 100.0, 120.0};
+    ye::PortfolioEngine single{1, 256};
+    ye::PortfolioEngine multi{4, 256};
+    ye::PortfolioRisk risk = single.aggregate(book, expiry_edges, strike_edges);
+    ye::PortfolioRisk risk_multi = multi.aggregate(book, expiry_edges, strike_edges);
+
+    ASSERT_NEAR(risk.total.value, value, 1e-8);
+    ASSERT_NEAR(risk.total.delta, delta, 1e-9);
+    ASSERT_NEAR(risk.total.gamma, gamma, 1e-9);
+    ASSERT_NEAR(risk.by_expiry[0].value, value_short_expiry, 1e-8);
+
+    // same bits whatever the number of threads
+    ASSERT_EQ(risk_multi.total.value, risk.total.value);
+    ASSERT_EQ(risk_multi.total.delta, risk.total.delta);
+    ASSERT_EQ(risk_multi.total.gamma, risk.total.gamma);
+    ASSERT_EQ(risk_multi.by_strike[2].gamma, risk.by_strike[2].gamma);
+
+    // buckets partition the book
+    ASSERT_EQ(risk.by_expiry.size(), 4u);
+    ASSERT_EQ(risk.by_strike.size(), 4u);
+    double sum_expiry = 0.0, sum_strike = 0.0;
+    for (const auto& b : risk.by_expiry) sum_expiry += b.delta;
+    for (const auto& b : risk.by_strike) sum_strike += b.delta;
+    ASSERT_NEAR(sum_expiry, risk.total.delta, 1e-9);
+    ASSERT_NEAR(sum_strike, risk.total.delta, 1e-9);
+    ASSERT_EQ(ye::PortfolioEngine::bucket_of(strike_edges, 79.9), 0u);
+    ASSERT_EQ(ye::PortfolioEngine::bucket_of(strike_edges, 80.0), 1u);
+    ASSERT_EQ(ye::PortfolioEngine::bucket_of(strike_edges, 150.0), 3u);
+
+    // no edges: a single bucket
+    ye::PortfolioRisk unbucketed = single.aggregate(book);
+    ASSERT_EQ(unbucketed.by_expiry.size(), 1u);
+    ASSERT_EQ(unbucketed.total.value, risk.total.value);
+
+    // compensated summation keeps the small terms next to large offsetting ones
+    std::vector<double> terms{1e16, 1.0, -1e16, 1.0};
+    ASSERT_EQ(yu::compensated_sum(terms), 2.0);
+
+    // invalid edges are rejected
+    bool thrown = false;
+    try
+    {
+        std::vector<double> bad{1.0, 0.5};
+        single.aggregate(book, bad);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- Curves Tests ---
+// Test Case 032: log-linear discount curves and the curve-based Black-Scholes engine
+TEST_CASE(CurveBSEngine_Term_Structure)
+{
+    ye::BSEngine bs_engine;
+
+    // log-linear interpolation: exact at the pillars, geometric mean at mid-segment
+    yu::DiscountCurve curve({0.5, 1.0, 2.0}, {0.99, 0.975, 0.94});
+    ASSERT_NEAR(curve.discount(1.0), 0.975, 1e-15);
+    ASSERT_NEAR(curve.discount(1.5), std::sqrt(0.975 * 0.94), 1e-15);
+    ASSERT_NEAR(curve.discount(0.25), std::sqrt(0.99), 1e-15);       // from D(0) = 1
+    ASSERT_NEAR(curve.discount(0.0), 1.0, 1e-15);
+    double last_forward = std::log(0.975 / 0.94);                     // flat forward after 2y
+    ASSERT_NEAR(curve.discount(3.0), 0.94 * std::exp(-last_forward), 1e-15);
+    ASSERT_NEAR(yu::DiscountCurve::flat(0.05).zero_rate(7.3), 0.05, 1e-15);
+
+    // flat curves reproduce BSEngine (r, b)
+    yo::OptionParams p{};
+    p.asset_price = 100.0;
+    p.strike_price = 95.0;
+    p.r = 0.04;
+    p.cost_of_carry = 0.01;
+    p.volatility = 0.3;
+    p.exercise_time = 0.8;
+    ye::CurveBSEngine flat_engine{yu::DiscountCurve::flat(p.r), yu::DiscountCurve::flat(p.r - p.cost_of_carry)};
+    ASSERT_NEAR(flat_engine.price(p), bs_engine.price(p), 1e-12);
+    p.option_type = yo::OptionType::Put;
+    ASSERT_NEAR(flat_engine.price(p), bs_engine.price(p), 1e-12);
+
+    // term structures: same as BSEngine with the zero rates of the maturity
+    yu::DiscountCurve rates = yu::DiscountCurve::from_zero_rates({0.25, 1.0, 3.0}, {0.03, 0.035, 0.04});
+    yu::DiscountCurve dividends = yu::DiscountCurve::from_zero_rates({0.5, 2.0}, {0.01, 0.02});
+    std::vector<double> maturities{0.25, 0.5, 1.0, 2.0};
+    ye::CurveBSEngine engine{rates, dividends, maturities};
+    ASSERT_EQ(engine.cached_maturities(), 4u);
+
+    // chain: 4 maturities x 50 strikes (grouped by maturity) + an unlisted maturity
+    std::vector<yo::OptionParams> chain;
+    for (double T : maturities)
+    {
+        for (int k = 0; k < 50; ++k)
+        {
+            yo::OptionParams q = p;
+            q.exercise_time = T;
+            q.strike_price = 75.0 + k;
+            q.option_type = (k % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+            chain.push_back(q);
+        }
+    }
+    yo::OptionParams unlisted = p;
+    unlisted.exercise_time = 1.7;
+    chain.push_back(unlisted);
+
+    std::vector<double> prices = engine.price(chain);
+    for (std::size_t i = 0; i < chain.size(); ++i)
+    {
+        ASSERT_EQ(prices[i], engine.price(chain[i]));
+        ASSERT_NEAR(prices[i], bs_engine.price(engine.flat_params(chain[i])), 1e-10);
+    }
+
+    // invalid curves are rejected
+    bool thrown = false;
+    try { yu::DiscountCurve bad({1.0, 0.5}, {0.99, 0.98}); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- ChainPricer Tests ---
+// Test Case 033: chain pricer (grouped by S, T, r, b) vs BSEngine, shuffled input, column API
+TEST_CASE(ChainPricer_vs_BSEngine)
+{
+    ye::BSEngine bs_engine;
+    ye::ChainPricer chain_pricer;
+
+    // 2 underlyings x 5 maturities x 80 strikes, with a smile
+    std::vector<yo::OptionParams> chain;
+    for (double S : {100.0, 50.0})
+    {
+        for (int m = 1; m <= 5; ++m)
+        {
+            for (int k = 0; k < 80; ++k)
+            {
+                yo::OptionParams p{};
+                p.asset_price = S;
+                p.exercise_time = 0.2 * m;
+                p.r = 0.03;
+                p.cost_of_carry = 0.01;
+                p.strike_price = S * (0.6 + 0.01 * k);
+                double moneyness = std::log(p.strike_price / S);
+                p.volatility = 0.2 + 0.3 * moneyness * moneyness;
+                p.option_type = (k % 2) ? yo::OptionType::Put : yo::OptionType::Call;
+                chain.push_back(p);
+            }
+        }
+    }
+
+    std::vector<double> expected = bs_engine.price(chain);
+    std::vector<double> prices = chain_pricer.price(chain);
+    for (std::size_t i = 0; i < chain.size(); ++i) ASSERT_NEAR(prices[i], expected[i], 1e-10);
+    ASSERT_NEAR(chain_pricer.price(chain[17]), expected[17], 1e-10);
+
+    // shuffled input: the groups are rebuilt and the outputs land at the right index
+    std::vector<std::size_t> perm(chain.size());
+    for (std::size_t i = 0; i < perm.size(); ++i) perm[i] = (i * 337) % perm.size();
+    std::vector<yo::OptionParams> shuffled(chain.size());
+    for (std::size_t i = 0; i < perm.size(); ++i) shuffled[i] = chain[perm[i]];
+    std::vector<double> shuffled_prices = chain_pricer.price(shuffled);
+    for (std::size_t i = 0; i < perm.size(); ++i) ASSERT_EQ(shuffled_prices[i], prices[perm[i]]);
+
+    // NaN keys in the shuffled input: the sort stays a strict weak order, the bad rows
+    // give NaN and every other row its price
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (std::size_t i = 0; i < shuffled.size(); i += 37)
+    {
+        ((i / 37) % 2 ? shuffled[i].exercise_time : shuffled[i].asset_price) = nan;
+    }
+    shuffled_prices = chain_pricer.price(shuffled);
+    for (std::size_t i = 0; i < perm.size(); ++i)
+    {
+        if (i % 37 == 0) ASSERT_TRUE(std::isnan(shuffled_prices[i]));
+        else ASSERT_EQ(shuffled_prices[i], prices[perm[i]]);
+    }
+
+    // column API for one group
+    std::vector<double> strikes, vols, out(80);
+    std::vector<yo::OptionType> types;
+    for (std::size_t k = 0; k < 80; ++k)
+    {
+        strikes.push_back(chain[k].strike_price);
+        vols.push_back(chain[k].volatility);
+        types.push_back(chain[k].option_type);
+    }
+    ye::ChainPricer::price_chain(chain[0], strikes, vols, types, out);
+    for (std::size_t k = 0; k < 80; ++k) ASSERT_EQ(out[k], prices[k]);
+
+    bool thrown = false;
+    try
+    {
+        std::vector<double> short_out(79);
+        ye::ChainPricer::price_chain(chain[0], strikes, vols, types, short_out);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- Batch Parity Scanner Tests ---
+// Test Case 034: hash-joined parity scan with cost of carry, violations sorted by magnitude
+TEST_CASE(Parity_Scanner_Batch)
+{
+    ye::BSEngine bs_engine;
+
+    // chain with b != r (dividend yield): model prices satisfy the carry-aware parity
+    std::vector<yo::OptionParams> quotes;
+    for (int m = 1; m <= 4; ++m)
+    {
+        for (int k = 0; k < 30; ++k)
+        {
+            yo::OptionParams p{};
+            p.asset_price = 100.0;
+            p.r = 0.05;
+            p.cost_of_carry = 0.02;
+            p.volatility = 0.25;
+            p.exercise_time = 0.25 * m;
+            p.strike_price = 80.0 + k;
+            quotes.push_back(p);
+            p.option_type = yo::OptionType::Put;
+            quotes.push_back(p);
+        }
+    }
+    // interleave a few unmatched quotes (no put at this strike)
+    yo::OptionParams lonely{};
+    lonely.strike_price = 200.0;
+    quotes.insert(quotes.begin() + 7, lonely);
+
+    std::vector<double> prices = bs_engine.price(quotes);
+    ASSERT_EQ(yu::scan_parity(quotes, prices, 1e-10).violations.size(), 0u);
+
+    // the single-pair check agrees (it honours cost_of_carry as well)
+    ASSERT_TRUE(yu::check_parity(prices[0], prices[1], quotes[0], 1e-10));
+
+    // break three pairs by different amounts (indices >= 8 are shifted by the unmatched quote)
+    prices[11] += 0.5;  // call
+    prices[42] -= 2.0;  // put
+    prices[100] += 0.01;
+    std::vector<yu::ParityViolation> violations = yu::scan_parity(quotes, prices, 1e-6).violations;
+    ASSERT_EQ(violations.size(), 3u);
+    ASSERT_EQ(violations[0].put_index, 42u);
+    ASSERT_NEAR(violations[0].residual, 2.0, 1e-10);
+    ASSERT_EQ(violations[1].call_index, 11u);
+    ASSERT_NEAR(violations[1].residual, 0.5, 1e-10);
+    ASSERT_NEAR(std::fabs(violations[2].residual), 0.01, 1e-10);
+    ASSERT_TRUE(quotes[violations[1].call_index].option_type == yo::OptionType::Call);
+    ASSERT_TRUE(quotes[violations[1].put_index].option_type == yo::OptionType::Put);
+
+    // a newer quote for the same market and type replaces the older one, which is reported
+    quotes.push_back(quotes[42]);
+    prices.push_back(prices[42] + 2.0);
+    yu::ParityScan scan = yu::scan_parity(quotes, prices, 1e-6);
+    ASSERT_EQ(scan.violations.size(), 2u);
+    ASSERT_EQ(scan.duplicates.size(), 1u);
+    ASSERT_EQ(scan.duplicates[0], 42u);
+
+    // two underlyings sharing a (K, T) are not paired with each other: the legs of each
+    // pair share S, r and b, and model prices of both chains satisfy the parity
+    std::vector<yo::OptionParams> two_chains;
+    for (double S : { 100.0, 120.0 })
+    {
+        yo::OptionParams p{};
+        p.asset_price = S;
+        p.strike_price = 110.0;
+        p.exercise_time = 0.5;
+        p.r = 0.05;
+        p.cost_of_carry = S > 110.0 ? 0.01 : 0.05;
+        p.volatility = 0.3;
+        two_chains.push_back(p);
+        p.option_type = yo::OptionType::Put;
+        two_chains.push_back(p);
+    }
+    std::swap(two_chains[1], two_chains[3]); // puts in the other order
+    std::vector<double> two_prices = bs_engine.price(two_chains);
+    scan = yu::scan_parity(two_chains, two_prices, 1e-10);
+    ASSERT_EQ(scan.violations.size(), 0u);
+    ASSERT_EQ(scan.duplicates.size(), 0u);
+    two_prices[3] += 0.25; // put of the S = 100 chain
+    scan = yu::scan_parity(two_chains, two_prices, 1e-6);
+    ASSERT_EQ(scan.violations.size(), 1u);
+    ASSERT_EQ(scan.violations[0].call_index, 0u);
+    ASSERT_EQ(scan.violations[0].put_index, 3u);
+    ASSERT_NEAR(scan.violations[0].residual, -0.25, 1e-10);
+
+    bool thrown = false;
+    try { yu::scan_parity(quotes, std::span<const double>(prices).first(3)); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// --- ParityPricer Tests ---
+// Pricer counting the options it is asked to price (through the batch overload)
+struct CountingPricer : public ye::IPricer
+{
+    const ye::IPricer& inner;
+    mutable std::size_t n_priced = 0;
+    explicit CountingPricer(const ye::IPricer& p) : inner(p) {}
+    using ye::IPricer::price;
+    double price(const yo::OptionParams& p) const override { ++n_priced; return inner.price(p); }
+    void price(std::span<const yo::OptionParams> batch, std::span<double> out) const override
+    {
+        n_priced += batch.size();
+        inner.price(batch, out);
+    }
+};
+
+// Test Case 035: one leg per call/put pair priced, the other from the carry-aware parity
+TEST_CASE(ParityPricer_Derives_Other_Leg)
+{
+    ye::BSEngine bs_engine;
+    CountingPricer counting{bs_engine};
+    ye::ParityPricer parity_pricer{counting};
+
+    // carry-aware parity helpers (b != r)
+    yo::OptionParams q{};
+    q.cost_of_carry = 0.02;
+    double C = bs_engine.price(q);
+    yo::OptionParams q_put = q;
+    q_put.option_type = yo::OptionType::Put;
+    double P = bs_engine.price(q_put);
+    ASSERT_NEAR(yu::put_from_call(C, q), P, 1e-12);
+    ASSERT_NEAR(yu::call_from_put(P, q_put), C, 1e-12);
+    ASSERT_TRUE(yu::check_parity(C, P, q, 1e-12));
+
+    // mixed book: 300 call/put pairs (shuffled), 20 unpaired calls, a duplicated put
+    std::vector<yo::OptionParams> book;
+    for (int k = 0; k < 300; ++k)
+    {
+        yo::OptionParams p{};
+        p.asset_price = 100.0;
+        p.strike_price = 40.0 + 0.4 * k;
+        p.r = 0.05;
+        p.cost_of_carry = 0.01;
+        p.volatility = 0.2 + 0.001 * k;
+        p.exercise_time = 0.1 + 0.01 * (k % 50);
+        book.push_back(p);
+        p.option_type = yo::OptionType::Put;
+        book.push_back(p);
+    }
+    for (int k = 0; k < 20; ++k)
+    {
+        yo::OptionParams p{};
+        p.strike_price = 50.0 + k;
+        book.push_back(p);
+    }
+    book.push_back(book[1]);
+    for (std::size_t i = 0; i < book.size(); ++i) std::swap(book[i], book[(i * 7919) % book.size()]);
+
+    std::vector<double> expected = bs_engine.price(book);
+    std::vector<double> prices = parity_pricer.price(book);
+    for (std::size_t i = 0; i < book.size(); ++i) ASSERT_NEAR(prices[i], expected[i], 1e-10);
+
+    // half of the pairs' legs (+ the unpaired options) went through the engine
+    ASSERT_EQ(counting.n_priced, 300u + 20u + 1u);
+
+    // chain order (legs next to each other, no hash join), through a nested decorator
+    // (the inner call must not clobber the buffers of the outer one)
+    std::vector<yo::OptionParams> chain;
+    for (int k = 0; k < 50; ++k)
+    {
+        yo::OptionParams p{};
+        p.strike_price = 80.0 + k;
+        p.exercise_time = 0.25 * (1 + k / 10);
+        p.cost_of_carry = 0.02;
+        chain.push_back(p);
+        p.option_type = yo::OptionType::Put;
+        chain.push_back(p);
+    }
+    chain.push_back(chain[40]); // unpaired OTM call, and a put left over in the middle
+    chain.insert(chain.begin() + 31, chain[31]);
+    counting.n_priced = 0;
+    ye::ParityPricer nested{parity_pricer};
+    expected = bs_engine.price(chain);
+    prices = nested.price(chain);
+    for (std::size_t i = 0; i < chain.size(); ++i) ASSERT_NEAR(prices[i], expected[i], 1e-10);
+    ASSERT_EQ(counting.n_priced, 50u + 2u);
+
+    // single config: straight to the engine
+    ASSERT_EQ(parity_pricer.price(book[3]), bs_engine.price(book[3]));
+
+    return true;
+}
+
+// --- TableEngine Tests ---
+// Test Case 036: interpolated lookups within the error bounds, exact fallback, rebuild + swap
+TEST_CASE(TableEngine_Interpolated_Lookup)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+
+    ye::TableSpec spec;
+    spec.base.strike_price = 100.0;
+    spec.base.exercise_time = 0.5;
+    spec.field_x = &yo::OptionParams::asset_price;
+    spec.start_x = 70.0; spec.end_x = 130.0; spec.step_x = 1.0;
+    spec.field_y = &yo::OptionParams::volatility;
+    spec.start_y = 0.1; spec.end_y = 0.4; spec.step_y = 0.01;
+    ye::TableEngine table{bs_engine, bs_greeks, spec};
+
+    ye::TableErrorBounds e = table.error_bounds();
+    ASSERT_TRUE(e.price > 0.0 && e.price < 2e-4);
+    ASSERT_TRUE(e.delta < 1e-4);
+    ASSERT_TRUE(e.gamma < 1e-4);
+
+    // off-node queries: within the error bounds
+    for (int k = 0; k < 200; ++k)
+    {
+        yo::OptionParams p = spec.base;
+        p.asset_price = 70.0 + 0.2983 * k;
+        p.volatility = 0.1 + 0.0014 * k;
+        ASSERT_TRUE(table.covers(p));
+        ASSERT_NEAR(table.price(p), bs_engine.price(p), e.price);
+        ye::TableQuote q = table.quote(p);
+        ASSERT_EQ(q.price, table.price(p));
+        ASSERT_NEAR(q.delta, bs_greeks.delta(p), e.delta);
+        ASSERT_NEAR(q.gamma, bs_greeks.gamma(p), e.gamma);
+    }
+
+    // on the nodes the table is exact (up to rounding)
+    yo::OptionParams node = spec.base;
+    node.asset_price = 100.0;
+    node.volatility = 0.2;
+    ASSERT_NEAR(table.price(node), bs_engine.price(node), 1e-12);
+
+    // outside the table: exact engines
+    yo::OptionParams other_strike = node;
+    other_strike.strike_price = 95.0;
+    yo::OptionParams outside = node;
+    outside.asset_price = 150.0;
+    yo::OptionParams put = node;
+    put.option_type = yo::OptionType::Put;
+    for (const yo::OptionParams& p : { other_strike, outside, put })
+    {
+        ASSERT_TRUE(!table.covers(p));
+        ASSERT_EQ(table.price(p), bs_engine.price(p));
+        ASSERT_EQ(table.delta(p), bs_greeks.delta(p));
+    }
+
+    // batch: same as the single lookups
+    std::vector<yo::OptionParams> batch = { node, other_strike, outside, put };
+    std::vector<double> prices = table.price(batch);
+    for (std::size_t i = 0; i < batch.size(); ++i) ASSERT_EQ(prices[i], table.price(batch[i]));
+
+    // rebuild in the background (the old table answers meanwhile), then swap
+    ye::TableSpec spec_95 = spec;
+    spec_95.base.strike_price = 95.0;
+    std::future<void> done = table.rebuild_async(spec_95);
+    ASSERT_NEAR(table.price(node), bs_engine.price(node), e.price);
+    done.get();
+    ASSERT_TRUE(table.covers(other_strike));
+    ASSERT_TRUE(!table.covers(node));
+    ASSERT_EQ(table.spec().base.strike_price, 95.0);
+    ASSERT_NEAR(table.price(other_strike), bs_engine.price(other_strike), 1e-12);
+
+    // a failed rebuild keeps the current table
+    ye::TableSpec too_coarse = spec;
+    too_coarse.step_x = 10.0;
+    too_coarse.tolerance = 1e-8;
+    bool thrown = false;
+    try { table.rebuild_async(too_coarse).get(); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    ASSERT_TRUE(table.covers(other_strike));
+
+    ye::TableSpec too_small = spec;
+    too_small.end_x = 73.0; // 4 nodes
+    thrown = false;
+    try { ye::TableEngine bad{bs_engine, bs_greeks, too_small}; }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    // a rebuild can outlive the engine: the destructor waits for it
+    std::future<void> pending;
+    {
+        ye::TableEngine scoped{bs_engine, bs_greeks, spec};
+        pending = scoped.rebuild_async(spec_95);
+    }
+    ASSERT_TRUE(pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    pending.get();
+
+    return true;
+}
+
+// --- Surface Export Tests ---
+// read_file(): whole file as a string
+std::string read_file(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// Test Case 037: buffered to_chars CSV export matches the iostream formatting, for any thread count
+TEST_CASE(SurfaceCsv_Matches_Iostream_Format)
+{
+    yo::OptionParams base{};
+    yu::Grid2D<yo::OptionParams> grid = yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 50.0, 150.0, 0.5,
+        &yo::OptionParams::exercise_time, 0.1, 1.1, 0.01); // 201 x 101 nodes: several chunks
+    ye::BSEngine bs_engine;
+    yu::Grid2D<double> prices = bs_engine.price(grid);
+    prices(0, 0) = -1e-9; // rounds to "-0.0000" with iostreams too
+    prices(0, 1) = 12345678.123456;
+
+    // reference: the previous per-cell iostream writer
+    std::ostringstream expected;
+    expected << "asset_price,exercise_time,price\n";
+    for (std::size_t i = 0; i < grid.nrows; ++i)
+    {
+        for (std::size_t j = 0; j < grid.ncols; ++j)
+        {
+            expected << std::fixed << std::setprecision(4)
+                     << grid(i, j).asset_price << ","
+                     << grid(i, j).exercise_time << ","
+                     << prices(i, j) << "\n";
+        }
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "yvan_surface_test.csv").string();
+    const yu::SurfaceCsv format{ "asset_price", "exercise_time", "price", 4 };
+    for (std::size_t n_threads : { 1u, 3u })
+    {
+        yu::write_surface_csv(path, grid, &yo::OptionParams::asset_price, &yo::OptionParams::exercise_time,
+                              prices, format, n_threads);
+        ASSERT_TRUE(read_file(path) == expected.str());
+    }
+
+    // CsvWriter on its own (rows larger than the buffer are written through)
+    {
+        yu::CsvWriter writer(path, 16);
+        writer.write("a,b\n");
+        const double row[2] = { 1.5, -2.25 };
+        for (int k = 0; k < 1000; ++k) writer.write_row(row, 2);
+        writer.close();
+    }
+    std::string text = read_file(path);
+    ASSERT_EQ(text.size(), 4u + 1000u * 11u);
+    ASSERT_TRUE(text.compare(0, 15, "a,b\n1.50,-2.25\n") == 0);
+    std::filesystem::remove(path);
+
+    // bad inputs
+    bool thrown = false;
+    yu::Grid2D<double> wrong(3, 3);
+    try { yu::write_surface_csv(path, grid, &yo::OptionParams::asset_price, &yo::OptionParams::exercise_time, wrong, format); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    thrown = false;
+    try { yu::CsvWriter writer((std::filesystem::temp_directory_path() / "no_such_dir" / "x.csv").string()); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    return true;
+}
+
+// Test Case 038: binary surface export (aligned arrays at the header offsets) and read back
+TEST_CASE(SurfaceBinary_Round_Trip)
+{
+    yo::OptionParams base{};
+    yu::Grid2D<yo::OptionParams> grid = yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 50.0, 150.0, 2.5,
+        &yo::OptionParams::exercise_time, 0.1, 1.1, 0.1); // 41 x 11 nodes
+    ye::BSEngine bs_engine;
+    yu::Grid2D<double> prices = bs_engine.price(grid);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "yvan_surface_test.bin").string();
+    yu::write_surface_binary(path, grid, &yo::OptionParams::asset_price, &yo::OptionParams::exercise_time,
+                             prices, yu::SurfaceNames{ "asset_price", "exercise_time", "price" });
+
+    // raw layout: header, then 64-byte aligned arrays
+    std::string bytes = read_file(path);
+    yu::SurfaceHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    ASSERT_TRUE(std::string(header.magic) == "YSURF");
+    ASSERT_EQ(header.nrows, 41u);
+    ASSERT_EQ(header.ncols, 11u);
+    ASSERT_EQ(header.x_offset % yu::surface_alignment, 0u);
+    ASSERT_EQ(header.y_offset % yu::surface_alignment, 0u);
+    ASSERT_EQ(header.data_offset % yu::surface_alignment, 0u);
+    ASSERT_EQ(bytes.size(), header.data_offset + 41u * 11u * sizeof(double));
+    double v{};
+    std::memcpy(&v, bytes.data() + header.data_offset + (3 * 11 + 7) * sizeof(double), sizeof(double));
+    ASSERT_EQ(v, prices(3, 7));
+
+    // read back
+    yu::SurfaceFile surface = yu::read_surface_binary(path);
+    ASSERT_TRUE(surface.names.x == "asset_price" && surface.names.y == "exercise_time" && surface.names.value == "price");
+    ASSERT_EQ(surface.x.size(), 41u);
+    ASSERT_EQ(surface.y.size(), 11u);
+    for (std::size_t i = 0; i < grid.nrows; ++i) ASSERT_EQ(surface.x[i], grid(i, 0).asset_price);
+    for (std::size_t j = 0; j < grid.ncols; ++j) ASSERT_EQ(surface.y[j], grid(0, j).exercise_time);
+    ASSERT_TRUE(surface.values.data == prices.data);
+
+    // bad inputs: not a surface, truncated file, name too long
+    bool thrown = false;
+    { std::ofstream out(path, std::ios::binary); out << "asset_price,exercise_time,price\n"; }
+    try { yu::read_surface_binary(path); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    thrown = false;
+    { std::ofstream out(path, std::ios::binary); out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8)); }
+    try { yu::read_surface_binary(path); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    thrown = false;
+    {
+        // an offset that wraps offset + nrows * 8 around 2^64
+        yu::SurfaceHeader bad = header;
+        bad.x_offset = ~std::uint64_t{ 0 } - 8;
+        std::string bad_bytes = bytes;
+        std::memcpy(bad_bytes.data(), &bad, sizeof(bad));
+        std::ofstream out(path, std::ios::binary);
+        out.write(bad_bytes.data(), static_cast<std::streamsize>(bad_bytes.size()));
+    }
+    try { yu::read_surface_binary(path); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    thrown = false;
+    try
+    {
+        yu::write_surface_binary(path, grid, &yo::OptionParams::asset_price, &yo::OptionParams::exercise_time,
+                                 prices, yu::SurfaceNames{ "asset_price", "exercise_time", "a_name_longer_than_23_chars" });
+    }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    std::filesystem::remove(path);
+
+    return true;
+}
+
+// --- Streaming Surface Tests ---
+// Sink failing on a given row
+struct FailingSink : public yu::SurfaceSink
+{
+    std::size_t fail_at;
+    explicit FailingSink(std::size_t row) : fail_at(row) {}
+    void begin(std::span<const double>, std::span<const double>) override {}
+    void write_row(std::size_t i, std::span<const double>) override
+    {
+        if (i == fail_at) throw std::runtime_error("sink failure");
+    }
+    void end() override {}
+};
+
+// Test Case 039: streamed surfaces are the files of the full-grid exporters, with bounded batches
+TEST_CASE(StreamSurface_Matches_Full_Grid_Export)
+{
+    yo::OptionParams base{};
+    base.strike_price = 110.0;
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+
+    // reference: full grid, then the exporters
+    yu::Grid2D<yo::OptionParams> grid = yu::sweep_2d(base,
+        &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+        &yo::OptionParams::exercise_time, 0.1, 1.1, 0.05);
+    yu::Grid2D<double> deltas = bs_greeks.delta(grid);
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    const yu::SurfaceCsv csv_format{ "asset_price", "exercise_time", "delta", 4 };
+    const yu::SurfaceNames names{ "asset_price", "exercise_time", "delta" };
+    yu::write_surface_csv(dir + "/yvan_full.csv", grid, &yo::OptionParams::asset_price,
+                          &yo::OptionParams::exercise_time, deltas, csv_format);
+    yu::write_surface_binary(dir + "/yvan_full.bin", grid, &yo::OptionParams::asset_price,
+                             &yo::OptionParams::exercise_time, deltas, names);
+
+    // streamed: 4 rows per batch (the last batch is partial), queue of 1
+    ASSERT_TRUE(grid.nrows % 4 != 0);
+    std::size_t max_batch = 0, n_values = 0;
+    auto evaluate = [&](std::span<const yo::OptionParams> batch, std::span<double> out)
+    {
+        max_batch = std::max(max_batch, batch.size());
+        n_values += batch.size();
+        bs_greeks.delta(batch, out);
+    };
+    {
+        yu::CsvSurfaceSink csv(dir + "/yvan_stream.csv", csv_format);
+        yu::BinarySurfaceSink bin(dir + "/yvan_stream.bin", names);
+        yu::stream_surface(base, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                           &yo::OptionParams::exercise_time, 0.1, 1.1, 0.05,
+                           evaluate, { &csv, &bin }, yu::SurfaceStreamOptions{ 4, 1 });
+    }
+    ASSERT_EQ(max_batch, 4 * grid.ncols);
+    ASSERT_EQ(n_values, grid.data.size());
+    ASSERT_TRUE(read_file(dir + "/yvan_stream.csv") == read_file(dir + "/yvan_full.csv"));
+    ASSERT_TRUE(read_file(dir + "/yvan_stream.bin") == read_file(dir + "/yvan_full.bin"));
+
+    // any IPricer, default batching
+    {
+        yu::BinarySurfaceSink bin(dir + "/yvan_stream.bin", names);
+        yu::stream_surface(base, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                           &yo::OptionParams::exercise_time, 0.1, 1.1, 0.05,
+                           [&](auto batch, auto out) { bs_engine.price(batch, out); }, { &bin });
+    }
+    yu::SurfaceFile prices = yu::read_surface_binary(dir + "/yvan_stream.bin");
+    ASSERT_TRUE(prices.values.data == bs_engine.price(grid).data);
+
+    // failures of the sink (writer thread) or of the evaluator (calling thread) are rethrown
+    bool thrown = false;
+    try
+    {
+        FailingSink failing{ 50 };
+        yu::stream_surface(base, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                           &yo::OptionParams::exercise_time, 0.1, 1.1, 0.05,
+                           evaluate, { &failing }, yu::SurfaceStreamOptions{ 1, 1 });
+    }
+    catch (const std::runtime_error&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    thrown = false;
+    try
+    {
+        FailingSink never{ 1000 };
+        yu::stream_surface(base, &yo::OptionParams::asset_price, 50.0, 150.0, 1.0,
+                           &yo::OptionParams::exercise_time, 0.1, 1.1, 0.05,
+                           [](auto, auto) { throw std::invalid_argument("evaluator failure"); }, { &never });
+    }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    // the file sinks reject rows out of order, of the wrong size or past the last one,
+    // and missing rows at the end
+    {
+        const std::vector<double> x{ 1.0, 2.0 }, y{ 0.1, 0.2, 0.3 }, row{ 4.0, 5.0, 6.0 };
+        yu::CsvSurfaceSink csv(dir + "/yvan_stream.csv", csv_format);
+        yu::BinarySurfaceSink bin(dir + "/yvan_stream.bin", names);
+        for (yu::SurfaceSink* sink : std::initializer_list<yu::SurfaceSink*>{ &csv, &bin })
+        {
+            auto rejects = [&](auto&& call) -> bool
+            {
+                try { call(); }
+                catch (const std::invalid_argument&) { return true; }
+                return false;
+            };
+            sink->begin(x, y);
+            ASSERT_TRUE(rejects([&] { sink->write_row(1, row); }));
+            ASSERT_TRUE(rejects([&] { sink->write_row(0, std::span<const double>(row).first(2)); }));
+            sink->write_row(0, row);
+            thrown = false;
+            try { sink->end(); }
+            catch (const std::runtime_error&) { thrown = true; }
+            ASSERT_TRUE(thrown);
+            sink->write_row(1, row);
+            ASSERT_TRUE(rejects([&] { sink->write_row(2, row); }));
+            sink->end();
+        }
+    }
+
+    for (const char* file : { "/yvan_full.csv", "/yvan_full.bin", "/yvan_stream.csv", "/yvan_stream.bin" })
+    {
+        std::filesystem::remove(dir + file);
+    }
+    return true;
+}
+
+// Test Case 040: dynamic scheduling runs every item exactly once and rethrows failures
+TEST_CASE(ParallelForDynamic_Runs_Each_Item_Once)
+{
+    // items of very uneven cost, more threads than items in the last check
+    for (std::size_t n_threads : { 1, 3, 8 })
+    {
+        std::vector<std::atomic<int>> runs(37);
+        std::atomic<std::size_t> total{ 0 };
+        yu::parallel_for_dynamic(runs.size(), n_threads, [&](std::size_t i)
+        {
+            if (i % 7 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            runs[i].fetch_add(1);
+            total.fetch_add(i);
+        });
+        for (const auto& r : runs) ASSERT_EQ(r.load(), 1);
+        ASSERT_EQ(total.load(), std::size_t{ 37 * 36 / 2 });
+    }
+    std::atomic<int> calls{ 0 };
+    yu::parallel_for_dynamic(2, 8, [&](std::size_t) { calls.fetch_add(1); });
+    yu::parallel_for_dynamic(0, 8, [&](std::size_t) { calls.fetch_add(1); });
+    ASSERT_EQ(calls.load(), 2);
+
+    // an exception of one item is rethrown once all workers have stopped
+    bool thrown = false;
+    try
+    {
+        yu::parallel_for_dynamic(100, 4, [](std::size_t i)
+        {
+            if (i == 10) throw std::invalid_argument("item failure");
+        });
+    }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    return true;
+}
+
+// Test Case 041: bulk loading of books, bad rows reported instead of thrown
+TEST_CASE(ParamsLoader_Reports_Bad_Rows)
+{
+    // columns in another order, an ignored column, Windows line ends, a blank line
+    const std::string text =
+        "id;vol;option_type;spot;strike;rate;carry;maturity;qty\r\n"
+        "a;0.25;call;100;105;0.05;0.05;0.5;10\r\n"
+        "b;0.30;P;90;100;0.04;0.02;1.0;-5\r\n"
+        "c;abc;call;100;105;0.05;0.05;0.5;1\r\n"       // bad number
+        "\r\n"
+        "d;0.25;call;-1;105;0.05;0.05;0.5;1\r\n"       // negative spot (Option::validate_params)
+        "e;0.25;straddle;100;105;0.05;0.05;0.5;1\r\n"  // bad type
+        "f;0.25;put;100;105;0.05;0.05\r\n"             // missing fields
+        "g;0.20;put;80;75;0.03;0.03;2.0;3";            // no final line end
+    yu::ParamsCsv format;
+    format.volatility = "vol"; format.asset_price = "spot"; format.strike_price = "strike";
+    format.r = "rate"; format.cost_of_carry = "carry"; format.exercise_time = "maturity";
+    format.quantity = "qty"; format.separator = ';';
+
+    yu::ParamsLoad load = yu::parse_params_csv(text, format);
+    ASSERT_EQ(load.params.size(), std::size_t{ 3 });
+    ASSERT_TRUE(load.rows == std::vector<std::size_t>({ 2, 3, 9 }));
+    ASSERT_TRUE(load.quantities == std::vector<double>({ 10.0, -5.0, 3.0 }));
+    ASSERT_EQ(load.params[1].option_type, yo::OptionType::Put);
+    ASSERT_EQ(load.params[1].volatility, 0.30);
+    ASSERT_EQ(load.params[2].exercise_time, 2.0);
+    ASSERT_EQ(load.errors.size(), std::size_t{ 4 });
+    ASSERT_EQ(load.errors[0].row, std::size_t{ 4 });
+    ASSERT_EQ(load.errors[0].message, std::string("Invalid number 'abc' in column volatility."));
+    ASSERT_EQ(load.errors[1].row, std::size_t{ 6 });
+    ASSERT_EQ(load.errors[1].message, std::string("Asset price must be non-negative."));
+    ASSERT_EQ(load.errors[2].row, std::size_t{ 7 });
+    ASSERT_EQ(load.errors[3].row, std::size_t{ 8 });
+    ASSERT_EQ(load.errors[3].message, std::string("Expected 9 fields, found 7."));
+
+    // a missing column is an error of the whole file
+    bool thrown = false;
+    try { yu::parse_params_csv("asset_price,strike_price\n1,2\n"); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    // large book: same rows for any number of threads, from the file or the binary book
+    std::string big = "option_type,asset_price,strike_price,r,cost_of_carry,volatility,exercise_time\n";
+    for (int i = 0; i < 20000; ++i)
+    {
+        big += (i % 2 ? "put," : "call,") + std::to_string(80 + i % 40) + ".5," + std::to_string(100 + i % 7)
+             + (i % 997 == 0 ? ",0.05,0.05,-0.2,1\n" : ",0.05,0.05,0.2,1\n");
+    }
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    {
+        std::ofstream out(dir + "/yvan_book.csv", std::ios::binary);
+        out << big;
+    }
+    yu::ParamsLoad one = yu::parse_params_csv(big, {}, 1);
+    ASSERT_EQ(one.params.size() + one.errors.size(), std::size_t{ 20000 });
+    ASSERT_EQ(one.errors.size(), std::size_t{ 21 });
+    ASSERT_TRUE(one.quantities == std::vector<double>(one.params.size(), 1.0));
+    for (std::size_t n_threads : { 3, 8 })
+    {
+        yu::ParamsLoad many = yu::load_params_csv(dir + "/yvan_book.csv", {}, n_threads);
+        ASSERT_TRUE(many.rows == one.rows);
+        ASSERT_EQ(many.errors.size(), one.errors.size());
+        ASSERT_EQ(many.errors.back().row, one.errors.back().row);
+        ASSERT_TRUE(std::equal(many.params.begin(), many.params.end(), one.params.begin(), yu::same_params));
+    }
+
+    // binary round trip (invalid records are reported on load too)
+    std::vector<yo::OptionParams> raw(one.params);
+    raw[5].volatility = -1.0;
+    yu::write_params_binary(dir + "/yvan_book.bin", raw, one.quantities);
+    yu::ParamsLoad bin = yu::load_params_binary(dir + "/yvan_book.bin", 4);
+    ASSERT_EQ(bin.params.size(), raw.size() - 1);
+    ASSERT_EQ(bin.errors.size(), std::size_t{ 1 });
+    ASSERT_EQ(bin.errors[0].row, std::size_t{ 5 });
+    ASSERT_EQ(bin.rows[5], std::size_t{ 6 });
+    ASSERT_EQ(bin.params[5].asset_price, raw[6].asset_price);
+    ASSERT_EQ(bin.params.back().option_type, raw.back().option_type);
+
+    yo::Portfolio book = yu::to_portfolio(bin);
+    ASSERT_EQ(book.size(), bin.params.size());
+    ASSERT_EQ(book.params(7).strike_price, bin.params[7].strike_price);
+
+    thrown = false;
+    try { yu::load_params_binary(dir + "/yvan_book.csv"); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    std::filesystem::remove(dir + "/yvan_book.csv");
+    std::filesystem::remove(dir + "/yvan_book.bin");
+    return true;
+}
+
+// Test Case 042: batch validation bitmask, and engine batches with invalid rows
+TEST_CASE(Batch_Validation_Faults_And_Invalid_Rows)
+{
+    yo::OptionParams good{};
+    std::vector<yo::OptionParams> batch(8, good);
+    batch[1].asset_price = -1.0;
+    batch[2].volatility = -0.1;
+    batch[2].exercise_time = -1.0;
+    batch[3].option_type = static_cast<yo::OptionType>(0);
+    batch[4].r = std::numeric_limits<double>::quiet_NaN();
+    batch[5].strike_price = std::numeric_limits<double>::infinity();
+    batch[7].asset_price = 80.0;
+
+    // one byte of fault bits per row, same bits from the params or from a book
+    std::vector<std::uint8_t> faults(batch.size());
+    ASSERT_EQ(yu::validate_batch(batch, faults), std::size_t{ 5 });
+    ASSERT_TRUE(faults == std::vector<std::uint8_t>({ 0, yu::fault::negative_asset_price,
+        yu::fault::negative_volatility | yu::fault::negative_exercise_time, yu::fault::invalid_type,
+        yu::fault::not_finite, yu::fault::not_finite, 0, 0 }));
+    yo::Portfolio book;
+    for (const auto& p : batch) book.add(p, 1.0);
+    std::vector<std::uint8_t> book_faults(batch.size());
+    ASSERT_EQ(yu::validate_batch(book, book_faults), std::size_t{ 5 });
+    ASSERT_TRUE(book_faults == faults);
+
+    // the messages of Option::validate_params
+    for (std::size_t i = 1; i <= 3; ++i)
+    {
+        ASSERT_EQ(std::string(yu::fault_message(faults[i])), std::string(yo::params_error(batch[i])));
+    }
+    ASSERT_TRUE(yu::fault_message(0) == nullptr);
+    ASSERT_TRUE(yo::params_error(batch[4]) == nullptr); // validate_params accepts NaN / inf
+
+    // engines: valid rows as in a plain batch, invalid rows NaN or untouched
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+    std::vector<double> out(batch.size(), -7.0);
+    ASSERT_EQ(bs_engine.price(batch, out, yu::InvalidRows::NaN), std::size_t{ 5 });
+    for (std::size_t i : { 0, 6, 7 }) ASSERT_EQ(out[i], bs_engine.price(batch[i]));
+    for (std::size_t i = 1; i <= 5; ++i) ASSERT_TRUE(std::isnan(out[i]));
+
+    std::fill(out.begin(), out.end(), -7.0);
+    std::vector<std::uint8_t> seen(batch.size());
+    ASSERT_EQ(bs_greeks.delta(batch, out, yu::InvalidRows::Skip, seen), std::size_t{ 5 });
+    ASSERT_TRUE(seen == faults);
+    ASSERT_EQ(out[7], bs_greeks.delta(batch[7]));
+    for (std::size_t i = 1; i <= 5; ++i) ASSERT_EQ(out[i], -7.0);
+    ASSERT_EQ(bs_greeks.gamma(std::span<const yo::OptionParams>(batch).first(1),
+                              std::span<double>(out).first(1), yu::InvalidRows::NaN), std::size_t{ 0 });
+    ASSERT_EQ(out[0], bs_greeks.gamma(batch[0]));
+
+    // size mismatch is still an error of the call
+    bool thrown = false;
+    try { bs_engine.price(batch, std::span<double>(out).first(3), yu::InvalidRows::NaN); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    return true;
+}
+
+// Test Case 043: performance gate statistics, baseline file and regression rule
+TEST_CASE(PerfGate_Baselines_And_Regression_Rule)
+{
+    // robust statistics: an outlier moves neither the median nor the MAD much
+    ASSERT_EQ(yvan::bench::median({ 3.0, 1.0, 2.0, 100.0 }), 2.5);
+    ASSERT_EQ(yvan::bench::mad({ 1.0, 2.0, 3.0, 4.0, 100.0 }), 1.0);
+
+    // the baseline file round trip (comments and bad lines are ignored)
+    const std::string path = (std::filesystem::temp_directory_path() / "yt_perf_baseline_test.txt").string();
+    yt::save_perf_baselines(path, { { "A", { 10.5, 0.25 } }, { "B", { 200.0, 3.0 } } });
+    { std::ofstream(path, std::ios::app) << "C not_a_number\n"; }
+    const auto baselines = yt::load_perf_baselines(path);
+    std::filesystem::remove(path);
+    ASSERT_EQ(baselines.size(), std::size_t{ 2 });
+    ASSERT_EQ(baselines.at("A").ns_per_op, 10.5);
+    ASSERT_EQ(baselines.at("B").mad_ns, 3.0);
+    ASSERT_TRUE(yt::load_perf_baselines(path).empty());
+
+    // a regression is slower than the threshold and than the noise
+    yvan::bench::Result r;
+    r.ns_per_op = 130.0;
+    r.mad_ns = 2.0;
+    ASSERT_TRUE(yt::perf_regression(r, { 100.0, 1.0 }, 0.25));
+    ASSERT_TRUE(!yt::perf_regression(r, { 100.0, 1.0 }, 0.35));
+    ASSERT_TRUE(!yt::perf_regression(r, { 100.0, 15.0 }, 0.25));
+    r.ns_per_op = 60.0;
+    ASSERT_TRUE(!yt::perf_regression(r, { 100.0, 1.0 }, 0.25));
+
+    // a measurement of a body (ops per call are accounted for)
+    const yvan::bench::Result m = yt::measure_perf("sum", [](yvan::bench::State& state)
+    {
+        std::vector<double> v(256, 1.0);
+        state.run(v.size(), [&]{ yvan::bench::do_not_optimize(std::accumulate(v.begin(), v.end(), 0.0)); });
+    });
+    ASSERT_EQ(m.ops_per_call, std::size_t{ 256 });
+    ASSERT_TRUE(m.ns_per_op > 0.0 && m.mad_ns >= 0.0 && m.samples == yt::perf_config().timing.samples);
+
+    bool thrown = false;
+    try { yt::measure_perf("empty", [](yvan::bench::State&) {}); }
+    catch (const std::logic_error&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    // the benchmark runner reports the failed benchmarks (for the exit code of a main)
+    // in its results and in the JSON file
+    auto& benchmarks = yvan::bench::registry();
+    const std::size_t n_registered = benchmarks.size();
+    yvan::bench::register_benchmark("yt_runner_ok", [](yvan::bench::State& state)
+    {
+        state.run(1, [] { yvan::bench::do_not_optimize(1.0); });
+    });
+    yvan::bench::register_benchmark("yt_runner_throws", [](yvan::bench::State& state)
+    {
+        state.run(1, [] { yvan::bench::do_not_optimize(1.0); });
+        throw std::runtime_error("check failed");
+    });
+    yvan::bench::register_benchmark("yt_runner_no_run", [](yvan::bench::State&) {});
+    yvan::bench::Options options;
+    options.filter = "yt_runner_";
+    options.min_time = 1e-4;
+    options.samples = 3;
+    options.json = (std::filesystem::temp_directory_path() / "yt_runner.json").string();
+    const auto results = yvan::bench::run_all_benchmarks(options);
+    benchmarks.resize(n_registered);
+    ASSERT_EQ(results.size(), std::size_t{ 3 });
+    ASSERT_EQ(yvan::bench::failures(results), std::size_t{ 2 });
+    ASSERT_TRUE(results[0].failure.empty() && results[1].failure == "check failed" && !results[2].failure.empty());
+    std::ifstream json_file(options.json);
+    const std::string json((std::istreambuf_iterator<char>(json_file)), std::istreambuf_iterator<char>());
+    json_file.close();
+    std::filesystem::remove(options.json);
+    ASSERT_TRUE(json.find("\"failure\": null") != std::string::npos);
+    ASSERT_TRUE(json.find("\"failure\": \"check failed\"") != std::string::npos);
+    return true;
+}
+
+// --- Performance Cases ---
+// (timed with YT_PERF=1 and compared with perf_baseline.txt, see PERF_CASE)
+
+// perf_book(): n options around the money
+std::vector<yo::OptionParams> perf_book(std::size_t n)
+{
+    std::vector<yo::OptionParams> book(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        book[i].strike_price = 70.0 + static_cast<double>(i % 61);
+        book[i].volatility = 0.1 + 0.01 * static_cast<double>(i % 41);
+        book[i].exercise_time = 0.1 + 0.05 * static_cast<double>(i % 39);
+        book[i].option_type = i % 2 ? yo::OptionType::Put : yo::OptionType::Call;
+    }
+    return book;
+}
+
+// Test Case 044: throughput of BSEngine on single options
+PERF_CASE(Perf_BSEngine_Price_Single)
+{
+    ye::BSEngine engine;
+    const auto book = perf_book(1024);
+    std::size_t i = 0;
+    state.run(1, [&]{ yvan::bench::do_not_optimize(engine.price(book[i])); i = (i + 1) % book.size(); });
+}
+
+// Test Case 045: throughput of the BSEngine batch overload
+PERF_CASE(Perf_BSEngine_Price_Span)
+{
+    ye::BSEngine engine;
+    const auto book = perf_book(1024);
+    std::vector<double> out(book.size());
+    state.run(book.size(), [&]{ engine.price(book, out); });
+}
+
+// Test Case 046: throughput of the BSEngine batch overload with row validation
+PERF_CASE(Perf_BSEngine_Price_Checked_Span)
+{
+    ye::BSEngine engine;
+    const auto book = perf_book(1024);
+    std::vector<double> out(book.size());
+    state.run(book.size(), [&]{ engine.price(book, out, yu::InvalidRows::NaN); });
+}
+
+// Test Case 047: throughput of the BSEngineGreeks batch overloads
+PERF_CASE(Perf_BSEngineGreeks_Delta_Gamma_Span)
+{
+    ye::BSEngineGreeks greeks;
+    const auto book = perf_book(1024);
+    std::vector<double> out(book.size());
+    state.run(2 * book.size(), [&]{ greeks.delta(book, out); greeks.gamma(book, out); });
+}
+
+// Test Case 048: instrumentation counters across threads, snapshots and dumps
+TEST_CASE(Instrumentation_Counters_Snapshots_Dumps)
+{
+    namespace yi = yu::instr;
+
+    // mc_run is only recorded here (the other probes may move while other tests run)
+    const yi::Snapshot before = yi::snapshot();
+    yi::record(yi::Probe::mc_run, 5, 100);
+    {
+        yi::ScopedTimer timer(yi::Probe::mc_run, 1);
+        timer.items(10);
+    }
+    std::thread([] { yi::record(yi::Probe::mc_run, 20, 50); }).join();
+    const yi::Snapshot d = yi::snapshot() - before;
+    ASSERT_EQ(d[yi::Probe::mc_run].calls, 3u);
+    ASSERT_EQ(d[yi::Probe::mc_run].items, 35u);
+    ASSERT_TRUE(d[yi::Probe::mc_run].ns > 150u);
+    ASSERT_TRUE(yi::snapshot().threads >= 1);
+
+    // the probes of the engines, when compiled in (-DYVAN_INSTRUMENTATION=1)
+    ye::BSEngine engine;
+    std::vector<yo::OptionParams> batch(64);
+    std::vector<double> out(batch.size());
+    const yi::Snapshot start = yi::snapshot();
+    engine.price(batch, out);
+    const yi::Snapshot priced = yi::snapshot() - start;
+    if (yi::enabled) ASSERT_TRUE(priced[yi::Probe::price_batch].items >= batch.size());
+    else ASSERT_EQ(priced[yi::Probe::price_batch].items, 0u);
+
+    // dumps
+    const std::string text = yi::to_text(d);
+    ASSERT_TRUE(text.find("mc_run") != std::string::npos && text.find("price_batch") != std::string::npos);
+    const std::string json = yi::to_json(d);
+    ASSERT_TRUE(json.find("\"mc_run\": {\"calls\": 3, \"items\": 35, \"ns\": ") != std::string::npos);
+    ASSERT_TRUE(json.front() == '{' && json.back() == '}');
+    return true;
+}
+
+// --- TableEngine Error Bounds ---
+// Test Case 049: the error bounds hold off the nodes, also where the fourth derivative grows
+TEST_CASE(TableEngine_Error_Bounds_Off_Nodes)
+{
+    ye::BSEngine bs_engine;
+    ye::BSEngineGreeks bs_greeks;
+
+    // a smooth spot x vol table, and a spot x maturity table down to T = 0.01
+    // (its derivatives in T blow up towards the edge)
+    ye::TableSpec smooth;
+    smooth.base.strike_price = 100.0;
+    smooth.base.exercise_time = 0.5;
+    smooth.field_x = &yo::OptionParams::asset_price;
+    smooth.start_x = 70.0; smooth.end_x = 130.0; smooth.step_x = 1.0;
+    smooth.field_y = &yo::OptionParams::volatility;
+    smooth.start_y = 0.1; smooth.end_y = 0.4; smooth.step_y = 0.01;
+    ye::TableSpec steep = smooth;
+    steep.base.volatility = 0.2;
+    steep.field_y = &yo::OptionParams::exercise_time;
+    steep.start_y = 0.01; steep.end_y = 2.0; steep.step_y = 0.02;
+
+    for (const ye::TableSpec& spec : { smooth, steep })
+    {
+        ye::TableEngine table{bs_engine, bs_greeks, spec};
+        const ye::TableErrorBounds e = table.error_bounds();
+
+        // dense probe off the nodes (offsets of the lattice not on the node steps)
+        std::vector<yo::OptionParams> probes;
+        for (int a = 0; a < 400; ++a)
+        {
+            for (int b = 0; b < 200; ++b)
+            {
+                yo::OptionParams p = spec.base;
+                p.*spec.field_x = spec.start_x + (spec.end_x - spec.start_x) * (a + 0.37) / 400.0;
+                p.*spec.field_y = spec.start_y + (spec.end_y - spec.start_y) * (b + 0.61) / 200.0;
+                probes.push_back(p);
+            }
+        }
+        std::vector<double> price(probes.size()), delta(probes.size()), gamma(probes.size());
+        bs_engine.price(std::span<const yo::OptionParams>(probes), std::span<double>(price));
+        bs_greeks.delta(std::span<const yo::OptionParams>(probes), std::span<double>(delta));
+        bs_greeks.gamma(std::span<const yo::OptionParams>(probes), std::span<double>(gamma));
+
+        ye::TableErrorBounds max_error;
+        for (std::size_t k = 0; k < probes.size(); ++k)
+        {
+            ASSERT_TRUE(table.covers(probes[k]));
+            const ye::TableQuote q = table.quote(probes[k]);
+            max_error.price = std::max(max_error.price, std::abs(q.price - price[k]));
+            max_error.delta = std::max(max_error.delta, std::abs(q.delta - delta[k]));
+            max_error.gamma = std::max(max_error.gamma, std::abs(q.gamma - gamma[k]));
+        }
+
+        // the bounds hold, and are not loose by more than a factor 4
+        ASSERT_TRUE(max_error.price <= e.price && max_error.price >= e.price / 4.0);
+        ASSERT_TRUE(max_error.delta <= e.delta && max_error.delta >= e.delta / 4.0);
+        ASSERT_TRUE(max_error.gamma <= e.gamma && max_error.gamma >= e.gamma / 4.0);
+
+        // the tolerance gate is on the bound: a table built under a tolerance meets it
+        ye::TableSpec tight = spec;
+        tight.tolerance = 0.99 * e.price;
+        bool thrown = false;
+        try { ye::TableEngine rejected{bs_engine, bs_greeks, tight}; }
+        catch (const std::invalid_argument&) { thrown = true; }
+        ASSERT_TRUE(thrown);
+        tight.tolerance = e.price;
+        ye::TableEngine accepted{bs_engine, bs_greeks, tight};
+        ASSERT_TRUE(max_error.price <= tight.tolerance);
+    }
+    return true;
+}
+
+// Test Case 050: Dual pow is exact with a constant exponent, also on a base <= 0
+TEST_CASE(Dual_Pow_Constant_Exponent)
+{
+    using D = yu::Dual<double, 1>;
+    using DD = yu::Dual<D, 1>;
+
+    // x^3 at x = -2: value -8, derivative 12 (constant exponent as a double or as a Dual)
+    const D x = D::variable(-2.0, 0);
+    for (const D& p : { pow(x, 3.0), pow(x, D{ 3.0 }), pow(x, 3) })
+    {
+        ASSERT_NEAR(p.v, -8.0, 1e-12);
+        ASSERT_NEAR(p.d[0], 12.0, 1e-12);
+    }
+    const D zero = D::variable(0.0, 0);
+    ASSERT_NEAR(pow(zero, D{ 2.0 }).d[0], 0.0, 1e-12);
+    ASSERT_NEAR(pow(zero, 1.0).d[0], 1.0, 1e-12);
+
+    // a varying exponent keeps the log term: d/db 2^b = 2^b log(2)
+    const D b = D::variable(3.0, 0);
+    ASSERT_NEAR(pow(D{ 2.0 }, b).d[0], 8.0 * std::log(2.0), 1e-12);
+    // both varying: d/dx x^x = x^x (log(x) + 1)
+    const D y = D::variable(1.5, 0);
+    ASSERT_NEAR(pow(y, y).d[0], std::pow(1.5, 1.5) * (std::log(1.5) + 1.0), 1e-12);
+
+    // nested (second order): (x^3)'' = 6x = -12 at x = -2
+    const DD xx{ D::variable(-2.0, 0), { D{ 1.0 } } };
+    const DD p2 = pow(xx, 3.0);
+    ASSERT_NEAR(p2.d[0].v, 12.0, 1e-12);
+    ASSERT_NEAR(p2.d[0].d[0], -12.0, 1e-12);
+    ASSERT_NEAR(pow(xx, DD{ D{ 3.0 } }).d[0].d[0], -12.0, 1e-12);
+    return true;
+}
+
+// Test Case 051: AReal pow records finite partials at a = 0 and with a constant exponent
+TEST_CASE(AReal_Pow_Constant_Exponent)
+{
+    using yu::AReal;
+    yu::Tape tape;
+    yu::Tape::Activation activation{ tape };
+
+    // d/dx of f(x, y) at the recorded inputs (one backward sweep from f)
+    auto gradient = [&](const AReal& f, const AReal& x, const AReal& y)
+    {
+        tape.reset_adjoints();
+        tape.node(f.index()).adjoint = 1.0;
+        tape.propagate(f.index(), 0);
+        return std::pair{ x.adjoint(), y.adjoint() };
+    };
+
+    // x^3 at x = -2: value -8, derivative 12 (constant exponent as a double, an AReal or an int)
+    const AReal x = AReal::input(-2.0);
+    for (const AReal& p : { pow(x, 3.0), pow(x, AReal{ 3.0 }), pow(x, 3) })
+    {
+        ASSERT_NEAR(p.value(), -8.0, 1e-12);
+        ASSERT_NEAR(gradient(p, x, AReal{}).first, 12.0, 1e-12);
+        ASSERT_EQ(tape.node(p.index()).n_args, 1u); // no log(a) edge
+    }
+
+    // at a = 0 the base partial is b 0^(b-1), not NaN (compared exactly: ASSERT_NEAR lets a NaN through)
+    const AReal zero = AReal::input(0.0);
+    ASSERT_TRUE(gradient(pow(zero, AReal{ 2.0 }), zero, AReal{}).first == 0.0);
+    ASSERT_TRUE(gradient(pow(zero, 1.0), zero, AReal{}).first == 1.0);
+
+    // an active exponent keeps the log term: d/dx x^y = y x^(y-1), d/dy x^y = x^y log(x)
+    const AReal base = AReal::input(1.5);
+    const AReal e = AReal::input(2.5);
+    const auto [d_base, d_e] = gradient(pow(base, e), base, e);
+    ASSERT_NEAR(d_base, 2.5 * std::pow(1.5, 1.5), 1e-12);
+    ASSERT_NEAR(d_e, std::pow(1.5, 2.5) * std::log(1.5), 1e-12);
+    ASSERT_TRUE(std::isfinite(gradient(pow(zero, e), zero, e).first));
+    return true;
+}
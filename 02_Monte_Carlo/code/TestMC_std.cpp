@@ -6,12 +6,22 @@
 // Sweeps Batches 1 & 2 over grids of N (timesteps) and NSim (paths),
 // and prints CSV rows with MC price, SD, SE, exact price, abs/rel error,
 // and how many times the simulated path hit the origin.
+// The Greeks are estimated from the same simulated paths (no bump and rerun):
+//   - pathwise: delta and vega (derivative of the payoff along the path)
+//   - likelihood ratio: gamma and the delta of a digital (cash-or-nothing)
+//     payoff, whose pathwise derivative is zero almost everywhere
+// each one with its standard error.
+//
+// Built with -DYVAN_INSTRUMENTATION=1, every run_mc() call is timed by the
+// instrumentation layer of 01_Exact_Pricing_Methods (mc_run probe, items =
+// paths) and the totals are printed to stderr at the end (the CSV stays on stdout).
 //
 // (C) Datasim Education BC 2008-2011  |  Adapted by Yvan Richard (2025)
 
 #include "OptionData.hpp"
 #include "../UtilitiesDJD/Geometry/Range.hpp"
 #include "../UtilitiesDJD/RNG/NormalGenerator.hpp"
+#include "../../01_Exact_Pricing_Methods/include/util/instrumentation.hpp"
 
 #include <cmath>
 #include <iostream>
@@ -93,10 +103,48 @@ namespace SDEDefinition
         double betaCEV = 1.0;
         return 0.5 * (data->sig) * (betaCEV) * std::pow(X, 2.0 * betaCEV - 1.0);
     }
+
+    // Derivatives used by the pathwise Greeks (tangent processes)
+    double driftDerivativeX(double /*t*/, double /*X*/)
+    {   // d(drift)/dX = r
+        return data->r;
+    }
+
+    double diffusionDerivativeX(double /*t*/, double X)
+    {   // d(diffusion)/dX = sigma * beta * X^(beta - 1)
+        double betaCEV = 1.0;
+        return data->sig * betaCEV * std::pow(X, betaCEV - 1.0);
+    }
+
+    double diffusionDerivativeSig(double /*t*/, double X)
+    {   // d(diffusion)/dsigma = X^beta
+        double betaCEV = 1.0;
+        return std::pow(X, betaCEV);
+    }
 } // End of namespace
 
 // --- MC runner ---
 
+// Running mean / variance of an estimator (Welford's update, one pass,
+// no need to store the samples)
+struct RunningStats
+{
+    long   n{};
+    double mean{};
+    double m2{};   // sum of squared deviations from the mean
+
+    void add(double x)
+    {
+        ++n;
+        double delta = x - mean;
+        mean += delta / static_cast<double>(n);
+        m2 += delta * (x - mean);
+    }
+
+    double sd() const { return n > 1 ? std::sqrt(m2 / static_cast<double>(n - 1)) : 0.0; }
+    double se() const { return n > 0 ? sd() / std::sqrt(static_cast<double>(n)) : 0.0; }
+};
+
 // Here we define a struct to hold MC statistics
 // They will be returned from the MC runner function
 struct MCStats
@@ -105,12 +153,19 @@ struct MCStats
     double sd{};        // sample std of discounted payoffs
     double se{};        // sd / sqrt(NSim)
     long   hit_origin{}; // count of VNew <= 0 across all steps and paths
+
+    // Greeks from the same paths (estimate + standard error)
+    double delta{},         delta_se{};          // pathwise
+    double vega{},          vega_se{};           // pathwise
+    double gamma{},         gamma_se{};          // likelihood ratio
+    double digital_delta{}, digital_delta_se{};  // likelihood ratio, cash-or-nothing paying 1
 };
 
 // Run one MC experiment for given N (timesteps) and NSim (paths)
 MCStats run_mc(const OptionData& opt, double S0, long N, long NSim)
 {
     using namespace SDEDefinition;
+    YVAN_PROBE_TIME(mc_run, NSim);
 
     Range<double> range(0.0, opt.T);
     std::vector<double> x = range.mesh(N);
@@ -127,21 +182,51 @@ MCStats run_mc(const OptionData& opt, double S0, long N, long NSim)
 
     long hit_count = 0;
 
+    // Greeks accumulators
+    const double df = std::exp(-opt.r * opt.T);
+    const double sqrtT = std::sqrt(opt.T);
+    RunningStats delta_acc, vega_acc, gamma_acc, digital_delta_acc;
+
     for (long i = 0; i < NSim; ++i)
     {
         double VOld = S0;
         double VNew = S0;
+        double dVdS0 = 1.0;  // tangent dV/dS0 along the Euler path
+        double dVdSig = 0.0; // tangent dV/dsigma along the Euler path
+        double sumW = 0.0;   // sum of the increments (W_T / sqrk)
         for (unsigned long idx = 1; idx < x.size(); ++idx)
         {
             double dW = myNormal->getNormal();
-            VNew = VOld + (k * drift(x[idx - 1], VOld))
-                        + (sqrk * diffusion(x[idx - 1], VOld) * dW);
+            double t = x[idx - 1];
+
+            // differentiate the Euler step w.r.t. S0 and sigma (uses VOld before the update)
+            double dstep = 1.0 + k * driftDerivativeX(t, VOld) + sqrk * diffusionDerivativeX(t, VOld) * dW;
+            dVdSig = dVdSig * dstep + sqrk * diffusionDerivativeSig(t, VOld) * dW;
+            dVdS0 *= dstep;
+            sumW += dW;
+
+            VNew = VOld + (k * drift(t, VOld))
+                        + (sqrk * diffusion(t, VOld) * dW);
             VOld = VNew;
             if (VNew <= 0.0) ++hit_count;
         }
         double payoff = opt.myPayOffFunction(VNew);
         double disc_payoff = std::exp(-opt.r * opt.T) * payoff;
         discounted_payoffs.push_back(disc_payoff);
+
+        // pathwise: d(payoff)/dS_T = type * 1{in the money} (call +1, put -1)
+        bool in_the_money = opt.type * (VNew - opt.K) > 0.0;
+        double payoff_slope = in_the_money ? static_cast<double>(opt.type) : 0.0;
+        delta_acc.add(df * payoff_slope * dVdS0);
+        vega_acc.add(df * payoff_slope * dVdSig);
+
+        // likelihood ratio: score of the lognormal density of S_T with Z = W_T / sqrt(T)
+        double Z = sumW * sqrk / sqrtT;
+        double sig_sqrtT = opt.sig * sqrtT;
+        double score_S0 = Z / (S0 * sig_sqrtT);
+        double score2_S0 = ((Z * Z - 1.0) / (sig_sqrtT * sig_sqrtT) - Z / sig_sqrtT) / (S0 * S0);
+        gamma_acc.add(disc_payoff * score2_S0);
+        digital_delta_acc.add(df * (in_the_money ? 1.0 : 0.0) * score_S0);
     }
 
     delete myNormal;
@@ -153,7 +238,12 @@ MCStats run_mc(const OptionData& opt, double S0, long N, long NSim)
     double sd = sample_std(discounted_payoffs, opt.r, opt.T);
     double se = sd / std::sqrt(static_cast<double>(discounted_payoffs.size()));
 
-    return {mean, sd, se, hit_count};
+    MCStats st{mean, sd, se, hit_count};
+    st.delta = delta_acc.mean;                 st.delta_se = delta_acc.se();
+    st.vega = vega_acc.mean;                   st.vega_se = vega_acc.se();
+    st.gamma = gamma_acc.mean;                 st.gamma_se = gamma_acc.se();
+    st.digital_delta = digital_delta_acc.mean; st.digital_delta_se = digital_delta_acc.se();
+    return st;
 }
 
 // --- Main: systematic study ---
@@ -174,7 +264,8 @@ int main()
 
     // CSV header (useful for the visualization I will be doing later)
     std::cout << std::fixed << std::setprecision(6);
-    std::cout << "batch,N,NSim,price,sd,se,exact,abs_err,rel_err,hit_origin" << std::endl;
+    std::cout << "batch,N,NSim,price,sd,se,exact,abs_err,rel_err,hit_origin,"
+              << "delta,delta_se,vega,vega_se,gamma,gamma_se,digital_delta,digital_delta_se" << std::endl;
 
     for (const auto& b : batches)
     {
@@ -208,12 +299,21 @@ int main()
                           << exact << ","
                           << abs_err << ","
                           << rel_err << ","
-                          << st.hit_origin
+                          << st.hit_origin << ","
+                          << st.delta << ","
+                          << st.delta_se << ","
+                          << st.vega << ","
+                          << st.vega_se << ","
+                          << st.gamma << ","
+                          << st.gamma_se << ","
+                          << st.digital_delta << ","
+                          << st.digital_delta_se
                           << std::endl;
             }
         }
     }
 
+    if (yvan::util::instr::enabled) std::cerr << yvan::util::instr::to_text(yvan::util::instr::snapshot());
     return 0;
 }
 
@@ -5,6 +5,42 @@ In this file, we generate price surface data for different option parameters.
 This data can be used for visualization purposes.
 This code uses C++20 features.
 
+Run without arguments, the program asks for one base configuration and writes
+its price and delta surfaces to ../data. Run with a job file, it generates every
+surface listed in the file on a pool of threads, without any prompt:
+
+    ./main jobs.csv [--out <dir>] [--threads <n>]
+
+The job file is a CSV file with a header line, one job per line ('#' starts a
+comment line, an empty cell takes the default value):
+
+    column           default
+    name             (required) prefix of the output files
+    option_type      call (call or put)
+    strike_price     (required)
+    exercise_time    (required)
+    r                (required)
+    cost_of_carry    (required)
+    asset_price      (required)
+    volatility       (required)
+    x_field          asset_price (any of the six numeric parameters above)
+    x_start, x_end   0.5x and 1.5x the base value of x_field (required when
+                     that value is not positive)
+    x_steps          50 (number of intervals of the axis)
+    y_field          exercise_time
+    y_start, y_end   0.5x and 1.5x the base value of y_field (same)
+    y_steps          50
+    outputs          price|delta (any of price, delta, gamma, separated by '|')
+    format           both (csv, bin or both)
+    precision        4 (digits after the decimal point in the CSV files)
+
+Every configuration of the surface (both ends of each axis) must pass the
+checks of Option::validate_params. Each output of a job goes to its own file:
+<dir>/<name>_<output>_surface.csv (and/or .bin), written as <file>.tmp and
+renamed when complete, so a failed surface leaves no file behind. A job that
+fails is reported and the others go on; the exit code is 1 if any line of the
+file could not be read or any job failed.
+
 Author: Yvan Richard
 Date: Fall 2025
 */
@@ -12,10 +48,20 @@ Date: Fall 2025
 // standard library includes
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <vector>
+#include <span>
 #include <string>
-#include <iomanip>
+#include <string_view>
+#include <charconv>
+#include <chrono>
 #include <cmath>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <system_error>
 
 // yvan library includes
 // --- options ---
@@ -33,6 +79,9 @@ Date: Fall 2025
 #include "util/grid2d.hpp"
 #include "util/param_grid.hpp"
 #include "util/distributions.hpp"
+#include "util/parallel.hpp"
+#include "util/surface_io.hpp"
+#include "util/surface_stream.hpp"
 
 
 
@@ -41,105 +90,445 @@ namespace yo = yvan::option;
 namespace yu = yvan::util;
 namespace ye = yvan::engine;
 
-// generate_price_surface()
-void generate_price_surface(const yo::OptionParams& p)
+// --- Surfaces ---
+using Field = double yo::OptionParams::*;
+
+// parameters that can be used as an axis (names as in the CSV headers)
+struct FieldName
+{
+    const char* name;
+    Field field;
+};
+constexpr FieldName field_names[] = {
+    { "asset_price", &yo::OptionParams::asset_price },
+    { "strike_price", &yo::OptionParams::strike_price },
+    { "r", &yo::OptionParams::r },
+    { "cost_of_carry", &yo::OptionParams::cost_of_carry },
+    { "volatility", &yo::OptionParams::volatility },
+    { "exercise_time", &yo::OptionParams::exercise_time },
+};
+
+// surfaces a job can ask for
+enum class Output { Price, Delta, Gamma };
+constexpr const char* output_names[] = { "price", "delta", "gamma" };
+
+const char* field_name(Field field)
 {
-    // create parameter grids for asset price and time to maturity
-    double start_S = p.asset_price * 0.5;
-    double end_S = p.asset_price * 1.5;
-    double step_S = (end_S - start_S) / 50.0;
+    for (const FieldName& f : field_names)
+    {
+        if (f.field == field) return f.name;
+    }
+    return "?";
+}
 
-    double start_T = p.exercise_time * 0.5;
-    double end_T = p.exercise_time * 1.5;
-    double step_T = (end_T - start_T) / 50.0;
+// One surface job: a base configuration, two axes and the surfaces to write
+struct SurfaceJob
+{
+    std::string name;                   // prefix of the output files (empty: no prefix)
+    yo::OptionParams base{};
+    Field field_x = &yo::OptionParams::asset_price;
+    double start_x{}, end_x{};
+    std::size_t steps_x = 50;
+    Field field_y = &yo::OptionParams::exercise_time;
+    double start_y{}, end_y{};
+    std::size_t steps_y = 50;
+    std::vector<Output> outputs{ Output::Price, Output::Delta };
+    bool csv = true;
+    bool binary = true;
+    int precision = 4;
+};
+
+// default_axes(): base value of each field +/- 50% (a range only for positive base values)
+void default_axes(SurfaceJob& job)
+{
+    job.start_x = job.base.*job.field_x * 0.5;
+    job.end_x = job.base.*job.field_x * 1.5;
+    job.start_y = job.base.*job.field_y * 0.5;
+    job.end_y = job.base.*job.field_y * 1.5;
+}
 
-    // grid of parameters
-    yu::Grid2D<yo::OptionParams> grid = yu::sweep_2d(p,
-        &yo::OptionParams::asset_price, start_S, end_S, step_S,
-        &yo::OptionParams::exercise_time, start_T, end_T, step_T);
+// generate_surface(): one output of a job, written to <out_dir>/[<name>_]<output>_surface.csv/.bin
+void generate_surface(const SurfaceJob& job, Output output, const std::string& out_dir)
+{
+    const char* value_name = output_names[static_cast<int>(output)];
+    const std::string stem = out_dir + "/" + (job.name.empty() ? "" : job.name + "_") + value_name + "_surface";
+    const double step_x = (job.end_x - job.start_x) / static_cast<double>(job.steps_x);
+    const double step_y = (job.end_y - job.start_y) / static_cast<double>(job.steps_y);
 
-    // create BS pricer
+    // create BS engines
     ye::BSEngine bs_pricer;
+    ye::BSEngineGreeks bs_greeks;
+    yu::RowEvaluator evaluate;
+    switch (output)
+    {
+    case Output::Price: evaluate = [&](auto batch, auto out) { bs_pricer.price(batch, out); }; break;
+    case Output::Delta: evaluate = [&](auto batch, auto out) { bs_greeks.delta(batch, out); }; break;
+    case Output::Gamma: evaluate = [&](auto batch, auto out) { bs_greeks.gamma(batch, out); }; break;
+    }
 
-    // price over the grid
-    yu::Grid2D<double> price_grid = bs_pricer.price(grid);
-
-    // output to CSV
-    std::ofstream file("../data/price_surface.csv"); // file is now a stream to write to
-
-    // write header
-    file << "asset_price,exercise_time,price\n";
-    for (std::size_t i = 0; i < grid.nrows; ++i)
+    // output files: CSV, and binary for the Python side (memory-mapped, no parsing)
+    // written under a temporary name, renamed once complete
+    std::optional<yu::CsvSurfaceSink> csv;
+    std::optional<yu::BinarySurfaceSink> bin;
+    std::vector<yu::SurfaceSink*> sinks;
+    std::vector<std::string> files;
+    try
     {
-        for (std::size_t j = 0; j < grid.ncols; ++j)
+        if (job.csv)
         {
-            file << std::fixed << std::setprecision(4)
-                 << grid(i,j).asset_price << ","
-                 << grid(i,j).exercise_time << ","
-                 << price_grid(i,j) << "\n";
+            files.push_back(stem + ".csv");
+            csv.emplace(files.back() + ".tmp",
+                        yu::SurfaceCsv{ field_name(job.field_x), field_name(job.field_y), value_name, job.precision });
+            sinks.push_back(&*csv);
         }
+        if (job.binary)
+        {
+            files.push_back(stem + ".bin");
+            bin.emplace(files.back() + ".tmp", yu::SurfaceNames{ field_name(job.field_x), field_name(job.field_y), value_name });
+            sinks.push_back(&*bin);
+        }
+
+        // evaluate the surface batch by batch, the rows are written while the next batch is computed
+        yu::stream_surface(job.base,
+            job.field_x, job.start_x, job.end_x, step_x,
+            job.field_y, job.start_y, job.end_y, step_y,
+            evaluate, sinks);
+        csv.reset();
+        bin.reset();
+        for (const std::string& file : files) std::filesystem::rename(file + ".tmp", file);
+    }
+    catch (...)
+    {
+        // no partial surface is left behind
+        csv.reset();
+        bin.reset();
+        std::error_code ignored;
+        for (const std::string& file : files) std::filesystem::remove(file + ".tmp", ignored);
+        throw;
+    }
+}
+
+// --- Job File ---
+// trim(): text without surrounding blanks (and the '\r' of Windows line ends)
+std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+// split(): trimmed cells of a line
+std::vector<std::string_view> split(std::string_view line, char separator)
+{
+    std::vector<std::string_view> cells;
+    std::size_t begin = 0;
+    while (true)
+    {
+        const std::size_t end = std::min(line.find(separator, begin), line.size());
+        cells.push_back(trim(line.substr(begin, end - begin)));
+        if (end == line.size()) return cells;
+        begin = end + 1;
     }
+}
 
-    file.close(); // close the file stream
+double parse_number(std::string_view cell, const std::string& column)
+{
+    double value{};
+    const auto [ptr, ec] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+    if (ec != std::errc{} || ptr != cell.data() + cell.size() || !std::isfinite(value))
+    {
+        throw std::invalid_argument("invalid number '" + std::string(cell) + "' in column " + column + ".");
+    }
+    return value;
+}
 
-    return;
+std::size_t parse_count(std::string_view cell, const std::string& column)
+{
+    std::size_t value{};
+    const auto [ptr, ec] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+    if (ec != std::errc{} || ptr != cell.data() + cell.size() || value == 0)
+    {
+        throw std::invalid_argument("invalid count '" + std::string(cell) + "' in column " + column + ".");
+    }
+    return value;
 }
 
-// generate_delta_surface()
-void generate_delta_surface(const yo::OptionParams& p)
+Field parse_field(std::string_view cell, const std::string& column)
 {
-    // create parameter grids for asset price and volatility
-    double start_S = p.asset_price * 0.5;
-    double end_S = p.asset_price * 1.5;
-    double step_S = (end_S - start_S) / 50.0;
+    for (const FieldName& f : field_names)
+    {
+        if (cell == f.name) return f.field;
+    }
+    throw std::invalid_argument("unknown parameter '" + std::string(cell) + "' in column " + column + ".");
+}
 
-    double start_T = p.exercise_time * 0.5;
-    double end_T = p.exercise_time * 1.5;
-    double step_T = (end_T - start_T) / 50.0;
+// Columns of the job file, from its header line
+class JobColumns
+{
+private:
+    std::vector<std::string> names_;
 
-    // grid of parameters
-    yu::Grid2D<yo::OptionParams> grid = yu::sweep_2d(p,
-        &yo::OptionParams::asset_price, start_S, end_S, step_S,
-        &yo::OptionParams::exercise_time, start_T, end_T, step_T);
+public:
+    // throws std::invalid_argument on an unknown, repeated or missing column
+    explicit JobColumns(std::string_view header)
+    {
+        static const std::set<std::string> known = {
+            "name", "option_type", "strike_price", "exercise_time", "r", "cost_of_carry", "asset_price",
+            "volatility", "x_field", "x_start", "x_end", "x_steps", "y_field", "y_start", "y_end", "y_steps",
+            "outputs", "format", "precision" };
+        for (std::string_view cell : split(header, ','))
+        {
+            std::string name(cell);
+            if (known.count(name) == 0) throw std::invalid_argument("unknown column '" + name + "'.");
+            if (index(name) >= 0) throw std::invalid_argument("repeated column '" + name + "'.");
+            names_.push_back(name);
+        }
+        for (const char* name : { "name", "strike_price", "exercise_time", "r", "cost_of_carry", "asset_price", "volatility" })
+        {
+            if (index(name) < 0) throw std::invalid_argument("missing column '" + std::string(name) + "'.");
+        }
+    }
 
-    // create BS Greeks engine
-    ye::BSEngineGreeks bs_greeks;
+    // index(): position of a column, -1 if absent
+    int index(const std::string& name) const
+    {
+        for (std::size_t k = 0; k < names_.size(); ++k)
+        {
+            if (names_[k] == name) return static_cast<int>(k);
+        }
+        return -1;
+    }
 
-    // delta over the grid
-    yu::Grid2D<double> delta_grid = bs_greeks.delta(grid);
+    std::size_t size() const { return names_.size(); }
+};
+
+// parse_job(): one line of the job file
+// throws std::invalid_argument if the line is not a valid job
+SurfaceJob parse_job(std::string_view line, const JobColumns& columns)
+{
+    const std::vector<std::string_view> cells = split(line, ',');
+    if (cells.size() != columns.size())
+    {
+        throw std::invalid_argument("expected " + std::to_string(columns.size()) + " cells, found "
+                                    + std::to_string(cells.size()) + ".");
+    }
+    // cell(): empty if the column is absent
+    auto cell = [&](const std::string& name) -> std::string_view
+    {
+        const int k = columns.index(name);
+        return k < 0 ? std::string_view{} : cells[k];
+    };
+
+    SurfaceJob job;
+    job.name = std::string(cell("name"));
+    if (job.name.empty()) throw std::invalid_argument("empty job name.");
+    for (char c : job.name)
+    {
+        const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                             || c == '_' || c == '-' || c == '.';
+        if (!allowed) throw std::invalid_argument("job name '" + job.name + "' is not a valid file name.");
+    }
 
-    // output to CSV
-    std::ofstream file("../data/delta_surface.csv"); // file is now a stream to write to
+    // --- base configuration ---
+    const std::string_view type = cell("option_type");
+    if (type == "put") job.base.option_type = yo::OptionType::Put;
+    else if (type.empty() || type == "call") job.base.option_type = yo::OptionType::Call;
+    else throw std::invalid_argument("unknown option type '" + std::string(type) + "'.");
+    for (const FieldName& f : field_names)
+    {
+        job.base.*f.field = parse_number(cell(f.name), f.name);
+    }
+    yo::EuropeanOption check(job.base); // throws on invalid parameters
+
+    // --- axes ---
+    if (!cell("x_field").empty()) job.field_x = parse_field(cell("x_field"), "x_field");
+    if (!cell("y_field").empty()) job.field_y = parse_field(cell("y_field"), "y_field");
+    if (job.field_x == job.field_y) throw std::invalid_argument("x_field and y_field must be different.");
+    default_axes(job);
+    for (const char* axis : { "x", "y" })
+    {
+        const std::string a(axis);
+        const Field field = a == "x" ? job.field_x : job.field_y;
+        if ((cell(a + "_start").empty() || cell(a + "_end").empty()) && !(job.base.*field > 0.0))
+        {
+            throw std::invalid_argument(a + "_field " + field_name(field) + " has the base value "
+                                        + std::to_string(job.base.*field) + ": the default range (0.5x to 1.5x "
+                                        "the base value) needs a positive value, give " + a + "_start and " + a + "_end.");
+        }
+    }
+    if (!cell("x_start").empty()) job.start_x = parse_number(cell("x_start"), "x_start");
+    if (!cell("x_end").empty()) job.end_x = parse_number(cell("x_end"), "x_end");
+    if (!cell("y_start").empty()) job.start_y = parse_number(cell("y_start"), "y_start");
+    if (!cell("y_end").empty()) job.end_y = parse_number(cell("y_end"), "y_end");
+    if (!cell("x_steps").empty()) job.steps_x = parse_count(cell("x_steps"), "x_steps");
+    if (!cell("y_steps").empty()) job.steps_y = parse_count(cell("y_steps"), "y_steps");
+    if (!(job.start_x < job.end_x)) throw std::invalid_argument("x_start must be less than x_end.");
+    if (!(job.start_y < job.end_y)) throw std::invalid_argument("y_start must be less than y_end.");
+
+    // every configuration of the surface is valid if its corners are (the checks are bounds on single fields)
+    for (double x : { job.start_x, job.end_x })
+    {
+        for (double y : { job.start_y, job.end_y })
+        {
+            yo::OptionParams corner = job.base;
+            corner.*job.field_x = x;
+            corner.*job.field_y = y;
+            if (const char* error = yo::params_error(corner))
+            {
+                throw std::invalid_argument(std::string("at ") + field_name(job.field_x) + " = " + std::to_string(x)
+                                            + ", " + field_name(job.field_y) + " = " + std::to_string(y) + ": " + error);
+            }
+        }
+    }
 
-    // write header
-    file << "asset_price,exercise_time,delta\n";
-    for (std::size_t i = 0; i < grid.nrows; ++i)
+    // --- outputs ---
+    if (!cell("outputs").empty())
+    {
+        job.outputs.clear();
+        for (std::string_view name : split(cell("outputs"), '|'))
+        {
+            bool found = false;
+            for (int k = 0; k < 3; ++k)
+            {
+                if (name != output_names[k]) continue;
+                found = true;
+                const Output output = static_cast<Output>(k);
+                if (std::find(job.outputs.begin(), job.outputs.end(), output) == job.outputs.end())
+                {
+                    job.outputs.push_back(output);
+                }
+            }
+            if (!found) throw std::invalid_argument("unknown output '" + std::string(name) + "'.");
+        }
+    }
+    const std::string_view format = cell("format");
+    if (format == "csv") job.binary = false;
+    else if (format == "bin") job.csv = false;
+    else if (!format.empty() && format != "both") throw std::invalid_argument("unknown format '" + std::string(format) + "'.");
+    if (!cell("precision").empty())
     {
-        for (std::size_t j = 0; j < grid.ncols; ++j)
+        const double precision = parse_number(cell("precision"), "precision");
+        if (precision != std::floor(precision) || precision < 0.0 || precision > yu::max_csv_precision)
         {
-            file << std::fixed << std::setprecision(4)
-                 << grid(i,j).asset_price << ","
-                 << grid(i,j).exercise_time << ","
-                 << delta_grid(i,j) << "\n";
+            throw std::invalid_argument("invalid precision '" + std::string(cell("precision")) + "'.");
         }
+        job.precision = static_cast<int>(precision);
+    }
+    return job;
+}
+
+// run_job_file(): every job of the file on n_threads threads; returns the exit code
+int run_job_file(const std::string& path, const std::string& out_dir, std::size_t n_threads)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Cannot open the job file " << path << std::endl;
+        return 1;
     }
 
-    file.close(); // close the file stream
+    // read the jobs (a bad line is reported and skipped)
+    std::vector<SurfaceJob> jobs;
+    std::vector<std::size_t> job_lines;
+    std::optional<JobColumns> columns;
+    std::set<std::string> names;
+    std::size_t bad_lines = 0;
+    std::string line;
+    for (std::size_t line_no = 1; std::getline(file, line); ++line_no)
+    {
+        const std::string_view content = trim(line);
+        if (content.empty() || content.front() == '#') continue;
+        try
+        {
+            if (!columns)
+            {
+                columns.emplace(content);
+                continue;
+            }
+            SurfaceJob job = parse_job(content, *columns);
+            if (!names.insert(job.name).second) throw std::invalid_argument("repeated job name '" + job.name + "'.");
+            jobs.push_back(std::move(job));
+            job_lines.push_back(line_no);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            std::cerr << path << ":" << line_no << ": " << e.what() << std::endl;
+            if (!columns) return 1; // no usable header
+            ++bad_lines;
+        }
+    }
 
-    return;
+    // run them: each worker takes the next job when it is done with the previous one
+    std::mutex report;
+    std::size_t failed = 0;
+    const auto start = std::chrono::steady_clock::now();
+    yu::parallel_for_dynamic(jobs.size(), n_threads, [&](std::size_t k)
+    {
+        const SurfaceJob& job = jobs[k];
+        for (Output output : job.outputs)
+        {
+            try
+            {
+                generate_surface(job, output, out_dir);
+            }
+            catch (const std::exception& e)
+            {
+                std::lock_guard<std::mutex> lock(report);
+                std::cerr << path << ":" << job_lines[k] << ": job " << job.name << ", "
+                          << output_names[static_cast<int>(output)] << ": " << e.what() << std::endl;
+                ++failed;
+            }
+        }
+    });
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t surfaces = 0;
+    for (const SurfaceJob& job : jobs) surfaces += job.outputs.size();
+    std::cout << jobs.size() << " jobs, " << surfaces - failed << " surfaces written to " << out_dir
+              << " in " << seconds << " s (" << n_threads << " threads)";
+    if (bad_lines > 0 || failed > 0)
+    {
+        std::cout << ", " << bad_lines << " bad lines, " << failed << " failed surfaces";
+    }
+    std::cout << std::endl;
+    return (bad_lines > 0 || failed > 0) ? 1 : 0;
 }
 
 
 
 
-// run our two functions
-int main()
+// run the interactive generator, or the job file given on the command line
+int main(int argc, char* argv[])
 {
+    // batch mode: main <job_file> [--out <dir>] [--threads <n>]
+    if (argc > 1)
+    {
+        std::string job_file, out_dir = "../data";
+        std::size_t n_threads = yu::default_thread_count();
+        for (int k = 1; k < argc; ++k)
+        {
+            const std::string arg = argv[k];
+            if (arg == "--out" && k + 1 < argc) out_dir = argv[++k];
+            else if (arg == "--threads" && k + 1 < argc)
+            {
+                try { n_threads = parse_count(argv[++k], "--threads"); }
+                catch (const std::invalid_argument& e) { std::cerr << e.what() << std::endl; return 1; }
+            }
+            else if (job_file.empty() && arg.rfind("--", 0) != 0) job_file = arg;
+            else
+            {
+                std::cerr << "Usage: " << argv[0] << " [<job_file> [--out <dir>] [--threads <n>]]" << std::endl;
+                return 1;
+            }
+        }
+        return run_job_file(job_file, out_dir, n_threads);
+    }
+
     // print welcome message
     std::cout << "Option Price and Delta Surface Generator" << std::endl;
     std::cout << "-----------------------------------------" << std::endl;
     std::cout << "(The spot price and the time to maturity will vary)" << std::endl;
-    
+
     // build OptionParam
     yo::OptionParams p1{};
     p1.option_type = yo::OptionType::Call;
@@ -162,11 +551,16 @@ int main()
     cout << "Enter the volatility: ";
     cin >> sigma; p1.volatility = sigma;
 
+    // spot price and time to maturity around the entered values
+    SurfaceJob job;
+    job.base = p1;
+    default_axes(job);
+
     // generate price surface
-    generate_price_surface(p1);
+    generate_surface(job, Output::Price, "../data");
 
     // generate delta surface
-    generate_delta_surface(p1);
+    generate_surface(job, Output::Delta, "../data");
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 # plots_generation.py
 
+import os
 import matplotlib.pyplot as plt
 import seaborn as sns
 import numpy as np
@@ -21,10 +22,17 @@ def plot_surface(df, title, xlabel, ylabel, zlabel):
     # pivot the dataframe to create a grid for surface plotting
     pivot_table = df.pivot(index=df.columns[1], columns=df.columns[0], values=df.columns[2])
 
-    X = pivot_table.columns.values
-    Y = pivot_table.index.values
-    X, Y = np.meshgrid(X, Y)
-    Z = pivot_table.values
+    plot_surface_grid(pivot_table.columns.values, pivot_table.index.values, pivot_table.values,
+                      title, xlabel, ylabel, zlabel)
+
+def plot_surface_grid(x, y, Z, title, xlabel, ylabel, zlabel):
+
+    """
+    This function generates a 3D surface plot from the axes and the grid of values:
+    Z[j, i] is the value at (x[i], y[j]).
+    """
+
+    X, Y = np.meshgrid(x, y)
 
     # plot the surface
     fig = plt.figure()
@@ -44,15 +52,52 @@ def plot_surface(df, title, xlabel, ylabel, zlabel):
 def load_data(file_path):
     return pd.read_csv(file_path)
 
-def main():
+# header of the binary surfaces written by yvan::util::write_surface_binary (see surface_io.hpp)
+SURFACE_HEADER = np.dtype([
+    ('magic', 'S8'), ('version', '<u4'), ('header_size', '<u4'),
+    ('nrows', '<u8'), ('ncols', '<u8'),
+    ('x_offset', '<u8'), ('y_offset', '<u8'), ('data_offset', '<u8'),
+    ('x_name', 'S24'), ('y_name', 'S24'), ('value_name', 'S24'),
+])
+
+def load_surface_binary(file_path):
+
+    """
+    This function maps a binary surface file without parsing it.
+    It returns the names (x, y, value), the two axes and the values
+    as read-only numpy.memmap arrays: values[i, j] is the value at (x[i], y[j]).
+    """
+
+    header = np.fromfile(file_path, dtype=SURFACE_HEADER, count=1)[0]
+    if header['magic'] != b'YSURF' or header['version'] != 1:
+        raise ValueError(f"{file_path} is not a binary surface file")
+
+    nrows, ncols = int(header['nrows']), int(header['ncols'])
+    x = np.memmap(file_path, dtype='<f8', mode='r', offset=int(header['x_offset']), shape=(nrows,))
+    y = np.memmap(file_path, dtype='<f8', mode='r', offset=int(header['y_offset']), shape=(ncols,))
+    values = np.memmap(file_path, dtype='<f8', mode='r', offset=int(header['data_offset']), shape=(nrows, ncols))
+    names = tuple(header[k].decode() for k in ('x_name', 'y_name', 'value_name'))
+    return names, x, y, values
 
-    # load the two datasets
-    df1 = load_data('../data/price_surface.csv')
-    df2 = load_data('../data/delta_surface.csv')
+def plot_data_set(name, title, xlabel, ylabel, zlabel):
+
+    """
+    This function plots ../data/<name>.bin when it exists (memory-mapped),
+    and falls back to parsing ../data/<name>.csv otherwise.
+    """
+
+    binary_path = f'../data/{name}.bin'
+    if os.path.exists(binary_path):
+        _, x, y, values = load_surface_binary(binary_path)
+        plot_surface_grid(x, y, values.T, title, xlabel, ylabel, zlabel)
+    else:
+        plot_surface(load_data(f'../data/{name}.csv'), title, xlabel, ylabel, zlabel)
+
+def main():
 
     # plot the surfaces
-    plot_surface(df1, 'Option Price Surface', 'Asset Price', 'Time to Maturity', 'Call Option Price')
-    plot_surface(df2, 'Delta Surface', 'Asset Price', 'Time to Maturity', 'Call Option Delta')
+    plot_data_set('price_surface', 'Option Price Surface', 'Asset Price', 'Time to Maturity', 'Call Option Price')
+    plot_data_set('delta_surface', 'Delta Surface', 'Asset Price', 'Time to Maturity', 'Call Option Delta')
 
 if __name__ == "__main__":
     main()